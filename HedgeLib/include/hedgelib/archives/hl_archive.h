@@ -537,5 +537,27 @@ struct packed_file_entry
 };
 
 using packed_file_info = std::vector<packed_file_entry>;
+
+struct duplicate_file_entry
+{
+    /** @brief The name of the file whose data is identical to that of an earlier file. */
+    std::string name;
+    /** @brief The name of the earlier file whose data this file's data is identical to. */
+    std::string originalName;
+    /** @brief The size of the duplicated data, in bytes. */
+    std::size_t dataSize;
+    /**
+        @brief Whether this file shares the earlier file's copy of the data within the
+        packed archive, or whether the format required the data to be stored twice.
+    */
+    bool isShared;
+
+    inline duplicate_file_entry(std::string name, std::string originalName,
+        std::size_t dataSize, bool isShared) :
+        name(std::move(name)), originalName(std::move(originalName)),
+        dataSize(dataSize), isShared(isShared) {}
+};
+
+using duplicate_file_info = std::vector<duplicate_file_entry>;
 } // hl
 #endif
@@ -182,15 +182,17 @@ inline archive load(const nstring& filePath)
 HL_API void save(const archive_entry_list& arc,
     const nchar* filePath, u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment, compress_type compressType = compress_type::none,
-    bool generateARL = true, packed_file_info* pfi = nullptr);
+    bool generateARL = true, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr);
 
 inline void save(const archive_entry_list& arc,
     const nstring& filePath, u32 splitLimit = default_split_limit,
     u32 dataAlignment = default_alignment, compress_type compressType = compress_type::none,
-    bool generateARL = true, packed_file_info* pfi = nullptr)
+    bool generateARL = true, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr)
 {
     save(arc, filePath.c_str(), splitLimit, dataAlignment,
-        compressType, generateARL, pfi);
+        compressType, generateARL, pfi, dupInfo);
 }
 } // ar
 
@@ -328,17 +330,17 @@ inline archive load(const nstring& filePath)
 
 inline void save(const archive_entry_list& arc,
     const nchar* filePath, u32 dataAlignment = default_alignment,
-    packed_file_info* pfi = nullptr)
+    packed_file_info* pfi = nullptr, duplicate_file_info* dupInfo = nullptr)
 {
     ar::save(arc, filePath, 0, dataAlignment,
-        compress_type::none, false, pfi);
+        compress_type::none, false, pfi, dupInfo);
 }
 
 inline void save(const archive_entry_list& arc,
     const nstring& filePath, u32 dataAlignment = default_alignment,
-    packed_file_info* pfi = nullptr)
+    packed_file_info* pfi = nullptr, duplicate_file_info* dupInfo = nullptr)
 {
-    save(arc, filePath.c_str(), dataAlignment, pfi);
+    save(arc, filePath.c_str(), dataAlignment, pfi, dupInfo);
 }
 } // pfd
 } // hh
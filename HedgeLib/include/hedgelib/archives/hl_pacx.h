@@ -597,15 +597,17 @@ inline archive load(const nstring& filePath)
 HL_API void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr);
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr);
 
 inline void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr)
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr)
 {
     save(arc, endianFlag, exts, extCount,
-        filePath, splitLimit, dataAlignment, pfi);
+        filePath.c_str(), splitLimit, dataAlignment, pfi, dupInfo);
 }
 } // v2
 
@@ -1031,6 +1033,120 @@ inline void parse(const void* pac, archive_entry_list& hlArc,
     headerPtr->parse(hlArc, skipProxies);
 }
 
+/**
+ * @brief A read-only view of an *unfixed* data_entry.
+ */
+class data_entry_view
+{
+    data_view m_entry;
+
+public:
+    inline u32 uid() const noexcept
+    {
+        return m_entry.read<u32>(offsetof(data_entry, uid));
+    }
+
+    inline u32 data_size() const noexcept
+    {
+        return m_entry.read<u32>(offsetof(data_entry, dataSize));
+    }
+
+    inline const void* data() const noexcept
+    {
+        return m_entry.deref64(offsetof(data_entry, data)).get();
+    }
+
+    inline const char* ext() const noexcept
+    {
+        return m_entry.str64(offsetof(data_entry, ext));
+    }
+
+    inline u64 flags() const noexcept
+    {
+        return m_entry.read<u64>(offsetof(data_entry, flags));
+    }
+
+    inline bool is_proxy_entry() const noexcept
+    {
+        return ((flags() & static_cast<u64>(data_flags::not_here)) != 0);
+    }
+
+    inline bool is_bina_file() const noexcept
+    {
+        return ((flags() & static_cast<u64>(data_flags::bina_file)) != 0);
+    }
+
+    inline explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(m_entry);
+    }
+
+    inline data_entry_view() noexcept = default;
+
+    inline data_entry_view(const data_view& entry) noexcept :
+        m_entry(entry) {}
+};
+
+/**
+ * @brief A read-only view of an *unfixed* PACxV3 file, which resolves offsets
+ * and swaps endianness on read rather than fixing the data in-place. Since the
+ * data is never modified, any number of views can safely read the same pac at
+ * once, including pacs within const buffers or read-only memory maps.
+ */
+class header_view
+{
+    data_view m_header;
+
+public:
+    inline u32 uid() const noexcept
+    {
+        return m_header.read<u32>(offsetof(header, uid));
+    }
+
+    inline u32 file_size() const noexcept
+    {
+        return m_header.read<u32>(offsetof(header, fileSize));
+    }
+
+    inline u16 type() const noexcept
+    {
+        return m_header.read<u16>(offsetof(header, type));
+    }
+
+    inline u16 flags() const noexcept
+    {
+        return m_header.read<u16>(offsetof(header, flags));
+    }
+
+    inline u32 dep_count() const noexcept
+    {
+        return m_header.read<u32>(offsetof(header, depCount));
+    }
+
+    /**
+     * @brief Finds the data entry for the file with the given type
+     * (e.g. "ResTexture") and name (without extension).
+     *
+     * @return A view of the file's data entry, or a null view if there was no such file.
+     */
+    HL_API data_entry_view find_file(const char* typeName, const char* fileName) const;
+
+    inline data_entry_view find_file(const std::string& typeName,
+        const std::string& fileName) const
+    {
+        return find_file(typeName.c_str(), fileName.c_str());
+    }
+
+    /**
+     * @brief Same as hl::pacx::v3::header::parse, but without needing to fix the pac first.
+     */
+    HL_API void parse(archive_entry_list& hlArc, bool skipProxies = true) const;
+
+    inline explicit header_view(const void* pac) noexcept :
+        m_header(pac, bina::needs_swap(static_cast<
+            const header*>(pac)->endian_flag())) {}
+};
+
 HL_API void read(blob& pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs = nullptr);
 
@@ -1088,15 +1204,17 @@ HL_API u32 generate_uid();
 HL_API void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr);
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr);
 
 inline void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nstring& filePath, u32 splitLimit = default_split_limit,
-    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr)
+    u32 dataAlignment = default_alignment, packed_file_info* pfi = nullptr,
+    duplicate_file_info* dupInfo = nullptr)
 {
     save(arc, endianFlag, exts, extCount,
-        filePath, splitLimit, dataAlignment, pfi);
+        filePath.c_str(), splitLimit, dataAlignment, pfi, dupInfo);
 }
 } // v3
 
@@ -1362,7 +1480,7 @@ inline void save(archive_entry_list& arc, u32 maxChunkSize,
     u32 dataAlignment = default_alignment, bool noCompress = false)
 {
     save(arc, maxChunkSize, compressType, endianFlag,
-        extCount, exts, filePath, splitLimit, dataAlignment,
+        extCount, exts, filePath.c_str(), splitLimit, dataAlignment,
         noCompress);
 }
 } // v02
@@ -1630,7 +1748,7 @@ HL_API void decompress_no_alloc_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
     const void* src, u32 dstSize, void* dst);
 
-HL_API std::unique_ptr<u8[]> decompress_lz4(u32 chunkCount,
+HL_API unique_buffer decompress_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
     const void* src, u32 dstSize);
 
@@ -1641,7 +1759,7 @@ HL_API blob decompress_lz4_blob(u32 chunkCount,
 HL_API void decompress_no_alloc_deflate(u32 srcSize,
     const void* src, u32 dstSize, void* dst);
 
-HL_API std::unique_ptr<u8[]> decompress_deflate(u32 srcSize,
+HL_API unique_buffer decompress_deflate(u32 srcSize,
     const void* src, u32 dstSize);
 
 HL_API blob decompress_deflate_blob(u32 srcSize,
@@ -1651,7 +1769,7 @@ HL_API std::size_t compress_no_alloc_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src, std::size_t dstBufSize,
     void* dst, std::vector<chunk>& chunks);
 
-HL_API std::unique_ptr<u8[]> compress_lz4(u32 maxChunkSize,
+HL_API unique_buffer compress_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src, std::size_t& dstSize,
     std::vector<chunk>& chunks);
 
@@ -1662,7 +1780,7 @@ HL_API blob compress_blob_lz4(u32 maxChunkSize,
 HL_API std::size_t compress_no_alloc_deflate(std::size_t srcSize,
     const void* src, std::size_t dstBufSize, void* dst);
 
-HL_API std::unique_ptr<u8[]> compress_deflate(std::size_t srcSize,
+HL_API unique_buffer compress_deflate(std::size_t srcSize,
     const void* src, std::size_t& dstSize);
 
 HL_API blob compress_blob_deflate(std::size_t srcSize, const void* src);
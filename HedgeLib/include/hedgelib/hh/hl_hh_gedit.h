@@ -450,6 +450,122 @@ struct raw_world
 
 HL_STATIC_ASSERT_SIZE(raw_world, 0x30);
 
+/**
+ * @brief A read-only view of an *unfixed* raw_object.
+ */
+class raw_object_view
+{
+    data_view m_obj;
+
+public:
+    inline const char* type() const noexcept
+    {
+        return m_obj.str64(offsetof(raw_object, type));
+    }
+
+    inline const char* name() const noexcept
+    {
+        return m_obj.str64(offsetof(raw_object, name));
+    }
+
+    inline raw_object_id id() const noexcept
+    {
+        return m_obj.read<raw_object_id>(offsetof(raw_object, id));
+    }
+
+    inline raw_object_id parent_id() const noexcept
+    {
+        return m_obj.read<raw_object_id>(offsetof(raw_object, parentID));
+    }
+
+    inline raw_transform transform_base() const noexcept
+    {
+        return m_obj.read<raw_transform>(offsetof(raw_object, transformBase));
+    }
+
+    inline raw_transform transform_offset() const noexcept
+    {
+        return m_obj.read<raw_transform>(offsetof(raw_object, transformOffset));
+    }
+
+    inline u64 tag_count() const noexcept
+    {
+        return m_obj.read<u64>(offsetof(raw_object, tags) +
+            offsetof(csl::move_array64<off64<raw_tag>>, count));
+    }
+
+    /**
+     * @brief Returns a view of the object's parameter data, which is
+     * also unfixed; use the object's type to know how to read it.
+     */
+    inline data_view params() const noexcept
+    {
+        return m_obj.deref64(offsetof(raw_object, paramData));
+    }
+
+    inline explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(m_obj);
+    }
+
+    inline raw_object_view() noexcept = default;
+
+    inline raw_object_view(const data_view& obj) noexcept :
+        m_obj(obj) {}
+};
+
+/**
+ * @brief A read-only view of an *unfixed* raw_world, which can be used in
+ * place of fixing the world when the data must not be modified, e.g.:
+ *
+ * raw_world_view world(bina::v2::get_data_view(rawData));
+ */
+class raw_world_view
+{
+    data_view m_world;
+
+    inline data_view objects() const noexcept
+    {
+        return m_world.deref64(offsetof(raw_world, objects) +
+            offsetof(csl::move_array64<off64<raw_object>>, dataPtr));
+    }
+
+public:
+    inline u64 object_count() const noexcept
+    {
+        return m_world.read<u64>(offsetof(raw_world, objects) +
+            offsetof(csl::move_array64<off64<raw_object>>, count));
+    }
+
+    inline raw_object_view object(std::size_t index) const noexcept
+    {
+        return objects().deref64(sizeof(off64<raw_object>) * index);
+    }
+
+    /**
+     * @brief Returns a view of the object with the given ID,
+     * or a null view if there was no such object.
+     */
+    inline raw_object_view get_object(const raw_object_id& id) const noexcept
+    {
+        const data_view objs = objects();
+        const u64 objCount = object_count();
+
+        for (u64 i = 0; i < objCount; ++i)
+        {
+            const raw_object_view obj = objs.deref64(
+                sizeof(off64<raw_object>) * static_cast<std::size_t>(i));
+
+            if (obj.id() == id) return obj;
+        }
+
+        return raw_object_view();
+    }
+
+    inline raw_world_view(const data_view& world) noexcept :
+        m_world(world) {}
+};
+
 HL_API void write(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::v2::writer64& writer,
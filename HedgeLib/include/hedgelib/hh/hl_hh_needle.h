@@ -1,4 +1,6 @@
 #include "../hl_text.h"
+#include "../hl_blob.h"
+#include <vector>
 
 namespace hl
 {
@@ -191,6 +193,55 @@ struct raw_archive
 };
 
 HL_STATIC_ASSERT_SIZE(raw_archive, 12);
+
+enum class archive_entry_type
+{
+    lodinfo,
+    model
+};
+
+struct archive_entry
+{
+    archive_entry_type type;
+    const void* data;
+    std::size_t dataSize;
+
+    inline archive_entry(archive_entry_type type,
+        const void* data, std::size_t dataSize) noexcept :
+        type(type), data(data), dataSize(dataSize) {}
+};
+
+/**
+    @brief Converts the given NEDMDLV5 model, as stored within a Needle archive,
+    into a regular mirage model, in-place.
+*/
+HL_API void unfix_model(void* rawModel, std::size_t rawModelSize);
+
+/**
+    @brief Converts the given regular mirage model into a NEDMDLV5 model,
+    as stored within a Needle archive, in-place.
+*/
+HL_API void fix_model(void* rawModel, std::size_t rawModelSize);
+
+/**
+    @brief Unpacks the given Needle archive (as loaded from a file), in-place.
+
+    Afterwards, the archive can be iterated over normally, and the data of each
+    of its entries is a regular standalone file (e.g. NEDMDLV5 models are converted
+    into regular mirage models). The archive's models are converted in parallel.
+*/
+HL_API void unpack(raw_archive& rawArc);
+
+/**
+    @brief Packs the given entries into a new Needle archive, in-memory.
+    The given entries' data is left unmodified. Models are converted in parallel.
+*/
+HL_API blob pack(const archive_entry* entries, std::size_t entryCount);
+
+inline blob pack(const std::vector<archive_entry>& entries)
+{
+    return pack(entries.data(), entries.size());
+}
 } // needle
 } // hh
 } // hl
@@ -4,6 +4,11 @@
 #include "../hl_blob.h"
 #include "../hl_text.h"
 #include "../io/hl_stream.h"
+#include <robin_hood.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace hl
 {
@@ -21,6 +26,10 @@ constexpr u32 version_package = 1u;
 constexpr u32 version_info = 1u;
 
 constexpr u32 dds_header_format_off = 0x54;
+constexpr u32 dds_header_caps2_off = 0x70;
+constexpr u32 dds_header_dx10_dimension_off = 0x84;
+constexpr u32 dds_header_dx10_misc_flag_off = 0x88;
+constexpr u32 dds_header_dx10_array_size_off = 0x8C;
 constexpr u32 dds_header_default_size = 0x80;
 constexpr u32 dds_header_dx10_size = 0x94;
 constexpr u32 dds_header_max_size = dds_header_dx10_size;
@@ -139,8 +148,111 @@ public:
 
     bool try_load(hl::stream* stream);
 
+    /**
+        @brief Finds the entry with the given name.
+        @return The entry with the given name, or null if the package has no such entry.
+    */
     const raw_package_entry* get_entry(const char* str) const;
+
+    /**
+        @brief Loads the blob at the given index from the package's stream.
+
+        Uses stream::read_at, so this can be called concurrently from multiple
+        threads if the package's stream supports it (e.g. file_stream).
+    */
     hl::blob load_blob(u32 index) const;
+
+    /**
+        @brief Computes the total size of the given range of blobs.
+        Throws if the given range goes past the end of the package's blobs.
+    */
+    std::size_t get_blobs_size(u32 index, u32 count) const;
+
+    /**
+        @brief Loads the given range of blobs from the package's stream straight into
+        the given buffer, one after the other.
+
+        Blobs which are stored contiguously within the package are read together,
+        and if there are enough of the resulting reads, they are spread across
+        multiple threads when the package's stream supports concurrent reads
+        (see stream::supports_concurrent_reads; e.g. file_stream).
+
+        @param[in] index    The index of the first blob to load.
+        @param[in] count    How many blobs to load.
+        @param[out] dst     A buffer which is at least get_blobs_size(index, count) bytes large.
+    */
+    void load_blobs(u32 index, u32 count, void* dst) const;
+};
+
+/**
+    @brief Maps texture names to the entries of a package in O(1), and answers
+    queries for the blobs of a range of mips. Meant to be built once per package,
+    and used for many lookups.
+
+    Entries whose names have the same hash are chained together, and lookups
+    verify the entry's name, so hash collisions never return the wrong texture.
+*/
+class package_index
+{
+    const raw_package* m_package = nullptr;
+    robin_hood::unordered_flat_map<u32, u32> m_chainHeads;
+    std::vector<u32> m_chainNext;
+
+public:
+    package_index() = default;
+
+    inline package_index(const raw_package& package)
+    {
+        build(package);
+    }
+
+    inline const raw_package* package() const noexcept
+    {
+        return m_package;
+    }
+
+    /**
+        @brief (Re)builds this index from the entries of the given (fixed) package.
+        The package must outlive this index.
+    */
+    void build(const raw_package& package);
+
+    /**
+        @brief Finds the entry with the given name.
+        @return The entry with the given name, or null if the package has no such entry.
+    */
+    const raw_package_entry* find(const char* name) const;
+
+    /**
+        @brief Gets the number of mips of the given texture which are stored within the
+        package. Any mips after these are stored in the texture's info (see raw_info::mip_4x4).
+    */
+    inline u32 get_mip_count(const raw_package_entry& entry) const noexcept
+    {
+        return entry.blobCount;
+    }
+
+    /**
+        @brief Gets the blobs (i.e. the exact byte ranges within the package) of the given
+        range of mips of the given texture.
+
+        @param[in] entry        The texture's entry.
+        @param[in] firstMip     The index of the first mip to get; 0 is the largest mip.
+        @param[in,out] mipCount How many mips to get. Clamped to the number of mips which
+                                are actually stored within the package after firstMip.
+
+        @return A pointer to mipCount blobs (one per mip), which can be loaded via
+        readonly_package_wrapper::load_blobs(entry.blobIndex + firstMip, mipCount, ...).
+    */
+    const raw_package_blob* get_mip_blobs(const raw_package_entry& entry,
+        u32 firstMip, u32& mipCount) const;
+
+    /**
+        @brief Computes the total size of the given range of mips of the given texture.
+        mipCount is clamped the same way as in get_mip_blobs.
+    */
+    std::size_t get_mips_size(const raw_package_entry& entry,
+        u32 firstMip, u32 mipCount) const;
 };
 
 struct raw_info
@@ -251,6 +363,159 @@ public:
     bool try_load(hl::stream& stream);
 };
 
+/**
+    @brief Caches texture streaming packages, infos, and blobs across many loads.
+
+    Package headers, their indices, and infos stay resident (along with the
+    package file streams, which are shared by every load from the same package)
+    until the cache is destroyed. Blobs are cached under a configurable byte
+    budget, evicting the least-recently-used blobs once the budget is exceeded.
+
+    All functions are thread-safe. Blobs are read outside of the cache's lock
+    (via stream::read_at), so multiple threads can load blobs at once.
+*/
+class streaming_cache
+{
+public:
+    using blob_ptr = std::shared_ptr<const hl::blob>;
+
+    struct stats
+    {
+        u64 packageHits = 0;
+        u64 packageMisses = 0;
+        u64 infoHits = 0;
+        u64 infoMisses = 0;
+        u64 blobHits = 0;
+        u64 blobMisses = 0;
+        u64 blobEvictions = 0;
+        /** @brief The total size of all blobs currently within the cache, in bytes. */
+        std::size_t blobBytes = 0;
+    };
+
+private:
+    struct package_data;
+    struct cached_blob
+    {
+        u64 key;
+        blob_ptr blob;
+    };
+
+    mutable std::mutex m_mutex;
+    robin_hood::unordered_map<nstring, std::unique_ptr<package_data>> m_packages;
+    robin_hood::unordered_map<nstring, std::unique_ptr<readonly_info_wrapper>> m_infos;
+    /** @brief Cached blobs, from most-recently-used to least-recently-used. */
+    std::list<cached_blob> m_blobs;
+    robin_hood::unordered_map<u64, std::list<cached_blob>::iterator> m_blobsByKey;
+    std::size_t m_blobBudget;
+    stats m_stats;
+
+    package_data& in_get_package(const nchar* filePath);
+
+    void in_evict_blobs();
+
+public:
+    /**
+        @brief Constructs an empty cache.
+        @param[in] blobBudget   How many bytes worth of blobs the cache may hold at once.
+    */
+    streaming_cache(std::size_t blobBudget);
+
+    ~streaming_cache();
+
+    inline std::size_t blob_budget() const noexcept
+    {
+        return m_blobBudget;
+    }
+
+    void set_blob_budget(std::size_t blobBudget);
+
+    /**
+        @brief Gets the package at the given file path, opening and loading its header
+        if it isn't already within the cache. Throws if the package is not valid.
+        The returned package is valid until the cache is destroyed.
+    */
+    const readonly_package_wrapper& get_package(const nchar* filePath);
+
+    inline const readonly_package_wrapper& get_package(const nstring& filePath)
+    {
+        return get_package(filePath.c_str());
+    }
+
+    /** @brief Gets the index of the package at the given file path. See get_package. */
+    const package_index& get_package_index(const nchar* filePath);
+
+    inline const package_index& get_package_index(const nstring& filePath)
+    {
+        return get_package_index(filePath.c_str());
+    }
+
+    /**
+        @brief Gets the info at the given file path, loading it if it isn't already
+        within the cache. Throws if the info is not valid. The returned info is valid
+        until the cache is destroyed.
+    */
+    const raw_info& get_info(const nchar* filePath);
+
+    inline const raw_info& get_info(const nstring& filePath)
+    {
+        return get_info(filePath.c_str());
+    }
+
+    /**
+        @brief Gets the blob at the given index within the package at the given file path,
+        loading it if it isn't already within the cache. The returned blob stays valid
+        even if it gets evicted from the cache.
+    */
+    blob_ptr get_blob(const nchar* packageFilePath, u32 index);
+
+    inline blob_ptr get_blob(const nstring& packageFilePath, u32 index)
+    {
+        return get_blob(packageFilePath.c_str(), index);
+    }
+
+    stats get_stats() const;
+
+    /** @brief Resets every counter except blobBytes. */
+    void reset_stats();
+
+    /** @brief Removes every blob from the cache. Packages and infos stay resident. */
+    void clear_blobs();
+};
+
+/**
+    @brief Computes the size of the DDS file which load_dds would build
+    for the given texture.
+
+    Throws if the entry's blob range is invalid, or if the texture isn't a single
+    2D texture (cube maps, texture arrays, and 3D textures aren't supported).
+*/
+std::size_t get_dds_size(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry);
+
+/**
+    @brief Rebuilds the full DDS file for the given streamed texture into the given buffer.
+
+    The DDS is laid out as the DDS header from the given info, followed by every
+    one of the entry's blobs (the larger mips) in order, followed by the info's
+    4x4 mip data (the smaller mips). The blobs are read via load_blobs.
+
+    Only single 2D textures can be rebuilt this way, as the mips of each face/slice
+    of cube maps, texture arrays, and 3D textures would need to be interleaved.
+
+    @param[in] info     The info (.ntsi) of the texture to rebuild.
+    @param[in] package  The package which contains the texture's blobs.
+    @param[in] entry    The texture's entry within the given package.
+    @param[out] dst     A buffer which is at least get_dds_size(info, package, entry) bytes large.
+*/
+void load_dds(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry, void* dst);
+
+hl::blob load_dds(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry);
+
 } // texture_streaming
 } // needle
 } // hh
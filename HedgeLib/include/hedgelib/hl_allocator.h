@@ -0,0 +1,241 @@
+#ifndef HL_ALLOCATOR_H_INCLUDED
+#define HL_ALLOCATOR_H_INCLUDED
+#include "hl_internal.h"
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace hl
+{
+/**
+ * @brief The HedgeLib subsystems memory allocations are attributed to.
+ */
+enum class memory_subsystem : u8
+{
+    /** @brief Allocations which don't belong to any other subsystem. */
+    general = 0,
+    /** @brief hl::blob data. */
+    blob,
+    /** @brief Data loaded by hl::file::load. */
+    file,
+    /** @brief Compressed and decompressed data. */
+    compression,
+    /** @brief hl::mem_stream buffers. */
+    stream,
+    /** @brief hl::archive_entry data. */
+    archive,
+    /** @brief hl::radix_tree nodes, leaves, and arena blocks. */
+    radix_tree,
+
+    count
+};
+
+/**
+ * @brief Returns a human-readable name for the given subsystem (e.g. "radix_tree").
+ */
+HL_API const char* get_subsystem_name(memory_subsystem subsystem) noexcept;
+
+/**
+ * @brief An interface used to provide the memory HedgeLib allocates for
+ * its buffers (blobs, loaded files, compression, memory streams, archive
+ * entries, and radix trees).
+ */
+class allocator
+{
+public:
+    /**
+     * @brief Allocates a block of memory.
+     *
+     * @param size The size of the block, in bytes.
+     * @param alignment The alignment of the block; always a power of two.
+     * @param subsystem The subsystem this block is being allocated for.
+     * @return A pointer to the block. Must never be null; throw std::bad_alloc instead.
+     */
+    virtual void* allocate(std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) = 0;
+
+    /**
+     * @brief Frees a block of memory previously allocated with allocate.
+     * The given size, alignment, and subsystem are the same ones which
+     * were given to allocate.
+     */
+    virtual void deallocate(void* ptr, std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) noexcept = 0;
+
+    virtual ~allocator() = default;
+};
+
+/**
+ * @brief An allocator which just uses ::operator new and ::operator delete.
+ */
+class default_allocator : public allocator
+{
+public:
+    HL_API void* allocate(std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) override;
+
+    HL_API void deallocate(void* ptr, std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) noexcept override;
+
+    HL_API static default_allocator& instance() noexcept;
+};
+
+/**
+ * @brief An allocator which forwards allocations to another allocator, but
+ * throws std::bad_alloc rather than let the total amount of memory allocated
+ * through it exceed a given budget.
+ */
+class budget_allocator : public allocator
+{
+    allocator* m_upstream;
+    std::size_t m_budget;
+    std::atomic<std::size_t> m_used;
+
+public:
+    HL_API void* allocate(std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) override;
+
+    HL_API void deallocate(void* ptr, std::size_t size, std::size_t alignment,
+        memory_subsystem subsystem) noexcept override;
+
+    inline std::size_t budget() const noexcept
+    {
+        return m_budget;
+    }
+
+    inline std::size_t used() const noexcept
+    {
+        return m_used.load(std::memory_order_relaxed);
+    }
+
+    inline budget_allocator(std::size_t budget,
+        allocator& upstream = default_allocator::instance()) noexcept :
+        m_upstream(&upstream),
+        m_budget(budget),
+        m_used(0) {}
+};
+
+/**
+ * @brief Returns the allocator HedgeLib uses by default on every thread.
+ */
+HL_API allocator& get_global_allocator() noexcept;
+
+/**
+ * @brief Sets the allocator HedgeLib uses by default on every thread.
+ *
+ * NOTE: Memory is always freed with the allocator it was allocated with,
+ * so this can be safely changed at any time, as long as the given allocator
+ * outlives every allocation made with it.
+ *
+ * @param alloc The allocator to use, or null to use the default_allocator.
+ */
+HL_API void set_global_allocator(allocator* alloc) noexcept;
+
+/**
+ * @brief Returns the allocator HedgeLib currently uses on the calling thread:
+ * the innermost scoped_allocator's allocator if there is one, or the global
+ * allocator otherwise.
+ */
+HL_API allocator& get_allocator() noexcept;
+
+/**
+ * @brief Makes HedgeLib use the given allocator on the calling thread
+ * for as long as this object exists.
+ */
+class scoped_allocator
+{
+    allocator* m_prevAlloc;
+
+public:
+    HL_API explicit scoped_allocator(allocator& alloc) noexcept;
+
+    scoped_allocator(const scoped_allocator& other) = delete;
+    scoped_allocator& operator=(const scoped_allocator& other) = delete;
+
+    HL_API ~scoped_allocator();
+};
+
+struct memory_stats
+{
+    /** @brief How many bytes are currently allocated. */
+    std::size_t liveBytes;
+    /** @brief How many allocations are currently alive. */
+    std::size_t liveCount;
+    /** @brief The highest liveBytes has been since the last reset. */
+    std::size_t peakBytes;
+    /** @brief How many bytes have been allocated in total since the last reset. */
+    std::size_t totalBytes;
+    /** @brief How many allocations have been made in total since the last reset. */
+    std::size_t totalCount;
+};
+
+/**
+ * @brief Returns the allocation statistics for the given subsystem.
+ */
+HL_API memory_stats get_memory_stats(memory_subsystem subsystem) noexcept;
+
+/**
+ * @brief Returns the allocation statistics for all subsystems combined.
+ * NOTE: peakBytes is the sum of each subsystem's peak.
+ */
+HL_API memory_stats get_memory_stats() noexcept;
+
+/**
+ * @brief Resets the peak and total statistics for every subsystem.
+ * Live statistics are left as-is, since those allocations are still alive.
+ */
+HL_API void reset_memory_stats() noexcept;
+
+/**
+ * @brief Allocates a block of memory with the current allocator and records it
+ * in the given subsystem's statistics. Free it with hl::deallocate.
+ *
+ * NOTE: The allocator used is recorded in a small header before the
+ * returned block, so blocks can be freed from any thread or scope.
+ */
+[[nodiscard]] HL_API void* allocate(std::size_t size, std::size_t alignment,
+    memory_subsystem subsystem);
+
+[[nodiscard]] inline void* allocate(std::size_t size, memory_subsystem subsystem)
+{
+    return allocate(size, alignof(std::max_align_t), subsystem);
+}
+
+/**
+ * @brief Frees a block of memory allocated by hl::allocate(size, alignment, subsystem).
+ * Does nothing if ptr is null.
+ */
+HL_API void deallocate(void* ptr) noexcept;
+
+/**
+ * @brief Allocates a block of memory with the given allocator and records it in
+ * the given subsystem's statistics, without storing any header. The caller must
+ * free it with deallocate_sized, passing the same allocator, size, alignment,
+ * and subsystem.
+ */
+[[nodiscard]] HL_API void* allocate_sized(allocator& alloc, std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem);
+
+HL_API void deallocate_sized(allocator& alloc, void* ptr, std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem) noexcept;
+
+struct buffer_deleter
+{
+    inline void operator()(void* ptr) const noexcept
+    {
+        deallocate(ptr);
+    }
+};
+
+/**
+ * @brief A unique pointer to a byte buffer allocated by hl::allocate.
+ */
+using unique_buffer = std::unique_ptr<u8[], buffer_deleter>;
+
+[[nodiscard]] inline unique_buffer make_unique_buffer(std::size_t size,
+    memory_subsystem subsystem = memory_subsystem::general)
+{
+    return unique_buffer(static_cast<u8*>(allocate(size, subsystem)));
+}
+} // hl
+#endif
@@ -1,6 +1,7 @@
 #ifndef HL_BLOB_H_INCLUDED
 #define HL_BLOB_H_INCLUDED
 #include "hl_text.h"
+#include "hl_allocator.h"
 
 namespace hl
 {
@@ -10,7 +11,7 @@ class blob
 
 protected:
     /** @brief Pointer to the data this blob contains. */
-    std::unique_ptr<u8[]> m_data;
+    unique_buffer m_data;
     /** @brief Size of the data this blob contains, in bytes. */
     std::size_t m_size;
 
@@ -35,6 +36,10 @@ public:
         return m_size;
     }
 
+    /**
+     * @brief Releases ownership of this blob's data.
+     * @return The data, which must be freed with hl::deallocate.
+     */
     [[nodiscard]] inline u8* release() noexcept
     {
         return m_data.release();
@@ -29,7 +29,7 @@ HL_API void deflate_decompress_no_alloc(std::size_t srcSize,
 HL_API void decompress_no_alloc(compress_type type, std::size_t srcSize,
     const void* src, std::size_t dstSize, void* dst);
 
-HL_API std::unique_ptr<u8[]> decompress(compress_type type,
+HL_API unique_buffer decompress(compress_type type,
     std::size_t srcSize, const void* src, std::size_t dstSize);
 
 HL_API blob decompress_blob(compress_type type, std::size_t srcSize,
@@ -52,7 +52,7 @@ HL_API std::size_t compress_no_alloc(compress_type type,
     std::size_t srcSize, const void* src,
     std::size_t dstBufSize, void* dst);
 
-HL_API std::unique_ptr<u8[]> compress(compress_type type,
+HL_API unique_buffer compress(compress_type type,
     std::size_t srcSize, const void* src, std::size_t& dstSize);
 
 HL_API blob compress_blob(compress_type type,
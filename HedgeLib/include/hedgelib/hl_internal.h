@@ -431,6 +431,62 @@ inline std::enable_if_t<!std::is_enum_v<T>>
     v.template endian_swap<swapOffsets>();
 }
 
+/* Bulk endian swaps */
+/**
+ * @brief Endian-swaps count consecutive values in-place. Uses SIMD
+ * instructions (e.g. SSSE3/AVX2) when the CPU supports them.
+ */
+HL_API void endian_swap_array(u16* values, std::size_t count) noexcept;
+
+HL_API void endian_swap_array(u32* values, std::size_t count) noexcept;
+
+HL_API void endian_swap_array(u64* values, std::size_t count) noexcept;
+
+inline void endian_swap_array(s16* values, std::size_t count) noexcept
+{
+    endian_swap_array(reinterpret_cast<u16*>(values), count);
+}
+
+inline void endian_swap_array(s32* values, std::size_t count) noexcept
+{
+    endian_swap_array(reinterpret_cast<u32*>(values), count);
+}
+
+inline void endian_swap_array(s64* values, std::size_t count) noexcept
+{
+    endian_swap_array(reinterpret_cast<u64*>(values), count);
+}
+
+inline void endian_swap_array(float* values, std::size_t count) noexcept
+{
+    endian_swap_array(reinterpret_cast<u32*>(values), count);
+}
+
+inline void endian_swap_array(double* values, std::size_t count) noexcept
+{
+    endian_swap_array(reinterpret_cast<u64*>(values), count);
+}
+
+/**
+ * @brief The largest record size endian_swap_records supports.
+ */
+constexpr std::size_t endian_swap_max_record_size = 256;
+
+/**
+ * @brief Endian-swaps recordCount consecutive fixed-size records
+ * (e.g. interleaved vertices) in-place, using the given swap pattern.
+ * Uses SIMD instructions (e.g. SSSE3) when the CPU supports them.
+ *
+ * @param records The records to swap.
+ * @param recordCount The number of records to swap.
+ * @param recordSize The size of each record, in bytes. Must not be
+ * greater than endian_swap_max_record_size.
+ * @param pattern An array of recordSize indices; pattern[i] is the index of the
+ * byte within the original record which ends up at index i once swapped.
+ */
+HL_API void endian_swap_records(void* records, std::size_t recordCount,
+    std::size_t recordSize, const u8* pattern) noexcept;
+
 /* Offsets */
 template<typename T>
 class off32
@@ -2,34 +2,73 @@
 #define HL_ORDERED_MAP_H_INCLUDED
 #include <robin_hood.h>
 #include <vector>
+#include <memory>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <initializer_list>
 #include <cassert>
 
 namespace hl
 {
+/**
+    @brief A hash map which remembers the order its elements were inserted in.
+
+    Each element is allocated individually, so references and pointers to
+    elements stay valid until the elements themselves are erased (even when
+    the map grows).
+
+    The insertion order is kept in a list of slots which also stores each
+    element's position. Erasing an element just marks its slot as empty
+    (a "tombstone"), so erasing is O(1), and never invalidates iterators to
+    other elements. Tombstones are compacted away by compact(), or automatically
+    on insertion once they make up the majority of the slots.
+*/
 template<typename Key, typename Value>
 class ordered_map
 {
-    using in_map_type   = robin_hood::unordered_map<Key, Value>;
-    using in_vec_type   = std::vector<typename in_map_type::value_type*>;
-    using in_this_type  = ordered_map<Key, Value>;
+public:
+    using value_type    = std::pair<const Key, Value>;
+
+private:
+    using in_index_map_type = robin_hood::unordered_flat_map<Key, std::size_t>;
+    using in_vec_type       = std::vector<value_type*>;
+    using in_this_type      = ordered_map<Key, Value>;
 
-    in_map_type m_data;
+    /** @brief Maps each key to the index of its element's slot within m_orderedPtrs. */
+    in_index_map_type m_indices;
+    /** @brief The elements, in insertion order. Erased elements are left as null. */
     in_vec_type m_orderedPtrs;
 
     template<bool IsConst>
     class in_iterator
     {
         friend in_this_type;
+        template<bool> friend class in_iterator;
 
-        using in_inner_type = std::conditional_t<IsConst,
-            typename in_vec_type::const_iterator,
-            typename in_vec_type::iterator>;
+        using in_inner_type = typename in_this_type::value_type* const*;
 
-        in_inner_type m_current;
+        in_inner_type m_current = nullptr;
+        in_inner_type m_end = nullptr;
+
+        inline void in_skip_tombstones() noexcept
+        {
+            while (m_current != m_end && !*m_current)
+            {
+                ++m_current;
+            }
+        }
+
+        inline in_iterator(in_inner_type current, in_inner_type end) noexcept :
+            m_current(current),
+            m_end(end)
+        {
+            in_skip_tombstones();
+        }
 
     public:
         using difference_type   = std::ptrdiff_t;
-        using value_type        = typename in_map_type::value_type;
+        using value_type        = typename in_this_type::value_type;
 
         using reference         = std::conditional_t<
             IsConst, const value_type&, value_type&>;
@@ -37,17 +76,19 @@ class ordered_map
         using pointer           = std::conditional_t<
             IsConst, const value_type*, value_type*>;
 
-        using iterator_category = std::random_access_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
 
         inline void swap(in_iterator& other) noexcept
         {
             using std::swap;
             swap(m_current, other.m_current);
+            swap(m_end, other.m_end);
         }
 
         inline in_iterator& operator++() noexcept
         {
             ++m_current;
+            in_skip_tombstones();
             return *this;
         }
 
@@ -60,7 +101,14 @@ class ordered_map
 
         inline in_iterator& operator--() noexcept
         {
-            --m_current;
+            // NOTE: There's always a non-null element before any
+            // iterator it is valid to decrement.
+            do
+            {
+                --m_current;
+            }
+            while (!*m_current);
+
             return *this;
         }
 
@@ -71,18 +119,6 @@ class ordered_map
             return tmp;
         }
 
-        inline in_iterator& operator+=(difference_type amount) noexcept
-        {
-            m_current += amount;
-            return *this;
-        }
-
-        inline in_iterator& operator-=(difference_type amount) noexcept
-        {
-            m_current -= amount;
-            return *this;
-        }
-
         inline reference operator*() const
         {
             return **m_current;
@@ -93,11 +129,6 @@ class ordered_map
             return *m_current;
         }
 
-        inline reference operator[](difference_type pos) const noexcept
-        {
-            return m_current[pos];
-        }
-
         inline bool operator==(in_iterator other) const noexcept
         {
             return m_current == other.m_current;
@@ -108,68 +139,100 @@ class ordered_map
             return m_current != other.m_current;
         }
 
-        inline bool operator<(in_iterator other) const noexcept
+        inline friend void swap(in_iterator& a, in_iterator& b) noexcept
         {
-            return m_current < other.m_current;
+            a.swap(b);
         }
 
-        inline bool operator>(in_iterator other) const noexcept
+        inline operator in_iterator<true>() const noexcept
         {
-            return m_current > other.m_current;
+            return in_iterator<true>(m_current, m_end);
         }
 
-        inline bool operator<=(in_iterator other) const noexcept
-        {
-            return m_current <= other.m_current;
-        }
+        inline in_iterator() noexcept = default;
+    };
 
-        inline bool operator>=(in_iterator other) const noexcept
-        {
-            return m_current >= other.m_current;
-        }
+    inline value_type* const* in_slots_begin() const noexcept
+    {
+        return m_orderedPtrs.data();
+    }
 
-        inline friend void swap(in_iterator& a, in_iterator& b) noexcept
-        {
-            a.swap(b);
-        }
+    inline value_type* const* in_slots_end() const noexcept
+    {
+        return (m_orderedPtrs.data() + m_orderedPtrs.size());
+    }
+
+    inline in_iterator<false> in_make_iterator(std::size_t slotIndex) const noexcept
+    {
+        return in_iterator<false>(in_slots_begin() + slotIndex, in_slots_end());
+    }
+
+    inline std::size_t in_get_slot_index(in_iterator<true> pos) const noexcept
+    {
+        return static_cast<std::size_t>(pos.m_current - in_slots_begin());
+    }
 
-        inline friend in_iterator operator+(in_iterator it, difference_type amount) noexcept
+    std::pair<value_type*, bool> in_add(std::unique_ptr<value_type> node)
+    {
+        // Automatically compact the slots if most of them are tombstones.
+        if (m_orderedPtrs.size() >= 16 &&
+            m_orderedPtrs.size() - m_indices.size() > m_indices.size())
         {
-            return (it.m_current + amount);
+            compact();
         }
 
-        inline friend in_iterator operator+(difference_type amount, in_iterator it) noexcept
+        // Reserve a slot for the new element.
+        const auto slotIndex = m_orderedPtrs.size();
+        m_orderedPtrs.push_back(nullptr);
+
+        // Add the new element's key to the index map, or just return the
+        // existing element if there's already one with the same key.
+        std::pair<typename in_index_map_type::iterator, bool> p;
+        try
         {
-            return (amount + it.m_current);
+            p = m_indices.emplace(node->first, slotIndex);
         }
-
-        inline friend in_iterator operator-(in_iterator it, difference_type amount) noexcept
+        catch (...)
         {
-            return (it.m_current - amount);
+            m_orderedPtrs.pop_back();
+            throw;
         }
 
-        inline friend difference_type operator-(in_iterator b, in_iterator a) noexcept
+        if (!p.second)
         {
-            return (b - a);
+            m_orderedPtrs.pop_back();
+            return { m_orderedPtrs[p.first->second], false };
         }
 
-        inline in_iterator() noexcept = default;
+        // Store the new element within its slot.
+        m_orderedPtrs.back() = node.release();
+        return { m_orderedPtrs.back(), true };
+    }
 
-        inline in_iterator(in_inner_type it) noexcept :
-            m_current(std::move(it)) {}
-    };
+    void in_erase_slot(std::size_t slotIndex)
+    {
+        const std::unique_ptr<value_type> node(m_orderedPtrs[slotIndex]);
+        m_orderedPtrs[slotIndex] = nullptr;
+        m_indices.erase(node->first);
+    }
+
+    void in_delete_nodes() noexcept
+    {
+        for (auto node : m_orderedPtrs)
+        {
+            delete node;
+        }
+    }
 
 public:
-    using key_type          = typename in_map_type::key_type;
-    using mapped_type       = typename in_map_type::mapped_type;
-    using value_type        = typename in_map_type::value_type;
-    using size_type         = typename in_map_type::size_type;
-    //using difference_type   = in_map_type::difference_type;
-    using hasher            = typename in_map_type::hasher;
-    using key_equal         = typename in_map_type::key_equal;
-    //using allocator_type    = in_map_type::allocator_type;
+    using key_type          = Key;
+    using mapped_type       = Value;
+    using size_type         = std::size_t;
+    using difference_type   = std::ptrdiff_t;
+    using hasher            = typename in_index_map_type::hasher;
+    using key_equal         = typename in_index_map_type::key_equal;
     using reference         = value_type&;
-    using const_reference   = const value_type;
+    using const_reference   = const value_type&;
     using pointer           = value_type*;
     using const_pointer     = const value_type*;
     using iterator          = in_iterator<false>;
@@ -177,7 +240,7 @@ public:
 
     inline const_iterator cbegin() const noexcept
     {
-        return m_orderedPtrs.begin();
+        return const_iterator(in_slots_begin(), in_slots_end());
     }
 
     inline const_iterator begin() const noexcept
@@ -187,12 +250,12 @@ public:
 
     inline iterator begin() noexcept
     {
-        return m_orderedPtrs.begin();
+        return iterator(in_slots_begin(), in_slots_end());
     }
 
     inline const_iterator cend() const noexcept
     {
-        return m_orderedPtrs.end();
+        return const_iterator(in_slots_end(), in_slots_end());
     }
 
     inline const_iterator end() const noexcept
@@ -200,64 +263,111 @@ public:
         return cend();
     }
 
-    inline iterator end()
+    inline iterator end() noexcept
     {
-        return m_orderedPtrs.end();
+        return iterator(in_slots_end(), in_slots_end());
     }
 
     [[nodiscard]] inline bool empty() const noexcept
     {
-        return m_data.empty();
+        return m_indices.empty();
     }
 
     inline size_type size() const noexcept
     {
-        return m_data.size();
+        return m_indices.size();
+    }
+
+    /** @brief Gets how many erased elements are still taking up slots. */
+    inline size_type tombstone_count() const noexcept
+    {
+        return (m_orderedPtrs.size() - m_indices.size());
+    }
+
+    const_iterator find(const Key& key) const
+    {
+        const auto it = m_indices.find(key);
+        return (it == m_indices.end()) ? cend() :
+            in_make_iterator(it->second);
+    }
+
+    iterator find(const Key& key)
+    {
+        const auto it = m_indices.find(key);
+        return (it == m_indices.end()) ? end() :
+            in_make_iterator(it->second);
     }
 
     const Value* get(const Key& key) const
     {
-        const auto it = m_data.find(key);
-        return (it == m_data.end()) ? nullptr : &it->second;
+        const auto it = m_indices.find(key);
+        return (it == m_indices.end()) ? nullptr :
+            &m_orderedPtrs[it->second]->second;
     }
 
     Value* get(const Key& key)
     {
-        const auto it = m_data.find(key);
-        return (it == m_data.end()) ? nullptr : &it->second;
+        const auto it = m_indices.find(key);
+        return (it == m_indices.end()) ? nullptr :
+            &m_orderedPtrs[it->second]->second;
     }
 
     inline bool contains(const Key& key) const
     {
-        return m_data.contains(key);
+        return (m_indices.find(key) != m_indices.end());
     }
 
     void reserve(size_type count)
     {
-        m_data.reserve(count);
+        m_indices.reserve(count);
         m_orderedPtrs.reserve(count);
     }
 
+    /**
+        @brief Removes all tombstones left behind by erased elements, so that
+        iteration doesn't have to skip over them. Invalidates all iterators,
+        but not references or pointers to elements.
+    */
+    void compact() noexcept
+    {
+        if (m_orderedPtrs.size() == m_indices.size()) return;
+
+        // Move every remaining element to the front of the slots, in order,
+        // and update their indices.
+        std::size_t slotIndex = 0;
+        for (auto node : m_orderedPtrs)
+        {
+            if (!node) continue;
+
+            m_indices.find(node->first)->second = slotIndex;
+            m_orderedPtrs[slotIndex++] = node;
+        }
+
+        // Remove the now-unused slots.
+        m_orderedPtrs.erase(m_orderedPtrs.begin() + slotIndex,
+            m_orderedPtrs.end());
+    }
+
     std::pair<value_type*, bool> insert(const value_type& value)
     {
-        const auto p = m_data.insert(value);
-        if (p.second)
+        const auto it = m_indices.find(value.first);
+        if (it != m_indices.end())
         {
-            m_orderedPtrs.push_back(&(*p.first));
+            return { m_orderedPtrs[it->second], false };
         }
 
-        return { &(*p.first), p.second };
+        return in_add(std::make_unique<value_type>(value));
     }
 
     std::pair<value_type*, bool> insert(value_type&& value)
     {
-        const auto p = m_data.insert(std::move(value));
-        if (p.second)
+        const auto it = m_indices.find(value.first);
+        if (it != m_indices.end())
         {
-            m_orderedPtrs.push_back(&(*p.first));
+            return { m_orderedPtrs[it->second], false };
         }
 
-        return { &(*p.first), p.second };
+        return in_add(std::make_unique<value_type>(std::move(value)));
     }
 
     template<typename InputIt>
@@ -277,96 +387,106 @@ public:
     template<typename... Args>
     std::pair<value_type*, bool> emplace(Args&&... args)
     {
-        const auto p = m_data.emplace(std::forward<Args>(args)...);
-        if (p.second)
-        {
-            m_orderedPtrs.push_back(&(*p.first));
-        }
-
-        return { &(*p.first), p.second };
+        return in_add(std::make_unique<value_type>(std::forward<Args>(args)...));
     }
 
     template<typename Mapped>
     std::pair<value_type*, bool> insert_or_assign(const Key& key, Mapped&& obj)
     {
-        const auto p = m_data.insert_or_assign(key, std::forward<Mapped>(obj));
-        if (p.second)
+        const auto it = m_indices.find(key);
+        if (it != m_indices.end())
         {
-            m_orderedPtrs.push_back(&(*p.first));
+            const auto node = m_orderedPtrs[it->second];
+            node->second = std::forward<Mapped>(obj);
+            return { node, false };
         }
 
-        return { &(*p.first), p.second };
+        return in_add(std::make_unique<value_type>(
+            key, std::forward<Mapped>(obj)));
     }
 
     template<typename Mapped>
     std::pair<Value*, bool> insert_or_assign(Key&& key, Mapped&& obj)
     {
-        const auto p = m_data.insert_or_assign(std::move(key), std::forward<Mapped>(obj));
-        if (p.second)
-        {
-            m_orderedPtrs.emplace_back(p.first->first, &p.first->second);
-        }
-        else
+        const auto it = m_indices.find(key);
+        if (it != m_indices.end())
         {
-            p.first->second = std::forward<Mapped>(obj);
+            const auto node = m_orderedPtrs[it->second];
+            node->second = std::forward<Mapped>(obj);
+            return { &node->second, false };
         }
 
+        const auto p = in_add(std::make_unique<value_type>(
+            std::move(key), std::forward<Mapped>(obj)));
+
         return { &p.first->second, p.second };
     }
 
     iterator erase(const_iterator pos)
     {
-        const auto it = m_orderedPtrs.erase(pos.m_current);
-        m_data.erase(pos->first);
-        return it;
+        const auto slotIndex = in_get_slot_index(pos);
+        in_erase_slot(slotIndex);
+        return in_make_iterator(slotIndex + 1);
     }
 
-    iterator erase(iterator pos)
+    inline iterator erase(iterator pos)
     {
-        const auto it = m_orderedPtrs.erase(pos.m_current);
-        m_data.erase(pos->first);
-        return it;
+        return erase(const_iterator(pos));
     }
 
     iterator erase(const_iterator first, const_iterator last)
     {
-        const auto it = m_orderedPtrs.erase(first.m_current, last.m_current);
-        for (; first != last; ++first)
+        const auto lastSlotIndex = in_get_slot_index(last);
+        for (auto slotIndex = in_get_slot_index(first);
+            slotIndex < lastSlotIndex; ++slotIndex)
         {
-            m_data.erase((*first)->first);
+            if (m_orderedPtrs[slotIndex])
+            {
+                in_erase_slot(slotIndex);
+            }
         }
 
-        return it;
+        return in_make_iterator(lastSlotIndex);
+    }
+
+    size_type erase(const Key& key)
+    {
+        const auto it = m_indices.find(key);
+        if (it == m_indices.end()) return 0;
+
+        in_erase_slot(it->second);
+        return 1;
     }
 
     void clear() noexcept
     {
+        in_delete_nodes();
         m_orderedPtrs.clear();
-        m_data.clear();
+        m_indices.clear();
     }
 
     void swap(ordered_map& other) noexcept
     {
-        m_data.swap(other.m_data);
+        m_indices.swap(other.m_indices);
         m_orderedPtrs.swap(other.m_orderedPtrs);
     }
 
     inline const Value& operator[](const Key& key) const
     {
-        const auto it = m_data.find(key);
-        assert(it != m_data.end() &&
+        const auto it = m_indices.find(key);
+        assert(it != m_indices.end() &&
             "The given key was not found within the map");
 
-        return it->second;
+        return m_orderedPtrs[it->second]->second;
     }
 
     inline Value& operator[](const Key& key)
     {
-        const auto it = m_data.find(key);
-        assert(it != m_data.end() &&
+        const auto it = m_indices.find(key);
+        assert(it != m_indices.end() &&
             "The given key was not found within the map");
 
-        return it->second;
+        return m_orderedPtrs[it->second]->second;
     }
 
     ordered_map& operator=(std::initializer_list<value_type> ilist)
@@ -381,17 +501,27 @@ public:
         if (&other != this)
         {
             clear();
+            reserve(other.size());
             insert(other.begin(), other.end());
         }
 
         return *this;
     }
 
-    ordered_map& operator=(ordered_map&& other) noexcept = default;
+    ordered_map& operator=(ordered_map&& other) noexcept
+    {
+        if (&other != this)
+        {
+            clear();
+            swap(other);
+        }
+
+        return *this;
+    }
 
     ordered_map() noexcept(
-        noexcept(typename in_map_type::Table()) &&
-        noexcept(typename in_vec_type::vector())) = default;
+        std::is_nothrow_default_constructible_v<in_index_map_type> &&
+        std::is_nothrow_default_constructible_v<in_vec_type>) = default;
 
     template<typename InputIt>
     ordered_map(InputIt first, InputIt last)
@@ -402,10 +532,24 @@ public:
     inline ordered_map(std::initializer_list<value_type> ilist) :
         ordered_map(ilist.begin(), ilist.end()) {}
 
-    inline ordered_map(const ordered_map& other) :
-        ordered_map(other.begin(), other.end()) {}
+    ordered_map(const ordered_map& other)
+    {
+        reserve(other.size());
+        insert(other.begin(), other.end());
+    }
+
+    ordered_map(ordered_map&& other) noexcept :
+        m_indices(std::move(other.m_indices)),
+        m_orderedPtrs(std::move(other.m_orderedPtrs))
+    {
+        other.m_indices.clear();
+        other.m_orderedPtrs.clear();
+    }
 
-    ordered_map(ordered_map&& other) noexcept = default;
+    inline ~ordered_map()
+    {
+        in_delete_nodes();
+    }
 };
 
 template<typename Key, typename Value>
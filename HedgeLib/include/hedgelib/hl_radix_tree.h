@@ -31,6 +31,8 @@ HL_ENUM_CLASS_DEF_BITWISE_OPS(in_radix_node_type)
 
 constexpr u8 in_radix_max_prefix_len = 10;
 
+class in_radix_arena;
+
 struct in_radix_node
 {
     u8 flags;
@@ -145,8 +147,14 @@ struct in_radix_leaf
             alignof(char)) - __STDCPP_DEFAULT_NEW_ALIGNMENT__);
     }
 
-    HL_API static in_radix_leaf* create(std::size_t size,
-        std::size_t index, const char* key);
+    HL_API static in_radix_leaf* create(in_radix_arena* arena,
+        std::size_t size, std::size_t index, const char* key);
+
+    inline static in_radix_leaf* create(std::size_t size,
+        std::size_t index, const char* key)
+    {
+        return create(nullptr, size, index, key);
+    }
 };
 
 using in_radix_sort_func = int (*)(unsigned char a, unsigned char b);
@@ -157,6 +165,7 @@ protected:
     void* m_rootNode = nullptr;
     in_radix_sort_func m_sortFuncPtr;
     std::vector<in_radix_leaf*> m_leafNodes;
+    in_radix_arena* m_arena = nullptr;
 
     using in_const_iterator = std::vector<in_radix_leaf*>::const_iterator;
     using in_iterator = std::vector<in_radix_leaf*>::iterator;
@@ -186,6 +195,36 @@ protected:
             this)->in_find_leaf(key, leafSize));
     }
 
+    /**
+        @brief Creates a new leaf with the given key and adds it to the end of the
+        leaf list, without adding it to the tree's nodes. Only valid while the tree
+        has no nodes; in_link_leaves or in_link_sorted_leaves must be called once
+        all of the leaves have been added.
+    */
+    HL_API in_radix_leaf& in_add_unlinked_leaf(const char* key, std::size_t leafSize);
+
+    HL_API void in_remove_last_unlinked_leaf() noexcept;
+
+    HL_API void in_destroy_unlinked_leaves() noexcept;
+
+    /**
+        @brief Builds the tree's nodes from its (unlinked) leaves, which must have
+        unique keys that are sorted in ascending order as per the tree's sort function.
+        Every node is created with its final type and prefix, rather than being grown
+        one insertion at a time.
+    */
+    HL_API void in_link_sorted_leaves(std::size_t leafSize);
+
+    /**
+        @brief Builds the tree's nodes from its (unlinked) leaves, which must have
+        unique keys. The order of the leaf list itself is left untouched.
+    */
+    HL_API void in_link_leaves(std::size_t leafSize);
+
+    HL_API void in_set_arena_enabled(bool enabled);
+
+    HL_API void in_clear() noexcept;
+
     HL_API void in_destroy() noexcept;
 
     in_radix_tree& operator=(const in_radix_tree& other) = delete;
@@ -237,13 +276,52 @@ protected:
             reinterpret_cast<u8*>(dataPtr) - leaf_data_off());
     }
 
+    inline static const char* in_get_key_c_str(const char* key) noexcept
+    {
+        return key;
+    }
+
+    inline static const char* in_get_key_c_str(const std::string& key) noexcept
+    {
+        return key.c_str();
+    }
+
+    template<typename... args_t>
+    void in_emplace_unlinked(const char* key, args_t&&... args)
+    {
+        auto& leaf = in_add_unlinked_leaf(key, leaf_size());
+
+        try
+        {
+            new (in_get_data_ptr(leaf)) T(std::forward<args_t>(args)...);
+        }
+        catch (...)
+        {
+            in_remove_last_unlinked_leaf();
+            throw;
+        }
+    }
+
     void in_assign_nodes(const radix_tree& other)
     {
         reserve(other.size());
 
-        for (const auto it : other)
+        try
         {
-            insert(it.first, it.second);
+            // Copy the other tree's leaves in the same order.
+            for (const auto it : other)
+            {
+                in_emplace_unlinked(it.first, it.second);
+            }
+
+            // Build the nodes for all of the copied leaves in one go.
+            in_link_leaves(leaf_size());
+        }
+        catch (...)
+        {
+            in_destroy_data();
+            in_destroy_unlinked_leaves();
+            throw;
         }
     }
 
@@ -549,11 +627,67 @@ public:
             });
     }
 
+    /**
+        @brief Replaces the contents of this tree with the given range of key/value
+        pairs, building each of the tree's nodes directly with its final type rather
+        than inserting the keys one at a time. This is much faster than calling insert
+        repeatedly for large numbers of keys.
+
+        @param[in] first    The beginning of the range. Each element must have a first
+                            member (the key; either a const char* or a std::string) and
+                            a second member (the value to copy into the tree).
+        @param[in] last     The end of the range.
+
+        The keys must be unique, and sorted in ascending order as per this tree's sort
+        function (which, by default, sorts as std::strcmp does). An invalid_argument
+        exception is thrown (and the tree is left empty) otherwise.
+
+        The elements are iterated over in the given order afterwards.
+    */
+    template<typename InputIt>
+    void assign_sorted(InputIt first, InputIt last)
+    {
+        clear();
+
+        try
+        {
+            for (; first != last; ++first)
+            {
+                in_emplace_unlinked(in_get_key_c_str(first->first), first->second);
+            }
+
+            in_link_sorted_leaves(leaf_size());
+        }
+        catch (...)
+        {
+            in_destroy_data();
+            in_destroy_unlinked_leaves();
+            throw;
+        }
+    }
+
+    /**
+        @brief Removes every element from this tree, and makes it allocate its nodes and
+        leaves from a private arena (if enabled is true), or individually (if false).
+
+        Arena allocation makes building and destroying large trees several times faster,
+        at the cost of only returning the tree's memory once it is cleared or destroyed.
+    */
+    void use_arena(bool enabled = true)
+    {
+        clear();
+        in_set_arena_enabled(enabled);
+    }
+
+    inline bool uses_arena() const noexcept
+    {
+        return (m_arena != nullptr);
+    }
+
     void clear() noexcept
     {
         in_destroy_data();
-        m_rootNode = nullptr;
-        m_leafNodes.clear();
+        in_clear();
     }
 
     radix_tree& operator=(const radix_tree& other)
@@ -611,6 +745,11 @@ public:
     radix_tree(const radix_tree& other) :
         in_radix_tree(other.m_sortFuncPtr)
     {
+        if (other.uses_arena())
+        {
+            in_set_arena_enabled(true);
+        }
+
         in_assign_nodes(other);
     }
 
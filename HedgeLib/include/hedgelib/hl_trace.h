@@ -0,0 +1,127 @@
+#ifndef HL_TRACE_H_INCLUDED
+#define HL_TRACE_H_INCLUDED
+#include "hl_text.h"
+
+namespace hl
+{
+class stream;
+
+namespace trace
+{
+/**
+ * @brief Whether HedgeLib was built with tracing support (HL_ENABLE_TRACING).
+ * If this is false, HL_TRACE_ZONE expands to nothing, and any traces
+ * written will not contain any zones.
+ */
+#ifdef HL_ENABLE_TRACING
+constexpr bool is_supported = true;
+#else
+constexpr bool is_supported = false;
+#endif
+
+/**
+ * @brief Clears any previously-recorded zones and starts recording new ones.
+ */
+HL_API void start();
+
+/**
+ * @brief Stops recording zones. Zones which have already been recorded are kept.
+ */
+HL_API void stop() noexcept;
+
+/**
+ * @brief Returns whether zones are currently being recorded.
+ */
+HL_API bool is_running() noexcept;
+
+/**
+ * @brief Discards all recorded zones.
+ */
+HL_API void clear();
+
+/**
+ * @brief Writes all recorded zones to the given stream as a Chrome trace
+ * (JSON), which can be viewed in chrome://tracing or in Perfetto.
+ *
+ * NOTE: Zones which are still open when this is called are not written.
+ */
+HL_API void write(stream& stream);
+
+/**
+ * @brief Writes all recorded zones to the given file as a Chrome trace
+ * (JSON), which can be viewed in chrome://tracing or in Perfetto.
+ */
+HL_API void save(const nchar* filePath);
+
+inline void save(const nstring& filePath)
+{
+    save(filePath.c_str());
+}
+
+HL_API u64 in_get_time() noexcept;
+
+HL_API void in_add_zone(const char* name, u64 startTime, u64 endTime);
+
+/**
+ * @brief Records a zone spanning the lifetime of this object, if tracing
+ * is running when it's constructed. Use HL_TRACE_ZONE instead of using
+ * this directly so the zone is compiled out when tracing isn't enabled.
+ */
+class scoped_zone
+{
+    const char* m_name;
+    u64 m_startTime;
+    bool m_isRecording;
+
+public:
+    /**
+     * @param name The name of the zone. Must point to a string literal,
+     * or some other string that outlives the trace.
+     */
+    inline scoped_zone(const char* name) noexcept :
+        m_name(name),
+        m_startTime(0),
+        m_isRecording(is_running())
+    {
+        if (m_isRecording)
+        {
+            m_startTime = in_get_time();
+        }
+    }
+
+    scoped_zone(const scoped_zone& other) = delete;
+    scoped_zone& operator=(const scoped_zone& other) = delete;
+
+    inline ~scoped_zone()
+    {
+        if (m_isRecording)
+        {
+            try
+            {
+                in_add_zone(m_name, m_startTime, in_get_time());
+            }
+            catch (...)
+            {
+                // NOTE: A zone which couldn't be recorded just isn't
+                // in the trace; never let that escape a destructor.
+            }
+        }
+    }
+};
+} // trace
+} // hl
+
+#define HL_IN_TRACE_CONCAT_IMPL(a, b) a##b
+#define HL_IN_TRACE_CONCAT(a, b) HL_IN_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Records a zone with the given name spanning the rest of the current
+ * scope. Expands to nothing unless HedgeLib was built with HL_ENABLE_TRACING.
+ */
+#ifdef HL_ENABLE_TRACING
+#define HL_TRACE_ZONE(name) const ::hl::trace::scoped_zone\
+    HL_IN_TRACE_CONCAT(in_traceZone, __LINE__)(name)
+#else
+#define HL_TRACE_ZONE(name)
+#endif
+#endif
@@ -336,6 +336,13 @@ inline T* get_data(void* rawData)
     return headerPtr->data<T>();
 }
 
+/**
+ * @brief Returns a read-only view of the given *unfixed* BINA data's contents.
+ * Unlike fix(), this never modifies the data, so it's safe to use on shared
+ * or read-only memory.
+ */
+HL_API data_view get_data_view(const void* rawData) noexcept;
+
 template<typename DataType, typename... Args>
 DataType* fix(void* rawData, Args&&... args)
 {
@@ -708,6 +715,14 @@ inline T* get_data(void* rawData)
     return headerPtr->get_data<T>();
 }
 
+/**
+ * @brief Returns a read-only view of the given *unfixed* BINA data's contents
+ * (the data within its data block), or a null view if it has no data block.
+ * Unlike fix32/fix64, this never modifies the data, so it's safe to use on
+ * shared or read-only memory.
+ */
+HL_API data_view get_data_view(const void* rawData);
+
 template<typename DataType, typename... Args>
 DataType* fix32(void* rawData, Args&&... args)
 {
@@ -1045,6 +1060,22 @@ inline T* get_data(void* rawData)
         const_cast<const void*>(rawData)));
 }
 
+inline data_view get_data_view(const void* rawData)
+{
+    if (has_v2_header(rawData))
+    {
+        return v2::get_data_view(rawData);
+    }
+    else if (has_v1_header(rawData))
+    {
+        return v1::get_data_view(rawData);
+    }
+    else
+    {
+        throw invalid_data_exception();
+    }
+}
+
 template<typename DataType, typename... Args>
 DataType* fix32(void* rawData, std::size_t dataSize, Args&&... args)
 {
@@ -0,0 +1,158 @@
+#ifndef HL_DATA_VIEW_H_INCLUDED
+#define HL_DATA_VIEW_H_INCLUDED
+#include "../hl_internal.h"
+#include <cstring>
+
+namespace hl
+{
+/**
+ * @brief A read-only view into *unfixed* data (i.e. data which has not had
+ * fix() called on it), which resolves offsets and swaps endianness on read
+ * rather than rewriting the data in-place.
+ *
+ * Since nothing is ever written, any number of views (on any number of threads)
+ * can safely read the same data at once, including data within const buffers
+ * or read-only memory maps. All reads are done via memcpy, so the data does
+ * not need to be aligned.
+ *
+ * NOTE: Views must never be used on data which has already been fixed, as
+ * offsets within fixed data are absolute pointers rather than relative offsets.
+ */
+class data_view
+{
+    const u8* m_base = nullptr;
+    const u8* m_ptr = nullptr;
+    bool m_swap = false;
+
+public:
+    /**
+     * @brief Returns a pointer to the data offsets within this view are relative to.
+     */
+    inline const void* base() const noexcept
+    {
+        return m_base;
+    }
+
+    /**
+     * @brief Returns a pointer to the data this view points to. Any values
+     * read through this pointer directly are unfixed and may need swapping.
+     */
+    template<typename T = void>
+    inline const T* get() const noexcept
+    {
+        return reinterpret_cast<const T*>(m_ptr);
+    }
+
+    /**
+     * @brief Whether values read through this view need to be endian-swapped.
+     */
+    inline bool needs_swap() const noexcept
+    {
+        return m_swap;
+    }
+
+    /**
+     * @brief Returns this view's position relative to its base.
+     */
+    inline std::size_t pos() const noexcept
+    {
+        return static_cast<std::size_t>(m_ptr - m_base);
+    }
+
+    /**
+     * @brief Returns a view at the given position relative to this view.
+     */
+    inline data_view at(std::size_t pos) const noexcept
+    {
+        return data_view(m_base, m_ptr + pos, m_swap);
+    }
+
+    /**
+     * @brief Reads a value from the given position relative to this view,
+     * endian-swapping it if necessary.
+     *
+     * NOTE: If T is a struct, any offsets within it are left unresolved;
+     * use deref32/deref64 on the offset's position instead.
+     */
+    template<typename T>
+    inline T read(std::size_t pos = 0) const noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+            "data_view can only read trivially-copyable types");
+
+        T val;
+        std::memcpy(&val, m_ptr + pos, sizeof(T));
+
+        if (m_swap)
+        {
+            hl::endian_swap(val);
+        }
+
+        return val;
+    }
+
+    /**
+     * @brief Reads a 32-bit offset from the given position relative
+     * to this view and returns a view of the data it points to, or a
+     * null view if the offset was null.
+     */
+    inline data_view deref32(std::size_t pos = 0) const noexcept
+    {
+        const u32 off = read<u32>(pos);
+        return (off) ? data_view(m_base, m_base + off, m_swap) :
+            data_view(m_base, nullptr, m_swap);
+    }
+
+    /**
+     * @brief Reads a 64-bit offset from the given position relative
+     * to this view and returns a view of the data it points to, or a
+     * null view if the offset was null.
+     */
+    inline data_view deref64(std::size_t pos = 0) const noexcept
+    {
+        const u64 off = read<u64>(pos);
+        return (off) ? data_view(m_base, m_base +
+            static_cast<std::size_t>(off), m_swap) :
+            data_view(m_base, nullptr, m_swap);
+    }
+
+    /**
+     * @brief Reads a 32-bit string offset from the given position relative
+     * to this view and returns the string it points to, or null.
+     */
+    inline const char* str32(std::size_t pos = 0) const noexcept
+    {
+        return deref32(pos).get<char>();
+    }
+
+    /**
+     * @brief Reads a 64-bit string offset from the given position relative
+     * to this view and returns the string it points to, or null.
+     */
+    inline const char* str64(std::size_t pos = 0) const noexcept
+    {
+        return deref64(pos).get<char>();
+    }
+
+    inline explicit operator bool() const noexcept
+    {
+        return (m_ptr != nullptr);
+    }
+
+    inline data_view() noexcept = default;
+
+    /**
+     * @param base The data offsets within this view are relative to.
+     * @param ptr The data this view points to.
+     * @param needsSwap Whether values need to be endian-swapped on read.
+     */
+    inline data_view(const void* base, const void* ptr, bool needsSwap) noexcept :
+        m_base(static_cast<const u8*>(base)),
+        m_ptr(static_cast<const u8*>(ptr)),
+        m_swap(needsSwap) {}
+
+    inline data_view(const void* base, bool needsSwap) noexcept :
+        data_view(base, base, needsSwap) {}
+};
+} // hl
+#endif
@@ -1,6 +1,7 @@
 #ifndef HL_FILE_H_INCLUDED
 #define HL_FILE_H_INCLUDED
 #include "hl_stream.h"
+#include "../hl_allocator.h"
 
 namespace hl
 {
@@ -29,10 +30,10 @@ enum class mode
 
 HL_ENUM_CLASS_DEF_BITWISE_OPS(mode)
 
-HL_API std::unique_ptr<u8[]> load(const nchar* filePath,
+HL_API unique_buffer load(const nchar* filePath,
     std::size_t* dataSize = nullptr);
 
-inline std::unique_ptr<u8[]> load(const nstring& filePath,
+inline unique_buffer load(const nstring& filePath,
     std::size_t* dataSize = nullptr)
 {
     return load(filePath.c_str(), dataSize);
@@ -66,6 +67,13 @@ public:
     void jump_to(std::size_t pos) override;
     void flush() override;
     std::size_t get_size() override;
+    std::size_t read_at(std::size_t pos, std::size_t size, void* buf) override;
+
+    bool supports_concurrent_reads() const noexcept override
+    {
+        return true;
+    }
+
     ~file_stream() override;
 
     HL_API void close();
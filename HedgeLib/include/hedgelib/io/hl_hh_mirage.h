@@ -1,6 +1,7 @@
 #ifndef HL_HH_MIRAGE_H_INCLUDED
 #define HL_HH_MIRAGE_H_INCLUDED
 #include "hl_stream.h"
+#include "hl_data_view.h"
 
 namespace hl
 {
@@ -155,6 +156,13 @@ T* get_data(void* rawData, u32* version = nullptr)
     return const_cast<T*>(get_data<T>(const_cast<
         const void*>(rawData), version));
 }
+
+/**
+ * @brief Returns a read-only view of the given *unfixed* data's contents,
+ * which can be used in place of fix() + get_data() when the data must not
+ * be modified (e.g. because it's shared, or within a read-only memory map).
+ */
+HL_API data_view get_data_view(const void* rawData, u32* version = nullptr) noexcept;
 } // standard
 
 namespace sample_chunk
@@ -452,6 +460,14 @@ T* get_data(void* rawData, u32* version = nullptr)
         const void*>(rawData), version));
 }
 
+/**
+ * @brief Returns a read-only view of the given *unfixed* data's contents
+ * (the data within its "Contexts" node), or a null view if there was no
+ * "Contexts" node. Can be used in place of fix() + get_data() when the data
+ * must not be modified (e.g. because it's shared, or within a read-only memory map).
+ */
+HL_API data_view get_data_view(const void* rawData, u32* version = nullptr);
+
 HL_API void make_node_name(const char* name, char* dst, bool appendNull = true);
 } // sample_chunk
 
@@ -488,6 +504,13 @@ T* get_data(void* rawData, u32* version = nullptr)
         const void*>(rawData), version));
 }
 
+/**
+ * @brief Returns a read-only view of the given *unfixed* data's contents,
+ * regardless of which type of header it has. Unlike fix(), this never
+ * modifies the data, so it's safe to use on shared or read-only memory.
+ */
+HL_API data_view get_data_view(const void* rawData, u32* version = nullptr);
+
 HL_API void offsets_fix(off_table_handle offsets, void* base);
 HL_API void offsets_write_no_sort(std::size_t basePos,
     const off_table& offTable, stream& stream);
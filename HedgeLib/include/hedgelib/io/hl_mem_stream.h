@@ -18,6 +18,13 @@ public:
     void jump_to(std::size_t pos) override;
     void flush() override;
     std::size_t get_size() override;
+    std::size_t read_at(std::size_t pos, std::size_t size, void* buf) override;
+
+    bool supports_concurrent_reads() const noexcept override
+    {
+        return true;
+    }
+
     ~readonly_mem_stream() override;
 
     template<typename T = void>
@@ -53,6 +60,10 @@ public:
         return reinterpret_cast<T*>(const_cast<u8*>(m_handle));
     }
 
+    /**
+     * @brief Releases ownership of the stream's data buffer and resets the stream.
+     * @return The data buffer, which must be freed with hl::deallocate.
+     */
     HL_API void* release() noexcept;
 
     HL_API void close();
@@ -68,7 +79,8 @@ public:
         m_dataCap(0) {}
 
     inline mem_stream(std::size_t initialBufCapacity) :
-        readonly_mem_stream(new u8[initialBufCapacity], 0),
+        readonly_mem_stream(hl::allocate(initialBufCapacity,
+            memory_subsystem::stream), 0),
         m_dataCap(initialBufCapacity) {}
 
     HL_API mem_stream(const void* initialData,
@@ -39,6 +39,29 @@ public:
 
     virtual std::size_t get_size() = 0;
 
+    /**
+        @brief Reads up to the given number of bytes starting at the given
+        absolute position, without changing the stream's current position.
+
+        The default implementation just jumps to the given position, reads, and
+        jumps back, so it is NOT thread-safe. Streams which override this (e.g.
+        file_stream and readonly_mem_stream) allow it to be called concurrently
+        from multiple threads, as long as no other functions which use or modify
+        the stream's position (read, write, seek, etc.) are called at the same time,
+        and report that they do so via supports_concurrent_reads().
+    */
+    virtual std::size_t read_at(std::size_t pos,
+        std::size_t size, void* buf);
+
+    /**
+        @brief Returns whether read_at can safely be called
+        concurrently from multiple threads on this stream.
+    */
+    virtual bool supports_concurrent_reads() const noexcept
+    {
+        return false;
+    }
+
     virtual ~stream() = 0;
 
     inline void jump_ahead(long long amount)
@@ -65,6 +88,8 @@ public:
 
     HL_API void write_all(std::size_t size, const void* buf);
 
+    HL_API void read_all_at(std::size_t pos, std::size_t size, void* buf);
+
     template<typename T>
     inline void read_obj(T& obj)
     {
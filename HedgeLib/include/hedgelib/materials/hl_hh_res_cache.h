@@ -0,0 +1,143 @@
+#ifndef HL_HH_RES_CACHE_H_INCLUDED
+#define HL_HH_RES_CACHE_H_INCLUDED
+#include "hl_hh_material.h"
+#include <robin_hood.h>
+#include <memory>
+
+namespace hl
+{
+class archive_entry;
+struct archive_entry_list;
+class blob;
+
+namespace hh
+{
+namespace mirage
+{
+/**
+    @brief Resolves materials, texsets, and texture entries by name, loading each
+    of them at most once, from any number of loose directories and/or archives.
+
+    Resources are looked for within the added archives first (in the order they
+    were added), then within the added directories (in the order they were added).
+    Resources which could not be found are remembered as well, so they are only
+    looked for once.
+
+    Materials' texsets, and texsets' texture entries, are resolved through the
+    same cache, so a texset or texture entry shared by many materials is only
+    loaded and parsed once.
+*/
+class res_cache
+{
+    template<typename T>
+    using res_map = robin_hood::unordered_node_map<std::string, std::unique_ptr<T>>;
+
+    template<typename T>
+    struct in_loaded_res
+    {
+        std::unique_ptr<T> res;
+        bool needsDeps = false;
+    };
+
+    std::vector<nstring> m_dirs;
+    robin_hood::unordered_map<std::string, const archive_entry*> m_arcEntries;
+    res_map<material> m_materials;
+    res_map<texset> m_texsets;
+    res_map<texture_entry> m_texEntries;
+    std::size_t m_loadCount = 0;
+    std::size_t m_hitCount = 0;
+
+    void in_add_arc_entries(const archive_entry_list& arc);
+
+    std::unique_ptr<blob> in_load(const std::string& name, const nchar* ext) const;
+
+    template<typename T>
+    in_loaded_res<T> in_load_res(const std::string& name) const;
+
+    template<typename T>
+    T* in_get(res_map<T>& resMap, const std::string& name);
+
+    template<typename T>
+    std::vector<T*> in_preload(res_map<T>& resMap,
+        const std::vector<std::string>& names);
+
+    void in_resolve_deps(material& mat);
+
+    void in_resolve_deps(texset& tset);
+
+    inline void in_resolve_deps(texture_entry& /*texEntry*/) noexcept {}
+
+public:
+    /**
+        @brief Adds the given directory as a place to look for resources.
+    */
+    HL_API void add_dir(const nchar* dir);
+
+    inline void add_dir(const nstring& dir)
+    {
+        add_dir(dir.c_str());
+    }
+
+    /**
+        @brief Adds the files within the given opened archive (including those within
+        its sub-directories) as a place to look for resources. Only regular and
+        reference files are used; streaming files are ignored.
+
+        The given archive must outlive this cache.
+    */
+    HL_API void add_archive(const archive_entry_list& arc);
+
+    /**
+        @brief Gets the material with the given name, loading it if necessary.
+        @return The material, or null if it couldn't be found.
+    */
+    HL_API material* get_material(const std::string& name);
+
+    /**
+        @brief Gets the texset with the given name, loading it if necessary.
+        @return The texset, or null if it couldn't be found.
+    */
+    HL_API texset* get_texset(const std::string& name);
+
+    /**
+        @brief Gets the texture entry with the given name, loading it if necessary.
+        @return The texture entry, or null if it couldn't be found.
+    */
+    HL_API texture_entry* get_texture_entry(const std::string& name);
+
+    /**
+        @brief Loads the given materials, along with their texsets and texture entries,
+        ahead of time. Resources which aren't already within the cache are loaded and
+        parsed concurrently across multiple threads, and then added to the cache in
+        the given order, so the results are the same as calling get_material for each.
+
+        @param[in] names    The names of the materials to load.
+    */
+    HL_API void preload_materials(const std::vector<std::string>& names);
+
+    /**
+        @brief Points the given reference to the material it names, if it doesn't
+        already point to one.
+        @return Whether the given reference now points to a material.
+    */
+    HL_API bool resolve(res_ref<material>& ref);
+
+    /** @brief Gets how many resources have been loaded from disk/archives so far. */
+    inline std::size_t load_count() const noexcept
+    {
+        return m_loadCount;
+    }
+
+    /** @brief Gets how many resource requests were served from the cache so far. */
+    inline std::size_t hit_count() const noexcept
+    {
+        return m_hitCount;
+    }
+
+    /** @brief Removes every cached resource. Added directories and archives are kept. */
+    HL_API void clear() noexcept;
+};
+} // mirage
+} // hh
+} // hl
+#endif
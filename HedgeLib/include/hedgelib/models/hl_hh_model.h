@@ -12,6 +12,7 @@ namespace hh
 namespace mirage
 {
 class material;
+class res_cache;
 class skeletal_model;
 class terrain_model;
 struct node;
@@ -514,6 +515,183 @@ HL_STATIC_ASSERT_SIZE(raw_terrain_model_v5r2, 16);
 
 HL_API u32 get_terrain_model_v5_revision(const void* rawData);
 
+/**
+ * @brief A read-only view of an *unfixed* raw_mesh_r1 or raw_mesh_r2.
+ */
+class raw_mesh_view
+{
+    data_view m_mesh;
+
+public:
+    inline const char* material_name() const noexcept
+    {
+        return m_mesh.str32(offsetof(raw_mesh_r1, materialName));
+    }
+
+    inline u32 face_count() const noexcept
+    {
+        return m_mesh.read<u32>(offsetof(raw_mesh_r1, faces) +
+            offsetof(arr32<u16>, count));
+    }
+
+    inline u16 face(std::size_t index) const noexcept
+    {
+        return m_mesh.deref32(offsetof(raw_mesh_r1, faces) +
+            offsetof(arr32<u16>, dataPtr)).read<u16>(sizeof(u16) * index);
+    }
+
+    inline u32 vertex_count() const noexcept
+    {
+        return m_mesh.read<u32>(offsetof(raw_mesh_r1, vertexCount));
+    }
+
+    inline u32 vertex_size() const noexcept
+    {
+        return m_mesh.read<u32>(offsetof(raw_mesh_r1, vertexSize));
+    }
+
+    /**
+     * @brief Returns a view of the vertices, which are unfixed;
+     * use the vertex elements to know how to read them.
+     */
+    inline data_view vertices() const noexcept
+    {
+        return m_mesh.deref32(offsetof(raw_mesh_r1, vertices));
+    }
+
+    /**
+     * @brief Returns the vertex element at the given index.
+     * The last element always has a stream of 0xFF.
+     */
+    inline raw_vertex_element vertex_element(std::size_t index) const noexcept
+    {
+        return m_mesh.deref32(offsetof(raw_mesh_r1, vertexElements)).
+            read<raw_vertex_element>(sizeof(raw_vertex_element) * index);
+    }
+
+    inline u32 texture_unit_count() const noexcept
+    {
+        return m_mesh.read<u32>(offsetof(raw_mesh_r1, textureUnits) +
+            offsetof(arr32<off32<raw_texture_unit>>, count));
+    }
+
+    inline const char* texture_unit_name(std::size_t index) const noexcept
+    {
+        return m_mesh.deref32(offsetof(raw_mesh_r1, textureUnits) +
+            offsetof(arr32<off32<raw_texture_unit>>, dataPtr)).deref32(
+            sizeof(off32<raw_texture_unit>) * index).str32(
+            offsetof(raw_texture_unit, name));
+    }
+
+    inline raw_mesh_view(const data_view& mesh) noexcept :
+        m_mesh(mesh) {}
+};
+
+enum class raw_mesh_slot_type
+{
+    opaq = 0,
+    trans,
+    punch
+};
+
+/**
+ * @brief A read-only view of an *unfixed* raw_mesh_group_r1 or raw_mesh_group_r2.
+ */
+class raw_mesh_group_view
+{
+    data_view m_group;
+
+    inline static std::size_t get_slot_pos(raw_mesh_slot_type slotType) noexcept
+    {
+        return (sizeof(raw_mesh_slot_r1) * static_cast<std::size_t>(slotType));
+    }
+
+public:
+    inline const char* name() const noexcept
+    {
+        return m_group.at(sizeof(raw_mesh_group_r1)).get<char>();
+    }
+
+    inline u32 mesh_count(raw_mesh_slot_type slotType) const noexcept
+    {
+        return m_group.read<u32>(get_slot_pos(slotType) +
+            offsetof(raw_mesh_slot_r1, count));
+    }
+
+    inline raw_mesh_view mesh(raw_mesh_slot_type slotType,
+        std::size_t index) const noexcept
+    {
+        return m_group.deref32(get_slot_pos(slotType) +
+            offsetof(raw_mesh_slot_r1, dataPtr)).deref32(
+            sizeof(off32<raw_mesh_r1>) * index);
+    }
+
+    inline raw_mesh_group_view(const data_view& group) noexcept :
+        m_group(group) {}
+};
+
+/**
+ * @brief A read-only view of an *unfixed* raw_terrain_model_v5r1 or
+ * raw_terrain_model_v5r2, which can be used in place of fixing the model
+ * when the data must not be modified, e.g.:
+ *
+ * raw_terrain_model_v5_view mdl(get_data_view(rawData));
+ */
+class raw_terrain_model_v5_view
+{
+    data_view m_mdl;
+
+public:
+    /**
+     * @brief Returns the revision of the model; see hl::hh::mirage::get_terrain_model_v5_revision.
+     */
+    inline u32 revision() const noexcept
+    {
+        // HACK: Same check as get_terrain_model_v5_revision, but using relative offsets.
+        const u32 rev2_endPos = static_cast<u32>(m_mdl.pos() +
+            sizeof(raw_terrain_model_v5r2));
+
+        const u32 meshGroupsPos = m_mdl.read<u32>(
+            offsetof(raw_terrain_model_v5r2, meshGroups) +
+            offsetof(arr32<off32<raw_mesh_group_r1>>, dataPtr));
+
+        const u32 namePos = m_mdl.read<u32>(
+            offsetof(raw_terrain_model_v5r2, name));
+
+        return (meshGroupsPos < rev2_endPos || namePos < rev2_endPos) ?
+            1 : 2;
+    }
+
+    inline const char* name() const noexcept
+    {
+        return m_mdl.str32(offsetof(raw_terrain_model_v5r2, name));
+    }
+
+    inline bool is_instanced() const noexcept
+    {
+        return (revision() >= 2 && (m_mdl.read<raw_terrain_model_flags>(
+            offsetof(raw_terrain_model_v5r2, flags)) &
+            raw_terrain_model_flags::is_instanced) !=
+            raw_terrain_model_flags::none);
+    }
+
+    inline u32 mesh_group_count() const noexcept
+    {
+        return m_mdl.read<u32>(offsetof(raw_terrain_model_v5r2, meshGroups) +
+            offsetof(arr32<off32<raw_mesh_group_r1>>, count));
+    }
+
+    inline raw_mesh_group_view mesh_group(std::size_t index) const noexcept
+    {
+        return m_mdl.deref32(offsetof(raw_terrain_model_v5r2, meshGroups) +
+            offsetof(arr32<off32<raw_mesh_group_r1>>, dataPtr)).deref32(
+            sizeof(off32<raw_mesh_group_r1>) * index);
+    }
+
+    inline raw_terrain_model_v5_view(const data_view& mdl) noexcept :
+        m_mdl(mdl) {}
+};
+
 struct raw_skeletal_model_v2
 {
     raw_mesh_slot_r1 meshes;
@@ -845,6 +1023,19 @@ public:
 
     HL_API std::unordered_set<std::string> get_unique_material_names() const;
 
+    /**
+        @brief Adds every material used by this model to the given scene, resolving
+        them (and their texsets and texture entries) through the given cache.
+    */
+    HL_API void import_materials(res_cache& resCache, const nchar* texDir,
+        scene& scene, bool merge = true, bool includeLibGensTags = true) const;
+
+    inline void import_materials(res_cache& resCache, const nstring& texDir,
+        scene& scene, bool merge = true, bool includeLibGensTags = true) const
+    {
+        import_materials(resCache, texDir.c_str(), scene, merge, includeLibGensTags);
+    }
+
     HL_API void import_materials(const nchar* materialDir, scene& scene,
         bool merge = true, bool includeLibGensTags = true) const;
 
@@ -49,7 +49,7 @@ public:
         load(filePath.c_str());
     }
 
-    set_object_type_database() noexcept = default;
+    HL_API set_object_type_database();
 
     HL_API set_object_type_database(const void* rawData, std::size_t rawDataSize);
 
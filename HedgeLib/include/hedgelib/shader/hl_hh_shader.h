@@ -3,6 +3,8 @@
 #include "../hl_resource.h"
 #include "../hl_math.h"
 #include "../hl_radix_tree.h"
+#include <robin_hood.h>
+#include <string_view>
 
 namespace hl
 {
@@ -10,6 +12,123 @@ namespace hh
 {
 namespace mirage
 {
+/**
+    @brief Maps names to values via their hashes for O(1) lookups. If multiple values
+    are added with the same name, only the first one is kept. Names are copied, so
+    the lookup can outlive whatever the names came from.
+*/
+template<typename T>
+class shader_name_lookup
+{
+    struct entry
+    {
+        std::string name;
+        T value;
+    };
+
+    robin_hood::unordered_flat_map<std::size_t, entry> m_entries;
+    /** @brief Entries whose name hashes collide with those of other entries. */
+    std::vector<entry> m_collisions;
+    std::size_t m_addCount = 0;
+
+    inline static std::size_t in_hash(std::string_view name) noexcept
+    {
+        return std::hash<std::string_view>()(name);
+    }
+
+public:
+    /** @brief Gets how many times add() has been called since the lookup was last cleared. */
+    inline std::size_t add_count() const noexcept
+    {
+        return m_addCount;
+    }
+
+    inline void reserve(std::size_t count)
+    {
+        m_entries.reserve(count);
+    }
+
+    void add(std::string_view name, T value)
+    {
+        ++m_addCount;
+
+        const auto result = m_entries.insert(std::make_pair(
+            in_hash(name), entry{ std::string(name), value }));
+
+        if (result.second || result.first->second.name == name) return;
+
+        for (auto& collision : m_collisions)
+        {
+            if (collision.name == name) return;
+        }
+
+        m_collisions.push_back({ std::string(name), value });
+    }
+
+    const T* find(std::string_view name) const
+    {
+        const auto it = m_entries.find(in_hash(name));
+        if (it == m_entries.end()) return nullptr;
+        if (it->second.name == name) return &it->second.value;
+
+        for (auto& collision : m_collisions)
+        {
+            if (collision.name == name) return &collision.value;
+        }
+
+        return nullptr;
+    }
+
+    inline void clear() noexcept
+    {
+        m_entries.clear();
+        m_collisions.clear();
+        m_addCount = 0;
+    }
+};
+
+/**
+    @brief Builds a lookup which maps the names of the given items to their indices.
+*/
+template<typename T>
+void build_name_lookup(const std::vector<T>& items,
+    shader_name_lookup<std::size_t>& lookup)
+{
+    lookup.clear();
+    lookup.reserve(items.size());
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        lookup.add(items[i].name, i);
+    }
+}
+
+/**
+    @brief Finds the item with the given name via the given lookup, falling back to a
+    linear search if the lookup doesn't contain a matching item (e.g. because items
+    were added, removed, or renamed since it was built).
+*/
+template<typename T>
+const T* find_by_name(const std::vector<T>& items,
+    const shader_name_lookup<std::size_t>& lookup, std::string_view name)
+{
+    if (lookup.add_count() == items.size())
+    {
+        const auto index = lookup.find(name);
+        if (index && *index < items.size() && items[*index].name == name)
+        {
+            return &items[*index];
+        }
+    }
+
+    for (auto& item : items)
+    {
+        if (item.name == name) return &item;
+    }
+
+    return nullptr;
+}
+
 struct raw_shader_param_constant
 {
     /** @brief The name of the shader constant this parameter maps to. */
@@ -229,6 +348,8 @@ struct shader_param_resource
 class shader_params : public res_base
 {
 protected:
+    shader_name_lookup<std::size_t> m_texLookup;
+
     HL_API void in_parse(const raw_shader_params_v2& rawShaderParams);
 
     HL_API void in_parse(const void* rawData);
@@ -252,6 +373,12 @@ public:
 
     HL_API std::size_t total_param_count() const noexcept;
 
+    /**
+        @brief Rebuilds the lookup used by get_texture_param. This is done automatically
+        when parsing/loading; call this after modifying textures if needed.
+    */
+    HL_API void build_lookup();
+
     /*HL_API const shader_param_constant* get_float_param(const char* name) const;
 
     HL_API const shader_param_constant* get_float_param(const std::string& name) const;
@@ -351,6 +478,12 @@ struct pixel_shader_params : public shader_params
 
 class shader : public res_base
 {
+    shader_name_lookup<const shader_param_constant*> m_floatLookup;
+    shader_name_lookup<const shader_param_constant*> m_intLookup;
+    shader_name_lookup<const shader_param_constant*> m_boolLookup;
+    shader_name_lookup<const shader_param_resource*> m_texLookup;
+    bool m_hasParamLookup = false;
+
     HL_API void in_parse(const raw_shader_v2& rawShader);
 
     HL_API void in_parse(const void* rawData);
@@ -366,6 +499,23 @@ public:
 
     HL_API static void fix(void* rawData);
 
+    /**
+        @brief Flattens the parameters of all of this shader's resolved parameter lists
+        into hashed lookups, making all of the get_*_param functions O(1).
+
+        Call this once paramLists have been resolved. The lookups point into the parameter
+        lists, so call it again (or call clear_param_lookup) if paramLists or any of the
+        parameter lists change afterwards.
+    */
+    HL_API void build_param_lookup();
+
+    HL_API void clear_param_lookup() noexcept;
+
+    inline bool has_param_lookup() const noexcept
+    {
+        return m_hasParamLookup;
+    }
+
     HL_API const shader_param_constant* get_float_param(const char* name) const;
 
     inline const shader_param_constant* get_float_param(const std::string& name) const
@@ -588,6 +738,8 @@ struct pixel_shader_permutation
     std::string pixelShaderName;
     pixel_shader* pixelShaders[8] = {};
     std::vector<vertex_shader_permutation> vertexPermutations;
+    /** @brief Maps the names of vertexPermutations to their indices. */
+    shader_name_lookup<std::size_t> vertexPermutationLookup;
 
     inline bool has_sub_permutation(pixel_shader_sub_permutation subPermutation) const noexcept
     {
@@ -618,6 +770,8 @@ struct pixel_shader_permutation
 
 class shader_list : public res_base
 {
+    shader_name_lookup<std::size_t> m_pixelPermutationLookup;
+
     HL_API void in_parse(const raw_shader_list_v0& rawShaderList);
 
     HL_API void in_parse(const void* rawData);
@@ -631,6 +785,13 @@ public:
 
     HL_API static void fix(void* rawData);
 
+    /**
+        @brief Rebuilds the lookups used by get_pixel_permutation and get_vertex_permutation.
+        This is done automatically when parsing/loading; call this after modifying
+        pixelPermutations or their vertexPermutations if needed.
+    */
+    HL_API void build_lookup();
+
     HL_API const pixel_shader_permutation* get_pixel_permutation(const char* name) const;
 
     HL_API const pixel_shader_permutation* get_pixel_permutation(const std::string& name) const;
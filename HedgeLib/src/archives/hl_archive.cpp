@@ -1,6 +1,7 @@
-#include "hedgelib/archives/hl_archive.h"
+#include "hl_in_archive.h"
 #include "hedgelib/io/hl_path.h"
 #include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_trace.h"
 #include <utility>
 #include <cstring>
 
@@ -66,7 +67,9 @@ archive_entry archive_entry::make_regular_file_utf8(const char* fileName,
     std::size_t fileSize, const void* data)
 {
     // Create copy of data.
-    u8* dataPtr = new u8[fileSize];
+    u8* dataPtr = static_cast<u8*>(hl::allocate(
+        fileSize, memory_subsystem::archive));
+
     std::memcpy(dataPtr, data, fileSize);
 
     // Create archive_entry and return it.
@@ -77,7 +80,7 @@ archive_entry archive_entry::make_regular_file_utf8(const char* fileName,
     }
     catch (const std::exception& ex)
     {
-        delete[] dataPtr;
+        hl::deallocate(dataPtr);
         throw ex;
     }
 }
@@ -94,7 +97,9 @@ archive_entry archive_entry::make_regular_file(const nchar* fileName,
     std::size_t fileSize, const void* data)
 {
     // Create copy of data.
-    u8* dataPtr = new u8[fileSize];
+    u8* dataPtr = static_cast<u8*>(hl::allocate(
+        fileSize, memory_subsystem::archive));
+
     std::memcpy(dataPtr, data, fileSize);
 
     // Create archive_entry and return it.
@@ -105,7 +110,7 @@ archive_entry archive_entry::make_regular_file(const nchar* fileName,
     }
     catch (const std::exception& ex)
     {
-        delete[] dataPtr;
+        hl::deallocate(dataPtr);
         throw ex;
     }
 }
@@ -116,7 +121,7 @@ archive_entry archive_entry::make_file(const nchar* filePath, bool loadData)
     {
         // Load the file's data.
         std::size_t fileSize;
-        std::unique_ptr<u8[]> fileData = file::load(filePath, &fileSize);
+        unique_buffer fileData = file::load(filePath, &fileSize);
 
         // Construct a regular archive entry.
         archive_entry entry(0, path::get_name(filePath),
@@ -162,9 +167,9 @@ archive_entry& archive_entry::operator=(const archive_entry& other)
             }
             else
             {
-                newData = new u8[other.m_size];
+                newData = hl::allocate(other.m_size, memory_subsystem::archive);
                 std::memcpy(newData, other.m_data, other.m_size);
-                if (owns_data()) delete[] file_data<u8>();
+                if (owns_data()) hl::deallocate(m_data);
             }
 
             m_data = newData;
@@ -219,7 +224,7 @@ archive_entry::archive_entry(const archive_entry& other) :
     }
     else
     {
-        m_data = new u8[other.m_size];
+        m_data = hl::allocate(other.m_size, memory_subsystem::archive);
         std::memcpy(m_data, other.m_data, other.m_size);
     }
 }
@@ -250,7 +255,7 @@ archive_entry::~archive_entry()
         }
         else
         {
-            delete[] file_data<u8>();
+            hl::deallocate(m_data);
         }
     }
 }
@@ -315,6 +320,8 @@ static void in_archive_extract(const std::vector<archive_entry>& entries,
 
 void archive_entry_list::extract(const nchar* dirPath, bool recursive) const
 {
+    HL_TRACE_ZONE("archive::extract");
+
     // Ensure extraction directory exists.
     nstring pathBuf(dirPath);
     path::create_dir(pathBuf);
@@ -373,8 +380,95 @@ static void in_archive_add_dir_contents(nstring& pathBuf,
 void archive_entry_list::add_dir_contents(const nchar* dirPath,
     bool loadData, bool recursive)
 {
+    HL_TRACE_ZONE("archive::add_dir_contents");
+
     // Add files/directories within the given directory as requested.
     nstring pathBuf(dirPath);
     in_archive_add_dir_contents(pathBuf, loadData, recursive, *this);
 }
+
+u64 in_hash_data(const void* data, std::size_t dataSize) noexcept
+{
+    constexpr u64 prime = 0x100000001B3ULL;
+    const u8* curPtr = static_cast<const u8*>(data);
+    const u8* endPtr = (curPtr + (dataSize & ~static_cast<std::size_t>(7)));
+    u64 hash = (0xCBF29CE484222325ULL ^ static_cast<u64>(dataSize));
+
+    // Hash data 8 bytes at a time.
+    for (; curPtr < endPtr; curPtr += 8)
+    {
+        u64 word;
+        std::memcpy(&word, curPtr, sizeof(word));
+
+        hash = ((hash ^ word) * prime);
+        hash ^= (hash >> 29);
+    }
+
+    // Hash any remaining bytes.
+    for (endPtr += (dataSize & 7); curPtr < endPtr; ++curPtr)
+    {
+        hash = ((hash ^ *curPtr) * prime);
+    }
+
+    return (hash ^ (hash >> 32));
+}
+
+static bool in_entry_data_equals(const archive_entry& entry,
+    const void* data, std::size_t dataSize)
+{
+    // Compare against the referenced file's data if necessary.
+    if (entry.is_reference_file())
+    {
+        const unique_buffer entryData = file::load(entry.path());
+        return (std::memcmp(entryData.get(), data, dataSize) == 0);
+    }
+
+    // Otherwise, compare against the entry's data directly.
+    return (std::memcmp(entry.file_data(), data, dataSize) == 0);
+}
+
+const in_data_dedup_table::stored_data* in_data_dedup_table::find_or_add(
+    const archive_entry& entry, const void* data, std::size_t dataPos,
+    unsigned short splitIndex, bool isShareable)
+{
+    // Search for identical data among the data with the same hash.
+    const std::size_t dataSize = entry.size();
+    const u64 hash = in_hash_data(data, dataSize);
+    const auto range = m_storedData.equal_range(hash);
+    const stored_data* original = nullptr;
+
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        const stored_data& stored = it->second;
+        if (stored.entry->size() != dataSize ||
+            !in_entry_data_equals(*stored.entry, data, dataSize))
+        {
+            continue;
+        }
+
+        // Prefer identical data which was stored within the same split, and
+        // which can be shared with the given entry.
+        if (stored.splitIndex == splitIndex &&
+            isShareable && stored.isShareable)
+        {
+            return &stored;
+        }
+
+        if (!original) original = &stored;
+    }
+
+    // Remember this data, as there's no copy of it which the given entry could share.
+    m_storedData.emplace(hash, stored_data{ &entry,
+        dataPos, splitIndex, isShareable });
+    return original;
+}
+
+void in_data_dedup_table::add_duplicate(const archive_entry& entry,
+    const stored_data& original, bool isShared)
+{
+    m_dupInfo->emplace_back(
+        text::conv<text::native_to_utf8>(entry.name()),
+        text::conv<text::native_to_utf8>(original.entry->name()),
+        entry.size(), isShared);
+}
 } // hl
@@ -1,7 +1,9 @@
+#include "hl_in_archive.h"
 #include "hedgelib/archives/hl_hh_archive.h"
 #include "hedgelib/io/hl_hh_mirage.h"
 #include "hedgelib/io/hl_path.h"
 #include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_trace.h"
 #include <utility>
 
 namespace hl
@@ -12,6 +14,8 @@ namespace ar
 {
 void header::fix(std::size_t hhArcSize)
 {
+    HL_TRACE_ZONE("hh::ar::fix");
+
 #ifdef HL_IS_BIG_ENDIAN
     // Get start and end pointers.
     u8* curPtr = ptradd(this, sizeof(header));
@@ -35,6 +39,8 @@ void header::fix(std::size_t hhArcSize)
 void header::parse(std::size_t hhArcSize,
     archive_entry_list& hlArc) const
 {
+    HL_TRACE_ZONE("hh::ar::parse");
+
     // Get start and end pointers.
     const u8* curPtr = ptradd(this, sizeof(header));
     const u8* endPtr = ptradd(this, hhArcSize);
@@ -142,6 +148,8 @@ template<typename T>
 void in_load(T& filePath, archive_entry_list* hlArc,
     std::vector<blob>* hhArcs)
 {
+    HL_TRACE_ZONE("hh::ar::load");
+
     // Load splits if necessary.
     const nchar* ext = path::get_ext(filePath);
     if (path::ext_is_split(ext))
@@ -194,8 +202,11 @@ void load(const nstring& filePath, archive_entry_list* hlArc,
 void save(const archive_entry_list& arc,
     const nchar* filePath, u32 splitLimit,
     u32 dataAlignment, compress_type compressType,
-    bool generateARL, packed_file_info* pfi)
+    bool generateARL, packed_file_info* pfi,
+    duplicate_file_info* dupInfo)
 {
+    HL_TRACE_ZONE("hh::ar::save");
+
     // TODO: Support compression.
     std::unique_ptr<stream> arl, ar;
     const nchar* exts = path::get_exts(filePath);
@@ -275,10 +286,11 @@ void save(const archive_entry_list& arc,
     path::split_iterator2<> splitIt(pathBuf);
     u32 arSize = sizeof(header), splitCount = 0;
     bool wroteAtLeastOneEntryToCurArc = false;
+    in_data_dedup_table dedupTable(dupInfo);
 
     for (auto& entry : arc)
     {
-        std::unique_ptr<u8[]> fileData;
+        unique_buffer fileData;
         file_entry hhFileEntry;
         const void* fileDataPtr;
 
@@ -419,6 +431,19 @@ void save(const archive_entry_list& arc,
         const std::size_t dataPos = ar->tell();
         ar->write(entry.size(), fileDataPtr);
 
+        // Report duplicate file data if requested.
+        // (NOTE: AR file data is always stored directly after its entry, so it can't be shared.)
+        if (dedupTable.enabled())
+        {
+            const auto original = dedupTable.find_or_add(entry, fileDataPtr,
+                dataPos, static_cast<unsigned short>(splitCount));
+
+            if (original)
+            {
+                dedupTable.add_duplicate(entry, *original, false);
+            }
+        }
+
         // Indicate that we've written at least one entry to this archive.
         wroteAtLeastOneEntryToCurArc = true;
 
@@ -618,6 +643,8 @@ void write(const packed_file_info& pfi,
 
 void read(void* hhPfi, packed_file_info& hlPfi)
 {
+    HL_TRACE_ZONE("hh::pfi::read");
+
     // Fix HH data.
     mirage::fix(hhPfi);
 
@@ -660,6 +687,8 @@ void write(const packed_file_info& pfi,
 void save(const packed_file_info& pfi,
     u32 version, const nchar* filePath)
 {
+    HL_TRACE_ZONE("hh::pfi::save");
+
     // Open file.
     off_table offTable;
     file_stream file(filePath, file::mode::write);
@@ -0,0 +1,80 @@
+#ifndef HL_IN_ARCHIVE_H_INCLUDED
+#define HL_IN_ARCHIVE_H_INCLUDED
+#include "hedgelib/archives/hl_archive.h"
+#include <unordered_map>
+
+namespace hl
+{
+u64 in_hash_data(const void* data, std::size_t dataSize) noexcept;
+
+/**
+    @brief Keeps track of the data that has been written to an archive so
+    far, so that files with byte-identical data can be detected while packing.
+*/
+class in_data_dedup_table
+{
+public:
+    struct stored_data
+    {
+        /** @brief The entry which first stored this data. */
+        const archive_entry* entry;
+        /** @brief The absolute position of the stored data within the archive. */
+        std::size_t dataPos;
+        /** @brief The index of the split the data was stored in, or USHRT_MAX for the root. */
+        unsigned short splitIndex;
+        /**
+            @brief Whether other entries may point to this data. False for data which
+            is modified in-place when loaded (e.g. BINA data, which games fix up).
+        */
+        bool isShareable;
+    };
+
+private:
+    std::unordered_multimap<u64, stored_data> m_storedData;
+    duplicate_file_info* m_dupInfo;
+
+public:
+    /**
+        @brief Constructs a dedup table which reports duplicates to the given duplicate file info.
+        @param[out] dupInfo     Where to report duplicates, or null to disable deduplication.
+    */
+    inline in_data_dedup_table(duplicate_file_info* dupInfo) noexcept :
+        m_dupInfo(dupInfo) {}
+
+    inline bool enabled() const noexcept
+    {
+        return (m_dupInfo != nullptr);
+    }
+
+    /**
+        @brief Searches for data that is identical to the given entry's data,
+        and remembers the given entry's data if no such data was stored yet.
+
+        @param[in] entry        The entry whose data is about to be stored.
+        @param[in] data         A pointer to the entry's data.
+        @param[in] dataPos      Where the entry's data will be stored if it is not a duplicate.
+        @param[in] splitIndex   The split the entry's data will be stored in if it is not a duplicate.
+        @param[in] isShareable  Whether other entries may point to the entry's data.
+
+        @return The earlier copy of identical data (preferring one stored within the
+        same split which can be shared with the given entry's data), or null if the
+        given entry's data is unique. Before pointing the given entry to the returned
+        data, check that both are shareable.
+    */
+    const stored_data* find_or_add(const archive_entry& entry,
+        const void* data, std::size_t dataPos,
+        unsigned short splitIndex = USHRT_MAX,
+        bool isShareable = true);
+
+    /**
+        @brief Reports the given entry as a duplicate of the given earlier copy of its data.
+
+        @param[in] entry        The duplicate entry.
+        @param[in] original     The earlier copy of the entry's data, as returned by find_or_add.
+        @param[in] isShared     Whether the duplicate entry points to the earlier copy of the data.
+    */
+    void add_duplicate(const archive_entry& entry,
+        const stored_data& original, bool isShared);
+};
+} // hl
+#endif
@@ -1,9 +1,12 @@
 #include "../hl_in_blob.h"
+#include "../hl_in_parallel.h"
+#include "hl_in_archive.h"
 #include "hedgelib/archives/hl_pacx.h"
 #include "hedgelib/effects/hl_grif.h"
 #include "hedgelib/io/hl_mem_stream.h"
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_path.h"
+#include "hedgelib/hl_trace.h"
 #include <cstring>
 #include <iterator>
 #include <random>
@@ -617,6 +620,8 @@ const bina::v2::raw_block_header* header::get_block(
 
 void header::fix()
 {
+    HL_TRACE_ZONE("pacx::v2::fix");
+
     // Swap header if necessary.
     if (bina::needs_swap(endian_flag()))
     {
@@ -643,6 +648,8 @@ void header::fix()
 
 void header::parse(archive_entry_list& hlArc, bool skipProxies) const
 {
+    HL_TRACE_ZONE("pacx::v2::parse");
+
     // Get data block, if any.
     // NOTE: Some .pac files in LW actually don't have DATA blocks (e.g. w1a03_far.pac).
     const block_data_header* dataBlock = get_data_block();
@@ -750,6 +757,8 @@ static void in_load(blob& pac, const nchar* filePath,
 void load(const nchar* filePath, archive_entry_list* hlArc,
     std::vector<blob>* pacs)
 {
+    HL_TRACE_ZONE("pacx::v2::load");
+
     // Load data into blob.
     blob pac(filePath);
 
@@ -1432,6 +1441,8 @@ static const void* in_file_data_merge(void* data, std::size_t dataSize,
     std::size_t dstDataPos, bina::endian_flag endianFlag,
     str_table& strTable, off_table& offTable, u32& dstDataSize)
 {
+    HL_TRACE_ZONE("pacx::v2::merge");
+
     // Merge BINAV2 data.
     if (dataSize >= sizeof(bina::v2::raw_header) && bina::has_v2_header(data))
     {
@@ -1497,14 +1508,138 @@ static const void* in_file_data_merge(void* data, std::size_t dataSize,
     return data;
 }
 
+struct in_merged_file_data
+{
+    /** @brief A fixed-up copy of the file's data. */
+    unique_buffer dataBuf;
+    /** @brief The data to be written to the pac file, which points somewhere within dataBuf. */
+    u8* data = nullptr;
+    /** @brief The size of the data to be written to the pac file. */
+    u32 dataSize = 0;
+    /** @brief The strings referenced by data, with positions relative to data. */
+    str_table strTable;
+    /** @brief The positions of the offsets within data, relative to data. */
+    off_table offTable;
+
+    void merge(const in_file_metadata& file, bina::endian_flag endianFlag)
+    {
+        // Make a copy of the file's data so we can safely operate on it.
+        const std::size_t fileSize = file.entry->size();
+        if (file.entry->is_reference_file())
+        {
+            dataBuf = file::load(file.entry->path());
+        }
+        else
+        {
+            dataBuf = make_unique_buffer(fileSize, memory_subsystem::archive);
+            std::memcpy(dataBuf.get(), file.entry->file_data(), fileSize);
+        }
+
+        // Merge data as though it was going to be written at position 0.
+        // (NOTE: relocate() will move it to its actual position once that's known.)
+        dataSize = static_cast<u32>(fileSize);
+        data = static_cast<u8*>(const_cast<void*>(in_file_data_merge(
+            dataBuf.get(), fileSize, 0, endianFlag,
+            strTable, offTable, dataSize)));
+    }
+
+    void relocate(std::size_t dataPos, bina::endian_flag endianFlag,
+        str_table& dstStrTable, off_table& dstOffTable)
+    {
+        // Fix offsets and add them to the destination offset table.
+        for (const std::size_t relOffPos : offTable)
+        {
+            u32* curOff = ptradd<u32>(data, relOffPos);
+            u32 offVal = *curOff;
+
+            if (bina::needs_swap(endianFlag))
+            {
+                endian_swap(offVal);
+            }
+
+            offVal = static_cast<u32>(offVal + dataPos);
+
+            if (bina::needs_swap(endianFlag))
+            {
+                endian_swap(offVal);
+            }
+
+            *curOff = offVal;
+            dstOffTable.push_back(dataPos + relOffPos);
+        }
+
+        // Add strings to the destination string table.
+        for (auto& strEntry : strTable)
+        {
+            dstStrTable.emplace_back(std::move(strEntry.str),
+                dataPos + strEntry.offPos);
+        }
+    }
+};
+
+/**
+    @brief The (approximate) maximum amount of file data to merge in parallel at once,
+    so the memory used while writing a data block doesn't grow with its size.
+*/
+constexpr std::size_t in_max_merge_batch_size = (64 * 1024 * 1024);
+
+/**
+    @brief Fixes-up and merges the data of the next batch of the given files in parallel.
+    @return The index of the first file after the batch.
+*/
+static std::size_t in_merge_batch(
+    const std::vector<const in_file_metadata*>& filesToMerge,
+    std::size_t first, bina::endian_flag endianFlag,
+    std::vector<in_merged_file_data>& mergedData)
+{
+    // Determine which files to merge within this batch (always at least one).
+    std::size_t last = first, batchSize = 0;
+    do
+    {
+        batchSize += filesToMerge[last++]->entry->size();
+    }
+    while (last < filesToMerge.size() && batchSize < in_max_merge_batch_size);
+
+    // Free the previous batch, and merge this one.
+    mergedData.clear();
+    mergedData.resize(last - first);
+
+    in_parallel_for(mergedData.size(), [&](std::size_t i)
+    {
+        mergedData[i].merge(*filesToMerge[first + i], endianFlag);
+    });
+
+    return last;
+}
+
+static bool in_data_is_here(const in_file_metadata& file,
+    bool isRoot, u32 splitLimit)
+{
+    // TODO: Let user optionally write mixed types to root.
+
+    /*
+       The data is "here" (not a proxy entry) if:
+
+       1: This is a split (since we skip all files not part of a split when writing it).
+        OR
+       2: This is a root without a split limit (meaning split generation is disabled).
+        OR
+       3: This is a root, and we're writing a root-type file.
+    */
+    return (!isRoot || !splitLimit || file.pacxExt->is_root_type());
+}
+
 static void in_data_entry_write(const in_file_metadata& file,
     bool isHere, bina::endian_flag endianFlag, packed_file_info* pfi,
+    in_data_dedup_table& dedupTable, in_merged_file_data* mergedData,
     str_table& strTable, off_table& offTable, stream& stream)
 {
     // Generate data entry.
     data_entry dataEntry =
     {
-        static_cast<u32>(file.entry->size()),   // dataSize
+        (mergedData) ? mergedData->dataSize :   // dataSize
+            static_cast<u32>(file.entry->size()),
+
         0,                                      // dataPtr
         0,                                      // unknown1
         static_cast<u8>((isHere) ?              // flags
@@ -1517,10 +1652,10 @@ static void in_data_entry_write(const in_file_metadata& file,
     const std::size_t dataPos = (stream.tell() + sizeof(dataEntry));
 
     // Get/Load entry data if necessary.
-    std::unique_ptr<u8[]> tmpDataBuf;
+    unique_buffer tmpDataBuf;
     const void* data = nullptr;
 
-    if (isHere)
+    if (isHere && (!mergedData || dedupTable.enabled()))
     {
         // If this is a file reference, load up the file's data.
         if (file.entry->is_reference_file())
@@ -1535,23 +1670,27 @@ static void in_data_entry_write(const in_file_metadata& file,
             data = file.entry->file_data();
         }
 
-        // Merge data if necessary.
-        if (file.pacxExt->kind == supported_ext_kind::v2_merged)
+        // Report duplicate file data if requested.
+        // (NOTE: v2 data is always stored directly after its data entry, so it can't be shared.)
+        if (dedupTable.enabled())
         {
-            // Create a copy of this data if necessary so we can safely operate on it.
-            if (!tmpDataBuf)
+            const auto original = dedupTable.find_or_add(
+                *file.entry, data, dataPos, file.splitIndex);
+
+            if (original)
             {
-                tmpDataBuf = std::unique_ptr<u8[]>(new u8[file.entry->size()]);
-                std::memcpy(tmpDataBuf.get(), data, file.entry->size());
-                data = tmpDataBuf.get();
+                dedupTable.add_duplicate(*file.entry, *original, false);
             }
-
-            // Merge data.
-            data = in_file_data_merge(tmpDataBuf.get(), file.entry->size(),
-                dataPos, endianFlag, strTable, offTable, dataEntry.dataSize);
         }
     }
 
+    // Move merged data to its final position if necessary.
+    if (mergedData)
+    {
+        mergedData->relocate(dataPos, endianFlag, strTable, offTable);
+        data = mergedData->data;
+    }
+
     // Endian-swap data entry if necessary.
     const u32 dataSizeCopy = dataEntry.dataSize;
     if (bina::needs_swap(endianFlag))
@@ -1704,8 +1843,10 @@ static void in_data_block_write(unsigned short splitIndex,
     const in_type_metadata_list& typeMetadata, u32 splitLimit,
     u32 dataAlignment, bina::endian_flag endianFlag,
     const in_dep_metadata_list& deps, packed_file_info* pfi,
-    stream& stream)
+    in_data_dedup_table& dedupTable, stream& stream)
 {
+    HL_TRACE_ZONE("pacx::v2::write_data_block");
+
     str_table strTable;
     off_table offTable;
     const bool isRoot = (splitIndex == USHRT_MAX);
@@ -1755,6 +1896,35 @@ static void in_data_block_write(unsigned short splitIndex,
             endianFlag, offTable, stream);
     }
 
+    // Gather the files within this data block whose data needs to be merged.
+    std::vector<const in_file_metadata*> filesToMerge;
+    for (const auto& type : typeMetadata)
+    {
+        if (!isRoot && type.pacx_ext()->is_root_type())
+        {
+            continue;
+        }
+
+        for (const auto& file : type)
+        {
+            if ((!isRoot && file.splitIndex != splitIndex) || !file.entry ||
+                file.pacxExt->kind != supported_ext_kind::v2_merged ||
+                !in_data_is_here(file, isRoot, splitLimit))
+            {
+                continue;
+            }
+
+            filesToMerge.push_back(&file);
+        }
+    }
+
+    // NOTE: The data of these files is fixed-up and merged in parallel, in batches
+    // which are merged as they're needed below. Each file is merged into its own
+    // tables; the results are then added to the final tables in order as each file
+    // is written, so the output is identical to merging everything serially.
+    std::vector<in_merged_file_data> mergedData;
+    std::size_t mergedDataIndex = 0, mergedBatchFirst = 0, mergedBatchLast = 0;
+
     // Write data entries and fill-in file dictionary nodes.
     str_table tmpMergedStrTable;
     const std::size_t dataEntriesPos = stream.tell();
@@ -1811,22 +1981,32 @@ static void in_data_block_write(unsigned short splitIndex,
             // Write data entry.
             if (file.entry)
             {
-                // TODO: Let user optionally write mixed types to root.
+                const bool isHere = in_data_is_here(file, isRoot, splitLimit);
+                in_merged_file_data* curMergedData = nullptr;
 
-                /*
-                   The data is "here" (not a proxy entry) if:
+                if (mergedDataIndex < filesToMerge.size() &&
+                    filesToMerge[mergedDataIndex] == &file)
+                {
+                    // Merge the next batch of files if necessary.
+                    if (mergedDataIndex == mergedBatchLast)
+                    {
+                        mergedBatchFirst = mergedDataIndex;
+                        mergedBatchLast = in_merge_batch(filesToMerge,
+                            mergedBatchFirst, endianFlag, mergedData);
+                    }
 
-                   1: This is a split (since we skipped all files not part of this split earlier).
-                    OR
-                   2: This is a root without a split limit (meaning split generation is disabled).
-                    OR
-                   3: This is a root, and we're writing a root-type file.
-                */
-                const bool isHere = (!isRoot || !splitLimit ||
-                    file.pacxExt->is_root_type());
+                    curMergedData = &mergedData[mergedDataIndex++ - mergedBatchFirst];
+                }
 
                 in_data_entry_write(file, isHere, endianFlag, pfi,
-                    tmpMergedStrTable, offTable, stream);
+                    dedupTable, curMergedData, tmpMergedStrTable,
+                    offTable, stream);
+
+                // Free merged data as soon as it has been written.
+                if (curMergedData)
+                {
+                    curMergedData->dataBuf.reset();
+                }
 
                 if (!isHere) ++proxyEntryCount;
             }
@@ -1892,7 +2072,8 @@ static void in_data_block_write(unsigned short splitIndex,
 static void in_save_splits(const nchar* filePath,
     unsigned short splitCount, const in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
-    in_dep_metadata_list& deps, packed_file_info* pfi)
+    in_dep_metadata_list& deps, packed_file_info* pfi,
+    in_data_dedup_table& dedupTable)
 {
     // Reserve space in advance for dependency metadata.
     deps.reserve(splitCount);
@@ -1916,7 +2097,7 @@ static void in_save_splits(const nchar* filePath,
         // Write split data block.
         in_data_block_write(splitIndex, typeMetadata,
             splitLimit, dataAlignment, endianFlag,
-            deps, pfi, splitFile);
+            deps, pfi, dedupTable, splitFile);
 
         // Finish writing split header.
         header::finish_write(0, 1, endianFlag, splitFile);
@@ -1936,8 +2117,11 @@ static void in_save_splits(const nchar* filePath,
 void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit,
-    u32 dataAlignment, packed_file_info* pfi)
+    u32 dataAlignment, packed_file_info* pfi,
+    duplicate_file_info* dupInfo)
 {
+    HL_TRACE_ZONE("pacx::v2::save");
+
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
     {
@@ -1952,6 +2136,8 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
     if (!arc.empty())
     {
+        HL_TRACE_ZONE("pacx::v2::generate_metadata");
+
         // Reserve space in advance for file metadata.
         fileMetadata.reserve(arc.size() + 1);
 
@@ -2064,6 +2250,8 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
     // Save splits if necessary.
     in_dep_metadata_list deps;
+    in_data_dedup_table dedupTable(dupInfo);
+
     if (splitCount)
     {
         // Disable PFI generation.
@@ -2071,7 +2259,8 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
         // Save splits.
         in_save_splits(filePath, splitCount, typeMetadata,
-            splitLimit, dataAlignment, endianFlag, deps, pfi);
+            splitLimit, dataAlignment, endianFlag, deps, pfi,
+            dedupTable);
     }
 
     // Open root file and start writing header.
@@ -2083,7 +2272,7 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     {
         in_data_block_write(USHRT_MAX, typeMetadata,
             splitLimit, dataAlignment, endianFlag,
-            deps, pfi, rootFile);
+            deps, pfi, dedupTable, rootFile);
     }
 
     // Finish writing root header.
@@ -2145,6 +2334,8 @@ static void in_swap_recursive(header& header)
 
 void header::fix()
 {
+    HL_TRACE_ZONE("pacx::v3::fix");
+
     // Swap header if necessary.
     if (bina::needs_swap(endian_flag()))
     {
@@ -2221,6 +2412,8 @@ static void in_parse(const file_node* fileNodes,
 
 void header::parse(archive_entry_list& hlArc, bool skipProxies) const
 {
+    HL_TRACE_ZONE("pacx::v3::parse");
+
     // NOTE: PACxV3 names are hard-limited to 255, not including null terminator.
     char pathBuf[256];
 
@@ -2238,6 +2431,186 @@ void header::parse(archive_entry_list& hlArc, bool skipProxies) const
     }
 }
 
+static data_view in_view_get_node_data(const data_view& nodes,
+    const data_view& node)
+{
+    // Return this node's data if it has any.
+    if (node.read<u8>(offsetof(type_node, hasData)))
+    {
+        return node.deref64(offsetof(type_node, data));
+    }
+
+    // Otherwise, return the data of its data node, if any.
+    const u16 childCount = node.read<u16>(offsetof(type_node, childCount));
+    const data_view childIndices = node.deref64(offsetof(type_node, childIndices));
+
+    for (u16 i = 0; i < childCount; ++i)
+    {
+        const data_view child = nodes.at(sizeof(type_node) *
+            childIndices.read<s32>(sizeof(s32) * i));
+
+        if (child.read<u8>(offsetof(type_node, hasData)))
+        {
+            return child.deref64(offsetof(type_node, data));
+        }
+    }
+
+    return data_view();
+}
+
+static data_view in_view_find_node_data(const data_view& tree, const char* name)
+{
+    // NOTE: The first node is always the root node, so we start from there.
+    const data_view nodes = tree.deref64(offsetof(type_tree, nodes));
+    if (!nodes || tree.read<u32>(offsetof(type_tree, nodeCount)) == 0)
+    {
+        return data_view();
+    }
+
+    data_view curNode = nodes;
+    while (true)
+    {
+        const u16 childCount = curNode.read<u16>(offsetof(type_node, childCount));
+        const data_view childIndices = curNode.deref64(offsetof(type_node, childIndices));
+        bool foundChild = false;
+
+        for (u16 i = 0; i < childCount; ++i)
+        {
+            // Skip nodes without a name.
+            const data_view child = nodes.at(sizeof(type_node) *
+                childIndices.read<s32>(sizeof(s32) * i));
+
+            const char* childName = child.str64(offsetof(type_node, name));
+            if (!childName) continue;
+
+            // Skip nodes whose names don't match.
+            const std::size_t childNameLen = text::len(childName);
+            if (std::strncmp(name, childName, childNameLen) != 0) continue;
+
+            // If the name *entirely* matched, return the node's data.
+            name += childNameLen;
+            if (*name == '\0') return in_view_get_node_data(nodes, child);
+
+            // Otherwise, search through this node's children instead.
+            curNode = child;
+            foundChild = true;
+            break;
+        }
+
+        if (!foundChild) return data_view();
+    }
+}
+
+data_entry_view header_view::find_file(const char* typeName,
+    const char* fileName) const
+{
+    // Find the file tree for the given type.
+    const data_view fileTree = in_view_find_node_data(
+        m_header.at(sizeof(header)), typeName);
+
+    if (!fileTree) return data_entry_view();
+
+    // Find the data entry for the given file.
+    return in_view_find_node_data(fileTree, fileName);
+}
+
+static void in_view_parse(const data_view& fileNodes,
+    const data_view& curFileNode, bool skipProxies,
+    char* pathBuf, archive_entry_list& hlArc)
+{
+    const u8 bufStartIndex = curFileNode.read<u8>(
+        offsetof(file_node, bufStartIndex));
+
+    if (curFileNode.read<u8>(offsetof(file_node, hasData)))
+    {
+        // If this is not a proxy entry (or we're not skipping proxies), parse data.
+        const data_entry_view dataEntry = curFileNode.deref64(
+            offsetof(file_node, data));
+
+        if (!skipProxies || !dataEntry.is_proxy_entry())
+        {
+            // Ensure node name length is > 0.
+            if (!bufStartIndex)
+            {
+                throw invalid_data_exception();
+            }
+
+            // Create file name.
+            std::string fileName(pathBuf, bufStartIndex);
+
+            // Add extension if file has an extension which is not empty.
+            const char* ext = dataEntry.ext();
+            if (ext && *ext != '\0')
+            {
+                fileName += '.';
+                fileName += ext;
+            }
+
+            // Add streaming files.
+            if (dataEntry.is_proxy_entry())
+            {
+                hlArc.emplace_back(archive_entry::make_streaming_file_utf8(
+                    fileName, dataEntry.data_size()));
+            }
+
+            // Add regular files.
+            else
+            {
+                hlArc.add_file_utf8(fileName, dataEntry.data_size(),
+                    dataEntry.data());
+            }
+        }
+    }
+    else
+    {
+        // Copy name into path buffer.
+        const char* name = curFileNode.str64(offsetof(file_node, name));
+        if (name)
+        {
+            std::strcpy(&pathBuf[bufStartIndex], name);
+        }
+    }
+
+    // Recurse through children.
+    const u16 childCount = curFileNode.read<u16>(offsetof(file_node, childCount));
+    const data_view childIndices = curFileNode.deref64(offsetof(file_node, childIndices));
+
+    for (u16 i = 0; i < childCount; ++i)
+    {
+        in_view_parse(fileNodes, fileNodes.at(sizeof(file_node) *
+            childIndices.read<s32>(sizeof(s32) * i)),
+            skipProxies, pathBuf, hlArc);
+    }
+}
+
+void header_view::parse(archive_entry_list& hlArc, bool skipProxies) const
+{
+    HL_TRACE_ZONE("pacx::v3::parse (view)");
+
+    // NOTE: PACxV3 names are hard-limited to 255, not including null terminator.
+    char pathBuf[256];
+
+    // Parse archive entries.
+    const data_view typeTree = m_header.at(sizeof(header));
+    const data_view typeNodes = typeTree.deref64(offsetof(type_tree, nodes));
+    const data_view dataNodeIndices = typeTree.deref64(
+        offsetof(type_tree, dataNodeIndices));
+
+    const u32 dataNodeCount = typeTree.read<u32>(offsetof(type_tree, dataNodeCount));
+    for (u32 i = 0; i < dataNodeCount; ++i)
+    {
+        // Get views.
+        const data_view typeNode = typeNodes.at(sizeof(type_node) *
+            dataNodeIndices.read<s32>(sizeof(s32) * i));
+
+        const data_view fileTree = typeNode.deref64(offsetof(type_node, data));
+        const data_view fileNodes = fileTree.deref64(offsetof(file_tree, nodes));
+
+        // Parse archive entries.
+        in_view_parse(fileNodes, fileNodes, skipProxies, pathBuf, hlArc);
+    }
+}
+
 static u16 in_get_flags(compress_type compressType) noexcept
 {
     switch (compressType)
@@ -2427,6 +2800,8 @@ static void in_load(blob& pac, const nchar* filePath,
 void load(const nchar* filePath, archive_entry_list* hlArc,
     std::vector<blob>* pacs)
 {
+    HL_TRACE_ZONE("pacx::v3::load");
+
     // Load data into blob.
     blob pac(filePath);
 
@@ -3418,17 +3793,15 @@ static void in_data_entry_fill_in(const in_file_metadata& file,
 static void in_file_data_write(const in_radix_node<const in_file_metadata>& fileNode,
     std::size_t& dataEntryPos, unsigned short splitIndex,
     bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    packed_file_info* pfi, in_data_dedup_table* dedupTable,
+    off_table& offTable, stream& metaStream, stream& dataStream)
 {
     if (fileNode.data)
     {
         if (fileNode.data->splitIndex == splitIndex)
         {
-            // Pad data to requested data alignment.
-            stream.pad(dataAlignment);
-
             // Get/Load entry data as necessary.
-            std::unique_ptr<u8[]> tmpDataBuf;
+            unique_buffer tmpDataBuf;
             const void* data;
 
             // If this is a file reference, load up the file's data.
@@ -3454,9 +3827,46 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
                 flags |= data_flags::bina_file;
             }
 
-            // Write data, then free it as necessary.
-            const std::size_t fileDataPos = stream.tell();
-            stream.write_all(file.entry->size(), data);
+            // Check for identical data stored earlier if requested.
+            // (NOTE: BINA data is fixed-up in-place by the game, so it's never shared.)
+            const bool isShareable = ((flags & data_flags::bina_file) ==
+                data_flags::regular_file);
+
+            const in_data_dedup_table::stored_data* original = nullptr;
+            if (dedupTable && dedupTable->enabled())
+            {
+                original = dedupTable->find_or_add(*file.entry, data,
+                    align(dataStream.tell(), dataAlignment), splitIndex, isShareable);
+            }
+
+            // Point to identical data stored earlier within this pac if possible.
+            // (NOTE: Both this data and the earlier copy must be shareable, as a
+            // regular file pointing to BINA data would see the game's fix-ups.)
+            std::size_t fileDataPos;
+            if (original && original->splitIndex == splitIndex &&
+                isShareable && original->isShareable)
+            {
+                fileDataPos = original->dataPos;
+                dedupTable->add_duplicate(*file.entry, *original, true);
+            }
+
+            // Otherwise, write data.
+            else
+            {
+                if (original)
+                {
+                    dedupTable->add_duplicate(*file.entry, *original, false);
+                }
+
+                // Pad data to requested data alignment.
+                dataStream.pad(dataAlignment);
+
+                // Write data.
+                fileDataPos = dataStream.tell();
+                dataStream.write_all(file.entry->size(), data);
+            }
+
+            // Free data as necessary.
             tmpDataBuf.reset();
 
             // Add packed file entry to packed file info if necessary.
@@ -3468,7 +3878,7 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
 
             // Fill-in data entry.
             in_data_entry_fill_in(file, dataEntryPos, fileDataPos,
-                static_cast<u64>(flags), endianFlag, offTable, stream);
+                static_cast<u64>(flags), endianFlag, offTable, metaStream);
         }
 
         // Increase current offset position to account for data entry.
@@ -3479,61 +3889,78 @@ static void in_file_data_write(const in_radix_node<const in_file_metadata>& file
     for (const auto& child : fileNode.children)
     {
         in_file_data_write(*child.get(), dataEntryPos, splitIndex,
-            endianFlag, dataAlignment, pfi, offTable, stream);
+            endianFlag, dataAlignment, pfi, dedupTable, offTable,
+            metaStream, dataStream);
     }
 }
 
 static void in_file_data_write(const in_radix_tree<const in_file_metadata>& fileTree,
     std::size_t& dataEntryPos, unsigned short splitIndex,
     bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    packed_file_info* pfi, in_data_dedup_table* dedupTable,
+    off_table& offTable, stream& metaStream, stream& dataStream)
 {
+    HL_TRACE_ZONE("pacx::v3::write_file_data");
+
     in_file_data_write(fileTree.rootNode, dataEntryPos, splitIndex,
-        endianFlag, dataAlignment, pfi, offTable, stream);
+        endianFlag, dataAlignment, pfi, dedupTable, offTable,
+        metaStream, dataStream);
 }
 
 static void in_file_data_write(const in_radix_node<in_type_tree_metadata>& typeNode,
     std::size_t& dataEntryPos, unsigned short splitIndex,
     bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    packed_file_info* pfi, in_data_dedup_table* dedupTable,
+    off_table& offTable, stream& metaStream, stream& dataStream)
 {
     if (typeNode.data)
     {
         in_file_data_write(typeNode.data->fileTree, dataEntryPos, splitIndex,
-            endianFlag, dataAlignment, pfi, offTable, stream);
+            endianFlag, dataAlignment, pfi, dedupTable, offTable,
+            metaStream, dataStream);
     }
 
     // Recurse through child nodes.
     for (const auto& child : typeNode.children)
     {
         in_file_data_write(*child.get(), dataEntryPos, splitIndex,
-            endianFlag, dataAlignment, pfi, offTable, stream);
+            endianFlag, dataAlignment, pfi, dedupTable, offTable,
+            metaStream, dataStream);
     }
 }
 
 static void in_file_data_write(const in_radix_tree<in_type_tree_metadata>& typeTree,
     std::size_t& dataEntryPos, unsigned short splitIndex,
     bina::endian_flag endianFlag, u32 dataAlignment,
-    packed_file_info* pfi, off_table& offTable, stream& stream)
+    packed_file_info* pfi, in_data_dedup_table* dedupTable,
+    off_table& offTable, stream& metaStream, stream& dataStream)
 {
     in_file_data_write(typeTree.rootNode, dataEntryPos, splitIndex,
-        endianFlag, dataAlignment, pfi, offTable, stream);
+        endianFlag, dataAlignment, pfi, dedupTable, offTable,
+        metaStream, dataStream);
 }
 
+struct in_metadata_layout
+{
+    std::size_t treesPos;
+    std::size_t depTablePos;
+    std::size_t dataEntriesPos;
+    std::size_t strTablePos;
+};
+
 template<typename dep_list_t>
-std::size_t in_write(const bina::ver version, unsigned short splitIndex,
-    u32 uid, const in_type_metadata_list& typeMetadata,
-    u32 splitLimit, u32 dataAlignment, bool hasUnknownFlag,
-    compress_type compressType, u32 maxChunkSize,
+static in_metadata_layout in_metadata_write(const bina::ver version,
+    unsigned short splitIndex, u32 uid,
+    const in_type_metadata_list& typeMetadata, u32 splitLimit,
+    bool hasUnknownFlag, compress_type compressType, u32 maxChunkSize,
     bina::endian_flag endianFlag, dep_list_t& deps,
-    packed_file_info* pfi, stream& stream)
+    in_radix_tree<in_type_tree_metadata>& typeTree,
+    off_table& offTable, stream& stream)
 {
     str_table strTable;
-    off_table offTable;
     const bool isRoot = (splitIndex == USHRT_MAX);
 
     // Generate radix trees and determine pac type.
-    in_radix_tree<in_type_tree_metadata> typeTree;
     pac_type pacType = (isRoot) ? pac_type::is_root :
         pac_type::is_split;
 
@@ -3583,24 +4010,25 @@ std::size_t in_write(const bina::ver version, unsigned short splitIndex,
         compressType, endianFlag, stream);
 
     // Write node trees and placeholder nodes (and get type data node indices).
-    const std::size_t treesPos = stream.tell();
-    std::size_t curOffPos = (treesPos + sizeof(type_tree));
+    in_metadata_layout layout;
+    layout.treesPos = stream.tell();
+    std::size_t curOffPos = (layout.treesPos + sizeof(type_tree));
 
     std::unique_ptr<s32[]> typeDataNodeIndices = in_tree_write(
         typeTree, curOffPos, endianFlag, strTable, offTable, stream);
 
     // Write data node indices and fill-in trees.
-    curOffPos = treesPos;
+    curOffPos = layout.treesPos;
     in_data_node_indices_fill_in(typeTree, typeDataNodeIndices.get(),
         endianFlag, curOffPos, offTable, stream);
 
     // Write child node indices and fill-in nodes.
-    curOffPos = (treesPos + sizeof(type_tree));
+    curOffPos = (layout.treesPos + sizeof(type_tree));
     in_child_node_indices_fill_in(typeTree,
         endianFlag, curOffPos, offTable, stream);
 
     // Write dependency table if necessary.
-    const std::size_t depTablePos = stream.tell();
+    layout.depTablePos = stream.tell();
     if (isRoot && !deps.empty())
     {
         deps.write(compressType, maxChunkSize,
@@ -3608,33 +4036,135 @@ std::size_t in_write(const bina::ver version, unsigned short splitIndex,
     }
 
     // Write placeholder data entries and fill-in file nodes.
-    const std::size_t dataEntriesPos = stream.tell();
+    layout.dataEntriesPos = stream.tell();
     in_data_entries_write(typeTree, splitIndex, version, uid,
         endianFlag, curOffPos, strTable, offTable, stream);
 
     // Write string table.
-    const std::size_t strTablePos = stream.tell();
+    layout.strTablePos = stream.tell();
     bina::strings_write64(0, endianFlag, strTable, offTable, stream);
 
+    return layout;
+}
+
+template<typename dep_list_t>
+std::size_t in_write(const bina::ver version, unsigned short splitIndex,
+    u32 uid, const in_type_metadata_list& typeMetadata,
+    u32 splitLimit, u32 dataAlignment, bool hasUnknownFlag,
+    compress_type compressType, u32 maxChunkSize,
+    bina::endian_flag endianFlag, dep_list_t& deps,
+    packed_file_info* pfi, in_data_dedup_table* dedupTable,
+    stream& stream)
+{
+    HL_TRACE_ZONE("pacx::v3::write");
+
+    off_table offTable;
+    in_radix_tree<in_type_tree_metadata> typeTree;
+
+    // Write everything up to the file data.
+    const in_metadata_layout layout = in_metadata_write(version,
+        splitIndex, uid, typeMetadata, splitLimit, hasUnknownFlag,
+        compressType, maxChunkSize, endianFlag, deps, typeTree,
+        offTable, stream);
+
     // Write file data and fill-in data entries.
     const std::size_t fileDataPos = stream.tell();
-    curOffPos = dataEntriesPos;
+    std::size_t curOffPos = layout.dataEntriesPos;
 
-    in_file_data_write(typeTree, curOffPos, splitIndex,
-        endianFlag, dataAlignment, pfi, offTable, stream);
+    in_file_data_write(typeTree, curOffPos, splitIndex, endianFlag,
+        dataAlignment, pfi, dedupTable, offTable, stream, stream);
 
     // Finish writing PACx data.
-    header::finish_write(0, treesPos, depTablePos, dataEntriesPos,
-        strTablePos, fileDataPos, (isRoot) ? static_cast<u32>(
-        deps.size()) : 0, endianFlag, offTable, stream);
+    header::finish_write(0, layout.treesPos, layout.depTablePos,
+        layout.dataEntriesPos, layout.strTablePos, fileDataPos,
+        (splitIndex == USHRT_MAX) ? static_cast<u32>(deps.size()) : 0,
+        endianFlag, offTable, stream);
+
+    return layout.depTablePos;
+}
+
+static std::size_t in_estimate_metadata_size(unsigned short splitIndex,
+    const in_type_metadata_list& typeMetadata)
+{
+    // Account for header, type tree, and dependency table.
+    const bool isRoot = (splitIndex == USHRT_MAX);
+    std::size_t size = (sizeof(header) + sizeof(type_tree) + 1024);
+
+    for (const auto& type : typeMetadata)
+    {
+        // Account for type nodes and file tree.
+        size += ((sizeof(type_node) * 2) + sizeof(file_tree) + 32);
+
+        for (const auto& file : type)
+        {
+            if (!isRoot && file.splitIndex != splitIndex) continue;
+
+            // Account for file nodes, child/data node indices, data entry, and name.
+            size += ((sizeof(file_node) * 2) + 16 +
+                sizeof(data_entry) + file.utf8_name_len() + 1);
+        }
+    }
+
+    return size;
+}
+
+static void in_save(const nchar* filePath, unsigned short splitIndex,
+    u32 uid, const in_type_metadata_list& typeMetadata, u32 splitLimit,
+    u32 dataAlignment, bina::endian_flag endianFlag,
+    const in_dep_metadata_list& deps, packed_file_info* pfi,
+    in_data_dedup_table& dedupTable)
+{
+    HL_TRACE_ZONE("pacx::v3::write");
+
+    // Write everything up to the file data to memory first, as the writer
+    // jumps back and forth quite a bit to fill-in offsets, indices, and
+    // sizes, which would be slow to do directly on an (unbuffered) file stream.
+    mem_stream metadata(in_estimate_metadata_size(splitIndex, typeMetadata));
+    off_table offTable;
+    in_radix_tree<in_type_tree_metadata> typeTree;
+
+    const in_metadata_layout layout = in_metadata_write(ver_301,
+        splitIndex, uid, typeMetadata, splitLimit, false,
+        compress_type::none, 0, endianFlag, deps, typeTree,
+        offTable, metadata);
+
+    // Reserve space for the metadata within the file.
+    file_stream file(filePath, file::mode::write);
+    const std::size_t fileDataPos = metadata.tell();
+    file.write_nulls(fileDataPos);
+
+    // Write file data straight to the file, so that large pacs don't need
+    // to fit in memory, and fill-in data entries within the metadata.
+    // (NOTE: This works since the metadata's positions match the file's.)
+    std::size_t curOffPos = layout.dataEntriesPos;
+    in_file_data_write(typeTree, curOffPos, splitIndex, endianFlag,
+        dataAlignment, pfi, &dedupTable, offTable, metadata, file);
 
-    return depTablePos;
+    // Write offset table.
+    file.pad(8);
+
+    const std::size_t offTablePos = file.tell();
+    bina::offsets_write(0, offTable, file);
+    file.pad(8);
+
+    // Write the finished metadata over the space we reserved for it.
+    const std::size_t endPos = file.tell();
+    file.jump_to(0);
+    file.write_all(metadata.get_size(), metadata.get_data_ptr());
+    file.jump_to(endPos);
+
+    // Fill-in header values.
+    header::finish_write(0, layout.treesPos, layout.depTablePos,
+        layout.dataEntriesPos, layout.strTablePos, fileDataPos,
+        offTablePos, (splitIndex == USHRT_MAX) ? static_cast<u32>(
+        deps.size()) : 0, endianFlag, file);
 }
 
 static void in_save_splits(const nchar* filePath, u32 uid,
     unsigned short splitCount, const in_type_metadata_list& typeMetadata,
     u32 splitLimit, u32 dataAlignment, bina::endian_flag endianFlag,
-    in_dep_metadata_list& deps, packed_file_info* pfi)
+    in_dep_metadata_list& deps, packed_file_info* pfi,
+    in_data_dedup_table& dedupTable)
 {
     // Reserve space in advance for dependency metadata.
     deps.reserve(splitCount);
@@ -3649,13 +4179,9 @@ static void in_save_splits(const nchar* filePath, u32 uid,
 
     for (unsigned short splitIndex = 0; splitIndex < splitCount; ++splitIndex)
     {
-        // Open the next split file for writing.
-        file_stream splitFile(*splitIt, file::mode::write);
-
-        // Write split.
-        in_write(ver_301, splitIndex, uid, typeMetadata,
-            splitLimit, dataAlignment, false, compress_type::none,
-            0, endianFlag, deps, pfi, splitFile);
+        // Save split.
+        in_save(*splitIt, splitIndex, uid, typeMetadata, splitLimit,
+            dataAlignment, endianFlag, deps, pfi, dedupTable);
 
         // Generate dependency metadata.
         deps.emplace_back(text::conv<text::native_to_utf8>(splitName));
@@ -3674,6 +4200,8 @@ static bool in_generate_metadata(const archive_entry_list& arc,
     const std::size_t extCount, in_file_metadata_list& fileMetadata,
     in_type_metadata_list& typeMetadata)
 {
+    HL_TRACE_ZONE("pacx::v3::generate_metadata");
+
     // Reserve space in advance for file metadata.
     fileMetadata.reserve(arc.size());
 
@@ -3777,8 +4305,10 @@ static bool in_generate_metadata(const archive_entry_list& arc,
 void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
     const supported_ext* exts, const std::size_t extCount,
     const nchar* filePath, u32 splitLimit, u32 dataAlignment,
-    packed_file_info* pfi)
+    packed_file_info* pfi, duplicate_file_info* dupInfo)
 {
+    HL_TRACE_ZONE("pacx::v3::save");
+
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
     {
@@ -3808,6 +4338,8 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
     // Save splits if necessary.
     in_dep_metadata_list deps;
+    in_data_dedup_table dedupTable(dupInfo);
+
     if (splitCount)
     {
         // Disable PFI generation.
@@ -3815,14 +4347,13 @@ void save(const archive_entry_list& arc, bina::endian_flag endianFlag,
 
         // Save splits.
         in_save_splits(filePath, uid, splitCount, typeMetadata,
-            splitLimit, dataAlignment, endianFlag, deps, pfi);
+            splitLimit, dataAlignment, endianFlag, deps, pfi,
+            dedupTable);
     }
 
     // Save root.
-    file_stream rootFile(filePath, file::mode::write);
-    in_write(ver_301, USHRT_MAX, uid, typeMetadata,
-        splitLimit, dataAlignment, false, compress_type::none,
-        0, endianFlag, deps, pfi, rootFile);
+    in_save(filePath, USHRT_MAX, uid, typeMetadata, splitLimit,
+        dataAlignment, endianFlag, deps, pfi, dedupTable);
 }
 } // v3
 
@@ -3831,7 +4362,7 @@ namespace v4
 struct in_dep_metadata
 {
     std::string name;
-    std::unique_ptr<u8[]> compressedData;
+    unique_buffer compressedData;
     std::size_t compressedSize = 0;
     std::size_t uncompressedSize = 0;
     std::vector<chunk> chunks;
@@ -4203,7 +4734,7 @@ static void in_generate_split_data(bina::ver version,
     v3::in_write(version, splitIndex, uid, typeMetadata,
         splitLimit, dataAlignment, hasUnknownFlag,
         compressType, maxChunkSize, endianFlag, deps,
-        nullptr, internalFile);
+        nullptr, nullptr, internalFile);
 
     // Compress PACx data if necessary.
     const std::size_t splitUncompressedSize = internalFile.get_size();
@@ -4318,6 +4849,8 @@ namespace v02
 {
 void header::fix()
 {
+    HL_TRACE_ZONE("pacx::v4::v02::fix");
+
     // Fix root data offset.
     root.fix(this);
 
@@ -4341,6 +4874,8 @@ void header::fix()
 
 blob header::decompress_root() const
 {
+    HL_TRACE_ZONE("pacx::v4::v02::decompress_root");
+
     // Decompress root pac and return it.
     if ((flagsV3 & static_cast<u16>(
         v3::pac_flags::lz4_compressed)) != 0)
@@ -4445,6 +4980,8 @@ void header::finish_write(std::size_t headerPos,
 void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs, bool readSplits)
 {
+    HL_TRACE_ZONE("pacx::v4::v02::read");
+
     // Fix PACxV402 data.
     fix(pac);
 
@@ -4473,6 +5010,8 @@ void write(const archive_entry_list& arc,
     const std::size_t extCount, const supported_ext* exts,
     stream& stream, u32 splitLimit, u32 dataAlignment, bool noCompress)
 {
+    HL_TRACE_ZONE("pacx::v4::v02::write");
+
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
     {
@@ -4520,7 +5059,7 @@ void write(const archive_entry_list& arc,
     const std::size_t rootDepTablePos = v3::in_write(ver_402,
         USHRT_MAX, uid, typeMetadata, splitLimit, dataAlignment,
         true, compressType, maxChunkSize, endianFlag, deps,
-        nullptr, rootInternalFile);
+        nullptr, nullptr, rootInternalFile);
 
     const std::size_t rootUncompressedSize = rootInternalFile.get_size();
     rootDepInfo.uncompressedSize = rootUncompressedSize;
@@ -4736,6 +5275,8 @@ void metadata_header::finish_write(std::size_t headerPos,
 
 void header::fix()
 {
+    HL_TRACE_ZONE("pacx::v4::v03::fix");
+
     // Fix root data offset.
     root.fix(this);
 
@@ -4754,6 +5295,8 @@ void header::fix()
 
 blob header::decompress_root() const
 {
+    HL_TRACE_ZONE("pacx::v4::v03::decompress_root");
+
     // Decompress root pac and return it.
     if ((flagsV3 & static_cast<u16>(
         v3::pac_flags::lz4_compressed)) != 0)
@@ -4866,6 +5409,8 @@ void read(void* pac, archive_entry_list* hlArc,
     std::vector<blob>* pacs, bool readSplits,
     std::vector<std::string>* parentPaths)
 {
+    HL_TRACE_ZONE("pacx::v4::v03::read");
+
     // Fix PACxV403 data.
     fix(pac);
 
@@ -4953,6 +5498,8 @@ void write(const archive_entry_list& arc,
     stream& stream, u32 splitLimit, u32 dataAlignment,
     bool noCompress)
 {
+    HL_TRACE_ZONE("pacx::v4::v03::write");
+
     // Verify that dataAlignment is a multiple of 4.
     if ((dataAlignment % 4) != 0)
     {
@@ -5000,7 +5547,7 @@ void write(const archive_entry_list& arc,
     const std::size_t rootDepTablePos = v3::in_write(ver_402,
         USHRT_MAX, uid, typeMetadata, splitLimit, dataAlignment,
         true, compressType, maxChunkSize, endianFlag, deps,
-        nullptr, rootInternalFile);
+        nullptr, nullptr, rootInternalFile);
 
     const std::size_t rootUncompressedSize = rootInternalFile.get_size();
     rootDepInfo.uncompressedSize = rootUncompressedSize;
@@ -5230,6 +5777,8 @@ void decompress_no_alloc_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
     const void* src, u32 dstSize, void* dst)
 {
+    HL_TRACE_ZONE("pacx::v4::decompress_lz4");
+
     // If the data is already uncompressed, just copy it.
     if (srcSize == dstSize)
     {
@@ -5250,11 +5799,11 @@ void decompress_no_alloc_lz4(u32 chunkCount,
     }
 }
 
-std::unique_ptr<u8[]> decompress_lz4(u32 chunkCount,
+unique_buffer decompress_lz4(u32 chunkCount,
     const chunk* chunks, u32 srcSize,
     const void* src, u32 dstSize)
 {
-    std::unique_ptr<u8[]> dst(new u8[dstSize]);
+    auto dst = make_unique_buffer(dstSize, memory_subsystem::compression);
     decompress_no_alloc_lz4(chunkCount, chunks,
         srcSize, src, dstSize, dst.get());
 
@@ -5275,6 +5824,8 @@ blob decompress_lz4_blob(u32 chunkCount,
 void decompress_no_alloc_deflate(u32 srcSize,
     const void* src, u32 dstSize, void* dst)
 {
+    HL_TRACE_ZONE("pacx::v4::decompress_deflate");
+
     // If the data is already uncompressed, just copy it.
     if (srcSize == dstSize)
     {
@@ -5286,10 +5837,10 @@ void decompress_no_alloc_deflate(u32 srcSize,
     deflate_decompress_no_alloc(srcSize, src, dstSize, dst);
 }
 
-std::unique_ptr<u8[]> decompress_deflate(u32 srcSize,
+unique_buffer decompress_deflate(u32 srcSize,
     const void* src, u32 dstSize)
 {
-    std::unique_ptr<u8[]> dst(new u8[dstSize]);
+    auto dst = make_unique_buffer(dstSize, memory_subsystem::compression);
     decompress_no_alloc_deflate(srcSize, src, dstSize, dst.get());
     return dst;
 }
@@ -5306,6 +5857,8 @@ std::size_t compress_no_alloc_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src, std::size_t dstBufSize,
     void* dst, std::vector<chunk>& chunks)
 {
+    HL_TRACE_ZONE("pacx::v4::compress_lz4");
+
     const void* srcEnd = ptradd(src, srcSize);
     std::size_t totalCompressedSize = 0;
 
@@ -5359,12 +5912,12 @@ static std::size_t in_compress_lz4_bound(u32 maxChunkSize,
     return totalCompressBound;
 }
 
-std::unique_ptr<u8[]> compress_lz4(u32 maxChunkSize,
+unique_buffer compress_lz4(u32 maxChunkSize,
     std::size_t srcSize, const void* src, std::size_t& dstSize,
     std::vector<chunk>& chunks)
 {
     const std::size_t compressBound = in_compress_lz4_bound(maxChunkSize, srcSize);
-    std::unique_ptr<u8[]> dst(new u8[compressBound]);
+    auto dst = make_unique_buffer(compressBound, memory_subsystem::compression);
 
     dstSize = compress_no_alloc_lz4(maxChunkSize, srcSize, src,
         compressBound, dst.get(), chunks);
@@ -5389,10 +5942,12 @@ blob compress_blob_lz4(u32 maxChunkSize,
 std::size_t compress_no_alloc_deflate(std::size_t srcSize,
     const void* src, std::size_t dstBufSize, void* dst)
 {
+    HL_TRACE_ZONE("pacx::v4::compress_deflate");
+
     return deflate_compress_no_alloc(srcSize, src, dstBufSize, dst);
 }
 
-std::unique_ptr<u8[]> compress_deflate(std::size_t srcSize,
+unique_buffer compress_deflate(std::size_t srcSize,
     const void* src, std::size_t& dstSize)
 {
     return hl::compress(compress_type::deflate, srcSize, src, dstSize);
@@ -5478,6 +6033,8 @@ void load(const nchar* filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs,
     bool readSplits)
 {
+    HL_TRACE_ZONE("pacx::v4::load");
+
     // Load data into blob.
     blob pac(filePath);
 
@@ -5489,6 +6046,8 @@ void load(const nchar* filePath,
     archive_entry_list* hlArc, std::vector<blob>* pacs,
     bool readSplits)
 {
+    HL_TRACE_ZONE("pacx::v4::load");
+
     // Load data into blob.
     blob pac(filePath);
 
@@ -5517,6 +6076,8 @@ nstring get_root_path(const nchar* filePath)
 void load(const nchar* filePath, archive_entry_list* hlArc,
     std::vector<blob>* pacs)
 {
+    HL_TRACE_ZONE("pacx::load");
+
     // Load data into blob.
     blob pac(filePath);
 
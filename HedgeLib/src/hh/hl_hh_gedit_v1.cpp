@@ -1,5 +1,6 @@
 #include "hedgelib/hh/hl_hh_gedit.h"
 #include "hedgelib/sets/hl_hson.h"
+#include "hedgelib/hl_trace.h"
 
 namespace hl
 {
@@ -118,6 +119,8 @@ static void in_fix(raw_world& rawHeader)
 
 void raw_world::fix(bina::endian_flag endianFlag)
 {
+    HL_TRACE_ZONE("hh::gedit::v1::fix");
+
     if (bina::needs_swap(endianFlag))
     {
         in_fix(*this);
@@ -2,6 +2,7 @@
 #include "hl_in_hh_gedit_field_writer.h"
 #include "hedgelib/hh/hl_hh_gedit.h"
 #include "hedgelib/io/hl_file.h"
+#include "hedgelib/hl_trace.h"
 #include <DirectXMath.h>
 #include <unordered_set>
 
@@ -257,6 +258,8 @@ static void in_fix(raw_world& rawHeader)
 
 void raw_world::fix(bina::endian_flag endianFlag)
 {
+    HL_TRACE_ZONE("hh::gedit::v3::fix");
+
     if (bina::needs_swap(endianFlag))
     {
         in_fix(*this);
@@ -267,6 +270,8 @@ void raw_world::add_to_hson(ordered_map<guid, hson::object>& hsonObjects,
     const set_object_type_database* objTypeDB,
     bool tailEndAlignParentStructs) const
 {
+    HL_TRACE_ZONE("hh::gedit::v3::add_to_hson");
+
     // Add all objects in the gedit world to the HSON.
     hsonObjects.reserve(hsonObjects.size() + objects.count);
 
@@ -341,6 +346,8 @@ void write(const hson::project& project,
     const set_object_type_database& objTypeDB,
     bina::v2::writer64& writer, bool tailEndAlignParentStructs)
 {
+    HL_TRACE_ZONE("hh::gedit::v3::write");
+
     // Start writing BINA data block.
     writer.start_data_block();
 
@@ -392,6 +399,8 @@ void write(const hson::project& project,
     // Write objects.
     radix_tree<hson::parameter> tagsBuf;
     radix_tree<std::size_t> numObjsOfTypes;
+    tagsBuf.use_arena();
+
     const auto objsPos = writer.tell();
 
     for (auto it = project.objects.begin(); it != project.objects.end(); ++it)
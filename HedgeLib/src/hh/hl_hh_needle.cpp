@@ -1,6 +1,9 @@
 #include "hedgelib/hh/hl_hh_needle.h"
+#include "hedgelib/io/hl_hh_mirage.h"
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_path.h"
+#include "hedgelib/hl_trace.h"
+#include "../hl_in_parallel.h"
 #include <cstring>
 
 namespace hl
@@ -66,6 +69,279 @@ raw_archive_entry* raw_archive::entries_sec()
         reinterpret_cast<std::uintptr_t>(
         ext + std::strlen(ext) + 1), 4));
 }
+static u32 in_swap_be(u32 val) noexcept
+{
+#ifndef HL_IS_BIG_ENDIAN
+    hl::endian_swap(val);
+#endif
+    return val;
+}
+
+static u32 in_swap_le(u32 val) noexcept
+{
+#ifdef HL_IS_BIG_ENDIAN
+    hl::endian_swap(val);
+#endif
+    return val;
+}
+
+static u32* in_model_get_off_table(void* rawModel,
+    std::size_t rawModelSize, u8*& base, u32& offCount)
+{
+    // Get offset table position, offset count, and base pointer from header.
+    u32 offTableOff;
+    if (mirage::has_sample_chunk_header_unfixed(rawModel))
+    {
+        if (rawModelSize < sizeof(mirage::sample_chunk::raw_header))
+        {
+            throw invalid_data_exception();
+        }
+
+        const auto rawHeader = static_cast<mirage::sample_chunk::raw_header*>(rawModel);
+        base = reinterpret_cast<u8*>(rawHeader + 1);
+        offTableOff = in_swap_be(rawHeader->offTable.get_raw());
+        offCount = in_swap_be(rawHeader->offCount);
+    }
+    else
+    {
+        if (rawModelSize < sizeof(mirage::standard::raw_header))
+        {
+            throw invalid_data_exception();
+        }
+
+        const auto rawHeader = static_cast<mirage::standard::raw_header*>(rawModel);
+        const u32 dataOff = in_swap_be(rawHeader->data.get_raw());
+        offTableOff = in_swap_be(rawHeader->offTable.get_raw());
+
+        // Ensure the data (which offsets are relative to) begins within the model.
+        if (dataOff > rawModelSize)
+        {
+            throw invalid_data_exception();
+        }
+
+        base = ptradd<u8>(rawHeader, dataOff);
+
+        if (offTableOff > (rawModelSize - 4))
+        {
+            throw invalid_data_exception();
+        }
+
+        offCount = in_swap_be(*ptradd<u32>(rawHeader, offTableOff));
+        offTableOff += 4;
+    }
+
+    // Ensure the offset table fits within the model.
+    if (offTableOff > rawModelSize || offCount > ((rawModelSize - offTableOff) / 4))
+    {
+        throw invalid_data_exception();
+    }
+
+    return ptradd<u32>(rawModel, offTableOff);
+}
+
+void unfix_model(void* rawModel, std::size_t rawModelSize)
+{
+    HL_TRACE_ZONE("hh::needle::unfix_model");
+
+    // Get offset table.
+    u8* base;
+    u32 offCount;
+    const u32* offTable = in_model_get_off_table(rawModel,
+        rawModelSize, base, offCount);
+
+    const std::size_t maxOffPos = static_cast<std::size_t>(
+        (static_cast<u8*>(rawModel) + rawModelSize) - base);
+
+    // Convert offsets from little-endian, relative to themselves, into
+    // big-endian, relative to the base pointer. (NOTE: Null offsets stay null.)
+    for (u32 i = 0; i < offCount; ++i)
+    {
+        const u32 offPos = in_swap_be(offTable[i]);
+        if (maxOffPos < 4 || offPos > (maxOffPos - 4))
+        {
+            throw invalid_data_exception();
+        }
+
+        u32& off = *reinterpret_cast<u32*>(base + offPos);
+        const u32 relOff = in_swap_le(off);
+        if (!relOff)
+        {
+            off = 0;
+            continue;
+        }
+
+        // Ensure the offset points within the model.
+        // NOTE: Relative offsets can be negative, so this is meant to wrap around.
+        const u32 baseOff = (offPos + relOff);
+        if (baseOff > maxOffPos)
+        {
+            throw invalid_data_exception();
+        }
+
+        off = in_swap_be(baseOff);
+    }
+}
+
+void fix_model(void* rawModel, std::size_t rawModelSize)
+{
+    HL_TRACE_ZONE("hh::needle::fix_model");
+
+    // Get offset table.
+    u8* base;
+    u32 offCount;
+    const u32* offTable = in_model_get_off_table(rawModel,
+        rawModelSize, base, offCount);
+
+    const std::size_t maxOffPos = static_cast<std::size_t>(
+        (static_cast<u8*>(rawModel) + rawModelSize) - base);
+
+    // Convert offsets from big-endian, relative to the base pointer, into
+    // little-endian, relative to themselves. (NOTE: Null offsets stay null.)
+    for (u32 i = 0; i < offCount; ++i)
+    {
+        const u32 offPos = in_swap_be(offTable[i]);
+        if (maxOffPos < 4 || offPos > (maxOffPos - 4))
+        {
+            throw invalid_data_exception();
+        }
+
+        u32& off = *reinterpret_cast<u32*>(base + offPos);
+        const u32 baseOff = in_swap_be(off);
+        if (!baseOff)
+        {
+            continue;
+        }
+
+        // Ensure the offset points within the model.
+        if (baseOff > maxOffPos)
+        {
+            throw invalid_data_exception();
+        }
+
+        off = in_swap_le(baseOff - offPos);
+    }
+}
+
+void unpack(raw_archive& rawArc)
+{
+    HL_TRACE_ZONE("hh::needle::unpack");
+
+    // Endian-swap archive header and entry sizes, and get models.
+    std::vector<raw_archive_entry*> models;
+    rawArc.endian_swap();
+
+    for (auto it = rawArc.begin(); it != rawArc.end();)
+    {
+        auto& rawArcEntry = *it;
+        hl::endian_swap(rawArcEntry.size());
+        ++it;
+
+        if (std::memcmp(rawArcEntry.signature, &signature_model_v5, 8) == 0)
+        {
+            models.push_back(&rawArcEntry);
+        }
+    }
+
+    // Unfix models.
+    in_parallel_for(models.size(), [&](std::size_t i)
+    {
+        unfix_model(models[i]->data(), models[i]->size());
+    });
+}
+
+static const char* in_archive_entry_get_ext(archive_entry_type type)
+{
+    switch (type)
+    {
+    case archive_entry_type::lodinfo:
+        return "lodinfo";
+
+    case archive_entry_type::model:
+        return "model";
+
+    default:
+        throw invalid_arg_exception("type");
+    }
+}
+
+static const u64& in_archive_entry_get_sig(archive_entry_type type)
+{
+    return (type == archive_entry_type::lodinfo) ?
+        signature_lodinfo_v1 : signature_model_v5;
+}
+
+static std::size_t in_archive_entry_get_data_pos(
+    archive_entry_type type, std::size_t entryPos)
+{
+    // NOTE: The size is aligned to 4 bytes, relative to the start of the archive.
+    const std::size_t sizePos = align(entryPos + 8 +
+        text::size(in_archive_entry_get_ext(type)), 4);
+
+    return (sizePos + 4);
+}
+
+blob pack(const archive_entry* entries, std::size_t entryCount)
+{
+    HL_TRACE_ZONE("hh::needle::pack");
+
+    // Compute archive size.
+    const std::size_t entriesPos = align(sizeof(raw_archive) + sizeof("arc"), 4);
+    std::size_t arcSize = entriesPos;
+
+    for (std::size_t i = 0; i < entryCount; ++i)
+    {
+        arcSize = in_archive_entry_get_data_pos(entries[i].type, arcSize);
+        arcSize += entries[i].dataSize;
+    }
+
+    if ((arcSize - 8) > UINT32_MAX)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Allocate archive and write header.
+    blob arc(arcSize);
+    u8* arcData = arc.data<u8>();
+    std::memset(arcData, 0, arcSize);
+
+    std::memcpy(arcData, &signature_archive_v1, 8);
+    *reinterpret_cast<u32*>(arcData + 8) = in_swap_be(static_cast<u32>(arcSize - 8));
+    std::memcpy(arcData + sizeof(raw_archive), "arc", sizeof("arc"));
+
+    // Write entries, and get the models we'll need to fix.
+    std::vector<std::pair<void*, std::size_t>> models;
+    std::size_t curPos = entriesPos;
+
+    for (std::size_t i = 0; i < entryCount; ++i)
+    {
+        const archive_entry& entry = entries[i];
+        const char* ext = in_archive_entry_get_ext(entry.type);
+        const std::size_t dataPos = in_archive_entry_get_data_pos(entry.type, curPos);
+
+        // Write entry header.
+        std::memcpy(arcData + curPos, &in_archive_entry_get_sig(entry.type), 8);
+        std::memcpy(arcData + curPos + 8, ext, text::size(ext));
+        *reinterpret_cast<u32*>(arcData + dataPos - 4) =
+            in_swap_be(static_cast<u32>(entry.dataSize));
+
+        // Copy entry data.
+        std::memcpy(arcData + dataPos, entry.data, entry.dataSize);
+        if (entry.type == archive_entry_type::model)
+        {
+            models.emplace_back(arcData + dataPos, entry.dataSize);
+        }
+
+        curPos = (dataPos + entry.dataSize);
+    }
+
+    // Fix models.
+    in_parallel_for(models.size(), [&](std::size_t i)
+    {
+        fix_model(models[i].first, models[i].second);
+    });
+
+    return arc;
+}
 } // needle
 } // hh
 } // hl
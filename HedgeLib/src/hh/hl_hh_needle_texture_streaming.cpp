@@ -1,5 +1,9 @@
 #include "hedgelib/hh/hl_hh_needle_texture_streaming.h"
+#include "hedgelib/io/hl_file.h"
+#include "../hl_in_parallel.h"
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace hl
 {
@@ -94,20 +98,278 @@ const raw_package_entry* readonly_package_wrapper::get_entry(const char* str) co
             return entry.nameHash < hash;
         });
 
-    return result != last ? result : nullptr;
+    // Multiple entries can have the same name hash, so check their names as well.
+    for (; result != last && result->nameHash == nameHash; ++result)
+    {
+        if (std::strcmp(result->name.get(), str) == 0)
+        {
+            return result;
+        }
+    }
+
+    return nullptr;
+}
+
+static void in_validate_blob_range(const raw_package& package, u32 index, u32 count)
+{
+    // NOTE: We check it this way so that index + count can't overflow.
+    if (index > package.blobCount || count > (package.blobCount - index))
+    {
+        throw invalid_data_exception();
+    }
 }
 
 hl::blob readonly_package_wrapper::load_blob(u32 index) const
 {
+    in_validate_blob_range(*m_package, index, 1);
+
     const raw_package_blob& rawBlob = m_package->blobs()[index];
     hl::blob blob(static_cast<size_t>(rawBlob.dataSize));
 
-    m_stream->seek(hl::seek_mode::beg, rawBlob.dataOffset);
-    m_stream->read(blob.size(), blob.data());
+    m_stream->read_all_at(static_cast<size_t>(rawBlob.dataOffset),
+        blob.size(), blob.data());
 
     return blob;
 }
 
+std::size_t readonly_package_wrapper::get_blobs_size(
+    u32 index, u32 count) const
+{
+    // Ensure the given blob range is valid.
+    in_validate_blob_range(*m_package, index, count);
+
+    // Compute the total size of the blobs.
+    const raw_package_blob* rawBlobs = (m_package->blobs() + index);
+    std::size_t size = 0;
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        size += static_cast<std::size_t>(rawBlobs[i].dataSize);
+    }
+
+    return size;
+}
+
+namespace
+{
+constexpr std::size_t in_min_parallel_blob_reads = 4;
+
+struct in_blob_read
+{
+    u64 srcPos;
+    std::size_t dstPos;
+    std::size_t size;
+};
+} // namespace
+
+void readonly_package_wrapper::load_blobs(u32 index, u32 count, void* dst) const
+{
+    // Ensure the given blob range is valid.
+    in_validate_blob_range(*m_package, index, count);
+
+    // Coalesce blobs which are stored contiguously within the package into single reads.
+    const raw_package_blob* rawBlobs = (m_package->blobs() + index);
+    std::vector<in_blob_read> reads;
+    std::size_t dstPos = 0;
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        const raw_package_blob& rawBlob = rawBlobs[i];
+        const auto size = static_cast<std::size_t>(rawBlob.dataSize);
+
+        if (size == 0) continue;
+
+        if (!reads.empty() && (reads.back().srcPos +
+            reads.back().size) == rawBlob.dataOffset)
+        {
+            reads.back().size += size;
+        }
+        else
+        {
+            reads.push_back({ rawBlob.dataOffset, dstPos, size });
+        }
+
+        dstPos += size;
+    }
+
+    // Perform the reads.
+    const auto doRead = [&](std::size_t i)
+    {
+        const in_blob_read& read = reads[i];
+        m_stream->read_all_at(static_cast<std::size_t>(read.srcPos),
+            read.size, static_cast<u8*>(dst) + read.dstPos);
+    };
+
+    // NOTE: Most textures only need one or two reads, which isn't
+    // worth starting threads for, so we only read in parallel when
+    // there are enough reads and the stream supports it.
+    if (reads.size() >= in_min_parallel_blob_reads &&
+        m_stream->supports_concurrent_reads())
+    {
+        in_parallel_for(reads.size(), doRead);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < reads.size(); ++i)
+        {
+            doRead(i);
+        }
+    }
+}
+
+static u32 in_get_dds_header_u32(const raw_info& info, u32 off) noexcept
+{
+    // NOTE: DDS headers are always little-endian.
+    u32 val;
+    std::memcpy(&val, info.dds_header() + off, sizeof(val));
+
+#ifdef HL_IS_BIG_ENDIAN
+    val = HL_SWAP_U32(val);
+#endif
+
+    return val;
+}
+
+static void in_validate_dds_header(const raw_info& info)
+{
+    constexpr u32 ddsCaps2Cubemap = 0x200;
+    constexpr u32 ddsCaps2Volume = 0x200000;
+    constexpr u32 dx10DimensionTexture2D = 3;
+    constexpr u32 dx10MiscFlagTextureCube = 0x4;
+
+    // Ensure the texture is a single 2D texture, as we just append the mips one
+    // after the other, which isn't how the faces/slices of cube maps, texture
+    // arrays, and 3D textures are laid out within DDS files.
+    if ((in_get_dds_header_u32(info, dds_header_caps2_off) &
+        (ddsCaps2Cubemap | ddsCaps2Volume)) != 0)
+    {
+        throw unsupported_exception();
+    }
+
+    if (info.dds_header_size() == dds_header_dx10_size &&
+        (in_get_dds_header_u32(info, dds_header_dx10_dimension_off) != dx10DimensionTexture2D ||
+        (in_get_dds_header_u32(info, dds_header_dx10_misc_flag_off) & dx10MiscFlagTextureCube) != 0 ||
+        in_get_dds_header_u32(info, dds_header_dx10_array_size_off) > 1))
+    {
+        throw unsupported_exception();
+    }
+}
+
+std::size_t get_dds_size(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry)
+{
+    in_validate_dds_header(info);
+    return (info.dds_header_size() +
+        package.get_blobs_size(entry.blobIndex, entry.blobCount) +
+        info.mip4x4Size);
+}
+
+void load_dds(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry, void* dst)
+{
+    u8* dstPtr = static_cast<u8*>(dst);
+
+    // Ensure the texture can be rebuilt, before writing anything.
+    in_validate_dds_header(info);
+    const std::size_t blobsSize = package.get_blobs_size(
+        entry.blobIndex, entry.blobCount);
+
+    // Copy DDS header.
+    const u32 headerSize = info.dds_header_size();
+    std::memcpy(dstPtr, info.dds_header(), headerSize);
+    dstPtr += headerSize;
+
+    // Read the larger mips from the package.
+    package.load_blobs(entry.blobIndex, entry.blobCount, dstPtr);
+    dstPtr += blobsSize;
+
+    // Copy the smaller mips from the info.
+    std::memcpy(dstPtr, info.mip_4x4(), info.mip4x4Size);
+}
+
+hl::blob load_dds(const raw_info& info,
+    const readonly_package_wrapper& package,
+    const raw_package_entry& entry)
+{
+    hl::blob dds(get_dds_size(info, package, entry));
+    load_dds(info, package, entry, dds.data());
+    return dds;
+}
+
+void package_index::build(const raw_package& package)
+{
+    m_package = &package;
+    m_chainHeads.clear();
+    m_chainNext.assign(package.entryCount, UINT32_MAX);
+    m_chainHeads.reserve(package.entryCount);
+
+    // Add entries to the chains of their name hashes.
+    // (NOTE: We go in reverse so that each chain ends up in the same order as the entries.)
+    const raw_package_entry* entries = package.entries();
+    for (u32 i = package.entryCount; i-- > 0;)
+    {
+        const auto result = m_chainHeads.insert(std::make_pair(
+            entries[i].nameHash, i));
+
+        if (!result.second)
+        {
+            m_chainNext[i] = result.first->second;
+            result.first->second = i;
+        }
+    }
+}
+
+const raw_package_entry* package_index::find(const char* name) const
+{
+    // Find the chain of entries with the same name hash as the given name.
+    const auto it = m_chainHeads.find(compute_name_hash(name));
+    if (it == m_chainHeads.end()) return nullptr;
+
+    // Return the first entry within the chain which has the given name.
+    const raw_package_entry* entries = m_package->entries();
+    for (u32 i = it->second; i != UINT32_MAX; i = m_chainNext[i])
+    {
+        if (std::strcmp(entries[i].name.get(), name) == 0)
+        {
+            return &entries[i];
+        }
+    }
+
+    return nullptr;
+}
+
+const raw_package_blob* package_index::get_mip_blobs(
+    const raw_package_entry& entry, u32 firstMip, u32& mipCount) const
+{
+    // Ensure the given mip range is valid.
+    if (firstMip > entry.blobCount ||
+        entry.blobIndex > m_package->blobCount ||
+        entry.blobCount > (m_package->blobCount - entry.blobIndex))
+    {
+        throw out_of_range_exception();
+    }
+
+    // Clamp mip count and return blobs.
+    mipCount = std::min(mipCount, entry.blobCount - firstMip);
+    return (m_package->blobs() + entry.blobIndex + firstMip);
+}
+
+std::size_t package_index::get_mips_size(const raw_package_entry& entry,
+    u32 firstMip, u32 mipCount) const
+{
+    const raw_package_blob* blobs = get_mip_blobs(entry, firstMip, mipCount);
+    std::size_t size = 0;
+
+    for (u32 i = 0; i < mipCount; ++i)
+    {
+        size += static_cast<std::size_t>(blobs[i].dataSize);
+    }
+
+    return size;
+}
+
 readonly_info_wrapper::~readonly_info_wrapper()
 {
     operator delete(m_info);
@@ -137,6 +399,188 @@ bool readonly_info_wrapper::try_load(hl::stream& stream)
     return false;
 }
 
+struct streaming_cache::package_data
+{
+    file_stream stream;
+    readonly_package_wrapper package;
+    package_index index;
+    u32 id;
+
+    package_data(const nchar* filePath, u32 id) :
+        stream(filePath, file::mode::read), id(id)
+    {
+        if (!package.try_load(&stream))
+        {
+            throw invalid_data_exception();
+        }
+
+        index.build(*package.get());
+    }
+};
+
+streaming_cache::streaming_cache(std::size_t blobBudget) :
+    m_blobBudget(blobBudget) {}
+
+streaming_cache::~streaming_cache() = default;
+
+void streaming_cache::set_blob_budget(std::size_t blobBudget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blobBudget = blobBudget;
+    in_evict_blobs();
+}
+
+streaming_cache::package_data& streaming_cache::in_get_package(const nchar* filePath)
+{
+    // Return the package if it's already within the cache.
+    auto it = m_packages.find(filePath);
+    if (it != m_packages.end())
+    {
+        ++m_stats.packageHits;
+        return *it->second;
+    }
+
+    // Otherwise, open and load it.
+    ++m_stats.packageMisses;
+
+    std::unique_ptr<package_data> package(new package_data(
+        filePath, static_cast<u32>(m_packages.size())));
+
+    return *(m_packages[filePath] = std::move(package));
+}
+
+void streaming_cache::in_evict_blobs()
+{
+    // Evict least-recently-used blobs until we're within the budget.
+    while (m_stats.blobBytes > m_blobBudget && !m_blobs.empty())
+    {
+        const cached_blob& blob = m_blobs.back();
+
+        m_stats.blobBytes -= blob.blob->size();
+        ++m_stats.blobEvictions;
+
+        m_blobsByKey.erase(blob.key);
+        m_blobs.pop_back();
+    }
+}
+
+const readonly_package_wrapper& streaming_cache::get_package(const nchar* filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return in_get_package(filePath).package;
+}
+
+const package_index& streaming_cache::get_package_index(const nchar* filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return in_get_package(filePath).index;
+}
+
+const raw_info& streaming_cache::get_info(const nchar* filePath)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Return the info if it's already within the cache.
+    auto it = m_infos.find(filePath);
+    if (it != m_infos.end())
+    {
+        ++m_stats.infoHits;
+        return *it->second->get();
+    }
+
+    // Otherwise, load it.
+    ++m_stats.infoMisses;
+
+    std::unique_ptr<readonly_info_wrapper> info(new readonly_info_wrapper());
+    file_stream stream(filePath, file::mode::read);
+
+    if (!info->try_load(stream))
+    {
+        throw invalid_data_exception();
+    }
+
+    const raw_info& rawInfo = *info->get();
+    m_infos[filePath] = std::move(info);
+    return rawInfo;
+}
+
+streaming_cache::blob_ptr streaming_cache::get_blob(
+    const nchar* packageFilePath, u32 index)
+{
+    const readonly_package_wrapper* package;
+    u64 key;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Get the package and the blob's key.
+        package_data& packageData = in_get_package(packageFilePath);
+        package = &packageData.package;
+        key = ((static_cast<u64>(packageData.id) << 32) | index);
+
+        // Return the blob if it's already within the cache, marking it as most-recently-used.
+        auto it = m_blobsByKey.find(key);
+        if (it != m_blobsByKey.end())
+        {
+            ++m_stats.blobHits;
+            m_blobs.splice(m_blobs.begin(), m_blobs, it->second);
+            return it->second->blob;
+        }
+
+        ++m_stats.blobMisses;
+    }
+
+    // Otherwise, load the blob without holding the lock.
+    if (index >= package->get()->blobCount)
+    {
+        throw out_of_range_exception();
+    }
+
+    blob_ptr blob = std::make_shared<const hl::blob>(
+        package->load_blob(index));
+
+    // Add the blob to the cache, unless another thread already did so while we were loading it.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_blobsByKey.find(key);
+
+    if (it != m_blobsByKey.end())
+    {
+        m_blobs.splice(m_blobs.begin(), m_blobs, it->second);
+        return it->second->blob;
+    }
+
+    m_blobs.push_front({ key, blob });
+    m_blobsByKey[key] = m_blobs.begin();
+    m_stats.blobBytes += blob->size();
+
+    in_evict_blobs();
+    return blob;
+}
+
+streaming_cache::stats streaming_cache::get_stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void streaming_cache::reset_stats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::size_t blobBytes = m_stats.blobBytes;
+
+    m_stats = stats();
+    m_stats.blobBytes = blobBytes;
+}
+
+void streaming_cache::clear_blobs()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_blobs.clear();
+    m_blobsByKey.clear();
+    m_stats.blobBytes = 0;
+}
+
 } // texture_streaming
 } // needle
 } // hh
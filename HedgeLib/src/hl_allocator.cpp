@@ -0,0 +1,304 @@
+#include "hedgelib/hl_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace hl
+{
+static const char* const in_subsystem_names[] =
+{
+    "general",
+    "blob",
+    "file",
+    "compression",
+    "stream",
+    "archive",
+    "radix_tree"
+};
+
+HL_STATIC_ASSERT(count_of(in_subsystem_names) ==
+    static_cast<std::size_t>(memory_subsystem::count),
+    "in_subsystem_names must contain a name for every subsystem");
+
+const char* get_subsystem_name(memory_subsystem subsystem) noexcept
+{
+    return (subsystem < memory_subsystem::count) ?
+        in_subsystem_names[static_cast<std::size_t>(subsystem)] :
+        "unknown";
+}
+
+void* default_allocator::allocate(std::size_t size,
+    std::size_t alignment, memory_subsystem /*subsystem*/)
+{
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+    else
+    {
+        return ::operator new(size);
+    }
+}
+
+void default_allocator::deallocate(void* ptr, std::size_t /*size*/,
+    std::size_t alignment, memory_subsystem /*subsystem*/) noexcept
+{
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        ::operator delete(ptr, std::align_val_t(alignment));
+    }
+    else
+    {
+        ::operator delete(ptr);
+    }
+}
+
+default_allocator& default_allocator::instance() noexcept
+{
+    static default_allocator defaultAlloc;
+    return defaultAlloc;
+}
+
+void* budget_allocator::allocate(std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem)
+{
+    // Reserve the requested amount of memory within the budget.
+    const std::size_t prevUsed = m_used.fetch_add(size, std::memory_order_relaxed);
+    if (size > m_budget || prevUsed > (m_budget - size))
+    {
+        m_used.fetch_sub(size, std::memory_order_relaxed);
+        throw std::bad_alloc();
+    }
+
+    // Allocate the memory using the upstream allocator.
+    try
+    {
+        return m_upstream->allocate(size, alignment, subsystem);
+    }
+    catch (...)
+    {
+        m_used.fetch_sub(size, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+void budget_allocator::deallocate(void* ptr, std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem) noexcept
+{
+    m_upstream->deallocate(ptr, size, alignment, subsystem);
+    m_used.fetch_sub(size, std::memory_order_relaxed);
+}
+
+static std::atomic<allocator*> in_global_allocator(nullptr);
+static thread_local allocator* in_thread_allocator = nullptr;
+
+allocator& get_global_allocator() noexcept
+{
+    const auto alloc = in_global_allocator.load(std::memory_order_acquire);
+    return (alloc) ? *alloc : default_allocator::instance();
+}
+
+void set_global_allocator(allocator* alloc) noexcept
+{
+    in_global_allocator.store(alloc, std::memory_order_release);
+}
+
+allocator& get_allocator() noexcept
+{
+    return (in_thread_allocator) ? *in_thread_allocator :
+        get_global_allocator();
+}
+
+scoped_allocator::scoped_allocator(allocator& alloc) noexcept :
+    m_prevAlloc(in_thread_allocator)
+{
+    in_thread_allocator = &alloc;
+}
+
+scoped_allocator::~scoped_allocator()
+{
+    in_thread_allocator = m_prevAlloc;
+}
+
+struct in_memory_stats
+{
+    std::atomic<std::size_t> liveBytes{ 0 };
+    std::atomic<std::size_t> liveCount{ 0 };
+    std::atomic<std::size_t> peakBytes{ 0 };
+    std::atomic<std::size_t> totalBytes{ 0 };
+    std::atomic<std::size_t> totalCount{ 0 };
+};
+
+static in_memory_stats in_subsystem_stats[static_cast<std::size_t>(
+    memory_subsystem::count)];
+
+static in_memory_stats& in_get_stats(memory_subsystem subsystem) noexcept
+{
+    return in_subsystem_stats[(subsystem < memory_subsystem::count) ?
+        static_cast<std::size_t>(subsystem) : 0];
+}
+
+static void in_record_alloc(memory_subsystem subsystem, std::size_t size) noexcept
+{
+    auto& stats = in_get_stats(subsystem);
+    const std::size_t liveBytes = (stats.liveBytes.fetch_add(
+        size, std::memory_order_relaxed) + size);
+
+    stats.liveCount.fetch_add(1, std::memory_order_relaxed);
+    stats.totalBytes.fetch_add(size, std::memory_order_relaxed);
+    stats.totalCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Update peak.
+    std::size_t peakBytes = stats.peakBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes && !stats.peakBytes.compare_exchange_weak(
+        peakBytes, liveBytes, std::memory_order_relaxed)) {}
+}
+
+static void in_record_dealloc(memory_subsystem subsystem, std::size_t size) noexcept
+{
+    auto& stats = in_get_stats(subsystem);
+    stats.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    stats.liveCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+memory_stats get_memory_stats(memory_subsystem subsystem) noexcept
+{
+    const auto& stats = in_get_stats(subsystem);
+    return memory_stats
+    {
+        stats.liveBytes.load(std::memory_order_relaxed),
+        stats.liveCount.load(std::memory_order_relaxed),
+        stats.peakBytes.load(std::memory_order_relaxed),
+        stats.totalBytes.load(std::memory_order_relaxed),
+        stats.totalCount.load(std::memory_order_relaxed)
+    };
+}
+
+memory_stats get_memory_stats() noexcept
+{
+    memory_stats total = {};
+    for (std::size_t i = 0; i < static_cast<std::size_t>(
+        memory_subsystem::count); ++i)
+    {
+        const auto stats = get_memory_stats(static_cast<memory_subsystem>(i));
+        total.liveBytes += stats.liveBytes;
+        total.liveCount += stats.liveCount;
+        total.peakBytes += stats.peakBytes;
+        total.totalBytes += stats.totalBytes;
+        total.totalCount += stats.totalCount;
+    }
+
+    return total;
+}
+
+void reset_memory_stats() noexcept
+{
+    for (auto& stats : in_subsystem_stats)
+    {
+        stats.peakBytes.store(stats.liveBytes.load(
+            std::memory_order_relaxed), std::memory_order_relaxed);
+
+        stats.totalBytes.store(0, std::memory_order_relaxed);
+        stats.totalCount.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+    @brief Stored directly before every block returned by hl::allocate, so
+    hl::deallocate knows how (and with which allocator) to free the block.
+*/
+struct in_alloc_header
+{
+    allocator* alloc;
+    /** @brief The block size (low 48 bits), subsystem (next 8 bits), and log2 of the alignment (high 8 bits). */
+    u64 info;
+};
+
+HL_STATIC_ASSERT_SIZE(in_alloc_header, 16);
+
+constexpr u64 in_alloc_max_size = ((static_cast<u64>(1) << 48) - 1);
+
+inline static std::size_t in_get_header_space(std::size_t alignment) noexcept
+{
+    return std::max(alignment, sizeof(in_alloc_header));
+}
+
+inline static std::size_t in_get_block_alignment(std::size_t alignment) noexcept
+{
+    return std::max(alignment, alignof(in_alloc_header));
+}
+
+void* allocate(std::size_t size, std::size_t alignment,
+    memory_subsystem subsystem)
+{
+    // Ensure alignment is a non-zero power of two.
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw invalid_arg_exception("alignment");
+    }
+
+    // Ensure the size can be stored in the header.
+    const std::size_t headerSpace = in_get_header_space(alignment);
+    if (size > in_alloc_max_size || size > (SIZE_MAX - headerSpace))
+    {
+        throw std::bad_alloc();
+    }
+
+    // Allocate the block using the current allocator.
+    auto& alloc = get_allocator();
+    const auto block = static_cast<u8*>(alloc.allocate(size + headerSpace,
+        in_get_block_alignment(alignment), subsystem));
+
+    // Setup the header.
+    const auto ptr = (block + headerSpace);
+    const auto header = reinterpret_cast<in_alloc_header*>(
+        ptr - sizeof(in_alloc_header));
+
+    header->alloc = &alloc;
+    header->info = (static_cast<u64>(size) |
+        (static_cast<u64>(subsystem) << 48) |
+        (static_cast<u64>(bit_ctz(static_cast<unsigned int>(alignment))) << 56));
+
+    // Record the allocation and return a pointer to the block.
+    in_record_alloc(subsystem, size);
+    return ptr;
+}
+
+void deallocate(void* ptr) noexcept
+{
+    if (!ptr) return;
+
+    // Read the header.
+    const auto header = reinterpret_cast<const in_alloc_header*>(
+        static_cast<u8*>(ptr) - sizeof(in_alloc_header));
+
+    const std::size_t size = static_cast<std::size_t>(header->info & in_alloc_max_size);
+    const auto subsystem = static_cast<memory_subsystem>((header->info >> 48) & 0xFF);
+    const std::size_t alignment = (static_cast<std::size_t>(1) << (header->info >> 56));
+    const std::size_t headerSpace = in_get_header_space(alignment);
+
+    // Free the block using the allocator it was allocated with.
+    header->alloc->deallocate(static_cast<u8*>(ptr) - headerSpace,
+        size + headerSpace, in_get_block_alignment(alignment), subsystem);
+
+    // Record the deallocation.
+    in_record_dealloc(subsystem, size);
+}
+
+void* allocate_sized(allocator& alloc, std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem)
+{
+    const auto ptr = alloc.allocate(size, alignment, subsystem);
+    in_record_alloc(subsystem, size);
+    return ptr;
+}
+
+void deallocate_sized(allocator& alloc, void* ptr, std::size_t size,
+    std::size_t alignment, memory_subsystem subsystem) noexcept
+{
+    if (!ptr) return;
+
+    alloc.deallocate(ptr, size, alignment, subsystem);
+    in_record_dealloc(subsystem, size);
+}
+} // hl
@@ -8,7 +8,7 @@ blob& blob::operator=(const blob& other)
 {
     if (&other != this)
     {
-        std::unique_ptr<u8[]> newData(new u8[other.m_size]);
+        auto newData = make_unique_buffer(other.m_size, memory_subsystem::blob);
         std::memcpy(newData.get(), other.m_data.get(), other.m_size);
 
         m_data = std::move(newData);
@@ -32,7 +32,7 @@ blob& blob::operator=(blob&& other) noexcept
 }
 
 blob::blob(std::size_t size, const void* initialData) :
-    m_data(new u8[size]),
+    m_data(make_unique_buffer(size, memory_subsystem::blob)),
     m_size(size)
 {
     // Copy initial data into blob, if any.
@@ -46,7 +46,7 @@ blob::blob(const nchar* filePath) :
     m_data(std::move(file::load(filePath, &m_size))) {}
 
 blob::blob(const blob& other) :
-    m_data(new u8[other.m_size]),
+    m_data(make_unique_buffer(other.m_size, memory_subsystem::blob)),
     m_size(other.m_size)
 {
     // Copy data from other blob into this blob.
@@ -1,5 +1,6 @@
 #include "hl_in_blob.h"
 #include "hedgelib/hl_compression.h"
+#include "hedgelib/hl_trace.h"
 #include <lz4.h>
 #define ZLIB_CONST
 #include <zlib.h>
@@ -64,6 +65,8 @@ static void in_none_decompress_no_alloc(std::size_t srcSize,
 void decompress_no_alloc(compress_type type, std::size_t srcSize,
     const void* src, std::size_t dstSize, void* dst)
 {
+    HL_TRACE_ZONE("decompress");
+
     switch (type)
     {
     case compress_type::none:
@@ -85,10 +88,10 @@ void decompress_no_alloc(compress_type type, std::size_t srcSize,
     }
 }
 
-std::unique_ptr<u8[]> decompress(compress_type type,
+unique_buffer decompress(compress_type type,
     std::size_t srcSize, const void* src, std::size_t dstSize)
 {
-    std::unique_ptr<u8[]> dst(new u8[dstSize]);
+    auto dst = make_unique_buffer(dstSize, memory_subsystem::compression);
     decompress_no_alloc(type, srcSize, src, dstSize, dst.get());
     return dst;
 }
@@ -212,6 +215,8 @@ std::size_t compress_no_alloc(compress_type type,
     std::size_t srcSize, const void* src,
     std::size_t dstBufSize, void* dst)
 {
+    HL_TRACE_ZONE("compress");
+
     switch (type)
     {
     case compress_type::none:
@@ -230,12 +235,12 @@ std::size_t compress_no_alloc(compress_type type,
     }
 }
 
-std::unique_ptr<u8[]> compress(compress_type type,
+unique_buffer compress(compress_type type,
     std::size_t srcSize, const void* src, std::size_t& dstSize)
 {
     // Allocate buffer big enough to hold compressed data.
     const std::size_t dstBufSize = compress_bound(type, srcSize);
-    std::unique_ptr<u8[]> dst(new u8[dstBufSize]);
+    auto dst = make_unique_buffer(dstBufSize, memory_subsystem::compression);
 
     // Compress data.
     dstSize = compress_no_alloc(type, srcSize, src, dstBufSize, dst.get());
@@ -0,0 +1,311 @@
+#include "hedgelib/hl_internal.h"
+#include <cstring>
+
+namespace hl
+{
+#ifdef HL_IN_HAS_X86_INTRINSICS
+#if defined(__GNUC__) || defined(__clang__)
+#define HL_IN_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define HL_IN_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HL_IN_TARGET_SSSE3
+#define HL_IN_TARGET_AVX2
+#endif
+
+enum class in_simd_level
+{
+    none,
+    ssse3,
+    avx2
+};
+
+static in_simd_level in_detect_simd_level() noexcept
+{
+#ifdef _MSC_VER
+    int cpuInfo[4];
+    __cpuid(cpuInfo, 0);
+
+    const int maxLeaf = cpuInfo[0];
+    if (maxLeaf < 1) return in_simd_level::none;
+
+    // Check for AVX2 support (including OS support for saving the YMM registers).
+    __cpuid(cpuInfo, 1);
+    const bool hasSSSE3 = ((cpuInfo[2] & (1 << 9)) != 0);
+    const bool hasOSXSAVE = ((cpuInfo[2] & (1 << 27)) != 0);
+    const bool hasAVX = ((cpuInfo[2] & (1 << 28)) != 0);
+
+    if (hasOSXSAVE && hasAVX && maxLeaf >= 7 && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(cpuInfo, 7, 0);
+        if ((cpuInfo[1] & (1 << 5)) != 0)
+        {
+            return in_simd_level::avx2;
+        }
+    }
+
+    // Check for SSSE3 support.
+    return (hasSSSE3) ? in_simd_level::ssse3 : in_simd_level::none;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return in_simd_level::avx2;
+    if (__builtin_cpu_supports("ssse3")) return in_simd_level::ssse3;
+    return in_simd_level::none;
+#endif
+}
+
+static in_simd_level in_get_simd_level() noexcept
+{
+    static const in_simd_level simdLevel = in_detect_simd_level();
+    return simdLevel;
+}
+
+/** @brief pshufb masks which swap every u16, u32, or u64 within 32 bytes. */
+alignas(32) static const u8 in_swap_masks[3][32] =
+{
+    {
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+    },
+    {
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+    },
+    {
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+    }
+};
+
+template<typename T>
+static const u8* in_get_swap_mask() noexcept
+{
+    if constexpr (sizeof(T) == 2)
+        return in_swap_masks[0];
+    else if constexpr (sizeof(T) == 4)
+        return in_swap_masks[1];
+    else
+        return in_swap_masks[2];
+}
+
+HL_IN_TARGET_SSSE3 static std::size_t in_swap_bytes_ssse3(
+    u8* data, std::size_t size, const u8* maskPtr) noexcept
+{
+    const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(maskPtr));
+    std::size_t i = 0;
+
+    // Swap 64 bytes at a time.
+    for (; (i + 64) <= size; i += 64)
+    {
+        const auto ptr = reinterpret_cast<__m128i*>(data + i);
+        const __m128i a = _mm_loadu_si128(ptr);
+        const __m128i b = _mm_loadu_si128(ptr + 1);
+        const __m128i c = _mm_loadu_si128(ptr + 2);
+        const __m128i d = _mm_loadu_si128(ptr + 3);
+
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(a, mask));
+        _mm_storeu_si128(ptr + 1, _mm_shuffle_epi8(b, mask));
+        _mm_storeu_si128(ptr + 2, _mm_shuffle_epi8(c, mask));
+        _mm_storeu_si128(ptr + 3, _mm_shuffle_epi8(d, mask));
+    }
+
+    // Swap 16 bytes at a time.
+    for (; (i + 16) <= size; i += 16)
+    {
+        const auto ptr = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask));
+    }
+
+    // Return how many bytes were swapped.
+    return i;
+}
+
+HL_IN_TARGET_AVX2 static std::size_t in_swap_bytes_avx2(
+    u8* data, std::size_t size, const u8* maskPtr) noexcept
+{
+    const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(maskPtr));
+    std::size_t i = 0;
+
+    // Swap 128 bytes at a time.
+    for (; (i + 128) <= size; i += 128)
+    {
+        const auto ptr = reinterpret_cast<__m256i*>(data + i);
+        const __m256i a = _mm256_loadu_si256(ptr);
+        const __m256i b = _mm256_loadu_si256(ptr + 1);
+        const __m256i c = _mm256_loadu_si256(ptr + 2);
+        const __m256i d = _mm256_loadu_si256(ptr + 3);
+
+        _mm256_storeu_si256(ptr, _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(ptr + 1, _mm256_shuffle_epi8(b, mask));
+        _mm256_storeu_si256(ptr + 2, _mm256_shuffle_epi8(c, mask));
+        _mm256_storeu_si256(ptr + 3, _mm256_shuffle_epi8(d, mask));
+    }
+
+    // Swap 32 bytes at a time.
+    for (; (i + 32) <= size; i += 32)
+    {
+        const auto ptr = reinterpret_cast<__m256i*>(data + i);
+        _mm256_storeu_si256(ptr, _mm256_shuffle_epi8(_mm256_loadu_si256(ptr), mask));
+    }
+
+    // Swap the remaining 16 bytes, if any, with SSSE3.
+    if ((i + 16) <= size)
+    {
+        const auto ptr = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr),
+            _mm_load_si128(reinterpret_cast<const __m128i*>(maskPtr))));
+
+        i += 16;
+    }
+
+    // Return how many bytes were swapped.
+    return i;
+}
+
+HL_IN_TARGET_SSSE3 static void in_swap_records_ssse3(u8* data,
+    std::size_t periodCount, std::size_t periodSize, const u8* masks) noexcept
+{
+    for (std::size_t i = 0; i < periodCount; ++i)
+    {
+        for (std::size_t i2 = 0; i2 < periodSize; i2 += 16)
+        {
+            const auto ptr = reinterpret_cast<__m128i*>(data + i2);
+            const __m128i mask = _mm_load_si128(
+                reinterpret_cast<const __m128i*>(masks + i2));
+
+            _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask));
+        }
+
+        data += periodSize;
+    }
+}
+#endif
+
+template<typename T>
+static void in_endian_swap_array(T* values, std::size_t count) noexcept
+{
+    std::size_t i = 0;
+
+#ifdef HL_IN_HAS_X86_INTRINSICS
+    // Swap as many values as we can using SIMD instructions.
+    switch (in_get_simd_level())
+    {
+    case in_simd_level::avx2:
+        i = (in_swap_bytes_avx2(reinterpret_cast<u8*>(values),
+            count * sizeof(T), in_get_swap_mask<T>()) / sizeof(T));
+        break;
+
+    case in_simd_level::ssse3:
+        i = (in_swap_bytes_ssse3(reinterpret_cast<u8*>(values),
+            count * sizeof(T), in_get_swap_mask<T>()) / sizeof(T));
+        break;
+
+    default:
+        break;
+    }
+#endif
+
+    // Swap any remaining values one at a time.
+    for (; i < count; ++i)
+    {
+        endian_swap(values[i]);
+    }
+}
+
+void endian_swap_array(u16* values, std::size_t count) noexcept
+{
+    in_endian_swap_array(values, count);
+}
+
+void endian_swap_array(u32* values, std::size_t count) noexcept
+{
+    in_endian_swap_array(values, count);
+}
+
+void endian_swap_array(u64* values, std::size_t count) noexcept
+{
+    in_endian_swap_array(values, count);
+}
+
+static void in_swap_records_scalar(u8* data, std::size_t recordCount,
+    std::size_t recordSize, const u8* pattern) noexcept
+{
+    u8 tmpRecord[endian_swap_max_record_size];
+    for (std::size_t i = 0; i < recordCount; ++i)
+    {
+        std::memcpy(tmpRecord, data, recordSize);
+        for (std::size_t i2 = 0; i2 < recordSize; ++i2)
+        {
+            data[i2] = tmpRecord[pattern[i2]];
+        }
+
+        data += recordSize;
+    }
+}
+
+#ifdef HL_IN_HAS_X86_INTRINSICS
+static std::size_t in_gcd(std::size_t a, std::size_t b) noexcept
+{
+    while (b != 0)
+    {
+        const std::size_t tmp = (a % b);
+        a = b;
+        b = tmp;
+    }
+
+    return a;
+}
+
+static bool in_make_record_masks(std::size_t recordSize,
+    const u8* pattern, std::size_t periodSize, u8* masks) noexcept
+{
+    // Generate a pshufb mask for every 16 bytes within the period.
+    for (std::size_t i = 0; i < periodSize; ++i)
+    {
+        const std::size_t recordPos = (i - (i % recordSize));
+        const std::size_t srcPos = (recordPos + pattern[i % recordSize]);
+
+        // pshufb can't move bytes across 16-byte boundaries.
+        if ((srcPos / 16) != (i / 16))
+        {
+            return false;
+        }
+
+        masks[i] = static_cast<u8>(srcPos % 16);
+    }
+
+    return true;
+}
+#endif
+
+void endian_swap_records(void* records, std::size_t recordCount,
+    std::size_t recordSize, const u8* pattern) noexcept
+{
+    if (recordSize == 0) return;
+
+    auto data = static_cast<u8*>(records);
+
+#ifdef HL_IN_HAS_X86_INTRINSICS
+    // NOTE: The pattern repeats every lcm(recordSize, 16) bytes, so we generate
+    // that many bytes' worth of pshufb masks, and apply them over and over again.
+    const std::size_t periodSize = ((recordSize / in_gcd(recordSize, 16)) * 16);
+    const std::size_t periodRecordCount = (periodSize / recordSize);
+
+    if (recordCount >= periodRecordCount &&
+        in_get_simd_level() >= in_simd_level::ssse3)
+    {
+        alignas(16) u8 masks[endian_swap_max_record_size * 16];
+        if (in_make_record_masks(recordSize, pattern, periodSize, masks))
+        {
+            const std::size_t periodCount = (recordCount / periodRecordCount);
+            in_swap_records_ssse3(data, periodCount, periodSize, masks);
+
+            data += (periodCount * periodSize);
+            recordCount -= (periodCount * periodRecordCount);
+        }
+    }
+#endif
+
+    // Swap any remaining records one at a time.
+    in_swap_records_scalar(data, recordCount, recordSize, pattern);
+}
+} // hl
@@ -0,0 +1,96 @@
+#ifndef HL_IN_PARALLEL_H_INCLUDED
+#define HL_IN_PARALLEL_H_INCLUDED
+#include "hedgelib/hl_internal.h"
+#include <atomic>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace hl
+{
+/**
+    @brief Calls func(i) for every i within [0, count), spreading these
+    calls across all available hardware threads (including the calling
+    thread), and returns once all of them have finished.
+
+    If any call throws an exception, calls which haven't started yet are
+    skipped, and the exception is re-thrown on the calling thread once every
+    thread has finished. func must be safe to call concurrently with
+    different indices.
+*/
+template<typename func_t>
+void in_parallel_for(std::size_t count, func_t func)
+{
+    // Determine how many threads to use.
+    std::size_t threadCount = static_cast<std::size_t>(
+        std::thread::hardware_concurrency());
+
+    if (threadCount > count) threadCount = count;
+
+    // Just call func on this thread if using more threads wouldn't help.
+    if (threadCount <= 1)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+
+        return;
+    }
+
+    // Setup worker function.
+    std::atomic<std::size_t> nextIndex(0);
+    std::atomic<bool> failed(false);
+    std::vector<std::exception_ptr> exceptions(threadCount);
+
+    const auto worker = [&](std::size_t threadIndex)
+    {
+        try
+        {
+            while (!failed.load(std::memory_order_relaxed))
+            {
+                const std::size_t i = nextIndex.fetch_add(1,
+                    std::memory_order_relaxed);
+
+                if (i >= count) break;
+                func(i);
+            }
+        }
+        catch (...)
+        {
+            exceptions[threadIndex] = std::current_exception();
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    // Start worker threads.
+    // (NOTE: If a thread can't be started, we just make do with the ones we have.)
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+
+    try
+    {
+        for (std::size_t i = 1; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker, i);
+        }
+    }
+    catch (const std::system_error&) {}
+
+    // Do work on this thread as well, then wait for the other threads to finish.
+    worker(0);
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Re-throw the first exception that was thrown, if any.
+    for (auto& exception : exceptions)
+    {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+} // hl
+#endif
@@ -15,6 +15,14 @@
 #define HL_IN_HAS_SSE2
 #endif
 
+// x86 SIMD Intrinsics (SSSE3, AVX2, etc.)
+// NOTE: These are only used within functions compiled for those instruction
+// sets specifically, after checking the CPU supports them at runtime.
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+#include <immintrin.h>
+#define HL_IN_HAS_X86_INTRINSICS
+#endif
+
 #endif
 
 // Standard library
@@ -1,4 +1,5 @@
 #include "hedgelib/hl_radix_tree.h"
+#include "hedgelib/hl_allocator.h"
 #include "hedgelib/hl_text.h"
 #include <cstring>
 #include <cassert>
@@ -7,11 +8,205 @@ namespace hl
 {
 namespace internal
 {
+/**
+    @brief A simple bump allocator for radix tree nodes and leaves. Memory is only
+    returned once the whole arena is released, except for nodes which were replaced
+    by larger nodes, which are kept in per-type free lists and re-used.
+*/
+class in_radix_arena
+{
+    struct in_block
+    {
+        in_block* prev;
+    };
+
+    constexpr static std::size_t in_block_header_size = align(
+        sizeof(in_block), alignof(std::max_align_t));
+
+    constexpr static std::size_t in_min_block_size = 1024;
+    constexpr static std::size_t in_max_block_size = 262144;
+
+    in_block* m_lastBlock = nullptr;
+    u8* m_cur = nullptr;
+    u8* m_end = nullptr;
+    std::size_t m_nextBlockSize = in_min_block_size;
+    std::array<void*, 4> m_freeNodes = {};
+
+    inline static std::size_t in_get_free_list_index(in_radix_node_type type) noexcept
+    {
+        return (static_cast<std::size_t>(type) >> 6);
+    }
+
+public:
+    void* alloc(std::size_t size)
+    {
+        // Keep every allocation aligned just like hl::allocate would.
+        size = align(size, alignof(std::max_align_t));
+
+        // Allocate a new block if there isn't enough space left in the current one.
+        if (size > static_cast<std::size_t>(m_end - m_cur))
+        {
+            const auto blockSize = std::max(m_nextBlockSize,
+                in_block_header_size + size);
+
+            const auto block = static_cast<in_block*>(hl::allocate(
+                blockSize, memory_subsystem::radix_tree));
+
+            block->prev = m_lastBlock;
+            m_lastBlock = block;
+
+            m_cur = ptradd<u8>(block, in_block_header_size);
+            m_end = ptradd<u8>(block, blockSize);
+
+            if (m_nextBlockSize < in_max_block_size)
+            {
+                m_nextBlockSize *= 2;
+            }
+        }
+
+        // Bump-allocate the requested memory.
+        const auto ptr = m_cur;
+        m_cur += size;
+        return ptr;
+    }
+
+    void* alloc_node(in_radix_node_type type, std::size_t size)
+    {
+        // Re-use a freed node of the same type if possible.
+        auto& freeNode = m_freeNodes[in_get_free_list_index(type)];
+        if (freeNode)
+        {
+            const auto node = freeNode;
+            freeNode = *static_cast<void**>(node);
+            return node;
+        }
+
+        // Otherwise, allocate a new node.
+        return alloc(size);
+    }
+
+    void free_node(in_radix_node_type type, void* node) noexcept
+    {
+        auto& freeNode = m_freeNodes[in_get_free_list_index(type)];
+        *static_cast<void**>(node) = freeNode;
+        freeNode = node;
+    }
+
+    void release() noexcept
+    {
+        while (m_lastBlock)
+        {
+            const auto prevBlock = m_lastBlock->prev;
+            hl::deallocate(m_lastBlock);
+            m_lastBlock = prevBlock;
+        }
+
+        m_cur = nullptr;
+        m_end = nullptr;
+        m_nextBlockSize = in_min_block_size;
+        m_freeNodes.fill(nullptr);
+    }
+
+    in_radix_arena() noexcept = default;
+
+    in_radix_arena(const in_radix_arena& other) = delete;
+
+    inline ~in_radix_arena()
+    {
+        release();
+    }
+};
+
+template<typename T>
+constexpr in_radix_node_type in_radix_get_node_type() noexcept
+{
+    if constexpr (std::is_same_v<T, in_radix_node4>)
+        return in_radix_node_type::node4;
+    else if constexpr (std::is_same_v<T, in_radix_node16>)
+        return in_radix_node_type::node16;
+    else if constexpr (std::is_same_v<T, in_radix_node48>)
+        return in_radix_node_type::node48;
+    else
+        return in_radix_node_type::node256;
+}
+
+template<typename T, typename... args_t>
+static T* in_radix_new_node(in_radix_arena* arena, const args_t&... args)
+{
+    if (!arena)
+    {
+        return new (hl::allocate(sizeof(T), alignof(T),
+            memory_subsystem::radix_tree)) T(args...);
+    }
+
+    return new (arena->alloc_node(in_radix_get_node_type<T>(),
+        sizeof(T))) T(args...);
+}
+
+template<typename T>
+static void in_radix_free_node(T* node) noexcept
+{
+    node->~T();
+    hl::deallocate(node);
+}
+
+static void in_radix_delete_node(in_radix_arena* arena, in_radix_node* node) noexcept
+{
+    if (arena)
+    {
+        arena->free_node(node->type(), node);
+        return;
+    }
+
+    switch (node->type())
+    {
+    case in_radix_node_type::node4:
+        in_radix_free_node(static_cast<in_radix_node4*>(node));
+        break;
+
+    case in_radix_node_type::node16:
+        in_radix_free_node(static_cast<in_radix_node16*>(node));
+        break;
+
+    case in_radix_node_type::node48:
+        in_radix_free_node(static_cast<in_radix_node48*>(node));
+        break;
+
+    case in_radix_node_type::node256:
+        in_radix_free_node(static_cast<in_radix_node256*>(node));
+        break;
+    }
+}
+
+struct in_radix_node_deleter
+{
+    in_radix_arena* arena;
+
+    inline void operator()(in_radix_node* node) const noexcept
+    {
+        in_radix_delete_node(arena, node);
+    }
+};
+
+template<typename T>
+using in_radix_node_unique_ptr = std::unique_ptr<T, in_radix_node_deleter>;
+
+template<typename T, typename... args_t>
+static in_radix_node_unique_ptr<T> in_radix_make_node(
+    in_radix_arena* arena, const args_t&... args)
+{
+    return in_radix_node_unique_ptr<T>(in_radix_new_node<T>(arena, args...),
+        in_radix_node_deleter{ arena });
+}
+
 struct in_radix_leaf_deleter
 {
+    in_radix_arena* arena;
+
     inline void operator()(in_radix_leaf* leaf) const
     {
-        ::operator delete(leaf);
+        // NOTE: Arena-allocated leaves are freed along with the arena.
+        if (!arena) hl::deallocate(leaf);
     }
 };
 
@@ -103,7 +298,7 @@ void in_radix_node::destroy() noexcept
     // Delete leaf nodes.
     if (is_leaf())
     {
-        ::operator delete(this);
+        hl::deallocate(this);
         return;
     }
 
@@ -118,7 +313,7 @@ void in_radix_node::destroy() noexcept
             static_cast<in_radix_node*>(node4->children[i])->destroy();
         }
 
-        delete node4;
+        in_radix_free_node(node4);
         break;
     }
 
@@ -130,7 +325,7 @@ void in_radix_node::destroy() noexcept
             static_cast<in_radix_node*>(node16->children[i])->destroy();
         }
 
-        delete node16;
+        in_radix_free_node(node16);
         break;
     }
 
@@ -142,7 +337,7 @@ void in_radix_node::destroy() noexcept
             if (child) static_cast<in_radix_node*>(child)->destroy();
         }
 
-        delete node48;
+        in_radix_free_node(node48);
         break;
     }
 
@@ -154,7 +349,7 @@ void in_radix_node::destroy() noexcept
             if (child) static_cast<in_radix_node*>(child)->destroy();
         }
 
-        delete node256;
+        in_radix_free_node(node256);
         break;
     }
     }
@@ -239,8 +434,8 @@ in_radix_node256::in_radix_node256(const in_radix_node48& node48) noexcept :
     }
 }
 
-in_radix_leaf* in_radix_leaf::create(std::size_t size,
-    std::size_t index, const char* key)
+in_radix_leaf* in_radix_leaf::create(in_radix_arena* arena,
+    std::size_t size, std::size_t index, const char* key)
 {
     // Get key length.
     const auto keyLen = std::strlen(key);
@@ -250,8 +445,9 @@ in_radix_leaf* in_radix_leaf::create(std::size_t size,
         "The given key was too long!");
 
     // Allocate leaf node memory.
-    const auto leaf = static_cast<in_radix_leaf*>(
-        ::operator new(size + keyLen + 1));
+    const auto leaf = static_cast<in_radix_leaf*>((arena) ?
+        arena->alloc(size + keyLen + 1) :
+        hl::allocate(size + keyLen + 1, memory_subsystem::radix_tree));
 
     // Set node type, key length, and leaf index.
     leaf->type = UINT8_MAX;
@@ -270,7 +466,7 @@ in_radix_tree::in_iterator in_radix_tree::in_add_leaf(in_radix_leaf& leaf)
     return in_get_leaf_it(leafNodeIndex);
 }
 
-static void in_add_child_node(void** nodePtrPtr,
+static void in_add_child_node(void** nodePtrPtr, in_radix_arena* arena,
     in_radix_sort_func sortFuncPtr, u8 key, void* child)
 {
     assert(!static_cast<in_radix_node*>(*nodePtrPtr)->is_leaf() &&
@@ -305,19 +501,18 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node16 from existing node4.
-            auto node16 = std::unique_ptr<in_radix_node16>(
-                new in_radix_node16(*node4));
+            auto node16 = in_radix_make_node<in_radix_node16>(arena, *node4);
 
             // Add child to the new node16.
             void* node16Ptr = node16.get();
-            in_add_child_node(&node16Ptr, sortFuncPtr, key, child);
+            in_add_child_node(&node16Ptr, arena, sortFuncPtr, key, child);
             node16.release();
 
             // Set the node pointer to the new node16.
             *nodePtrPtr = node16Ptr;
 
             // Delete the existing node4.
-            delete node4;
+            in_radix_delete_node(arena, node4);
         }
 
         break;
@@ -352,8 +547,7 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node48 from existing node16.
-            auto node48 = std::unique_ptr<in_radix_node48>(
-                new in_radix_node48(*node16));
+            auto node48 = in_radix_make_node<in_radix_node48>(arena, *node16);
 
             // Add child to the new node48.
             node48->set_child_unchecked(16, key, child);
@@ -363,7 +557,7 @@ static void in_add_child_node(void** nodePtrPtr,
             *nodePtrPtr = node48.release();
 
             // Delete the existing node16.
-            delete node16;
+            in_radix_delete_node(arena, node16);
         }
 
         break;
@@ -386,14 +580,13 @@ static void in_add_child_node(void** nodePtrPtr,
         else
         {
             // Create new node256 from existing node48.
-            auto node256 = std::unique_ptr<in_radix_node256>(
-                new in_radix_node256(*node48));
+            auto node256 = in_radix_make_node<in_radix_node256>(arena, *node48);
 
             // Add child to the new node256.
             node256->children[key] = child;
 
             // Delete the existing node48.
-            delete node48;
+            in_radix_delete_node(arena, node48);
 
             // Set the node pointer to the new node256.
             *nodePtrPtr = node256.release();
@@ -411,13 +604,13 @@ static void in_add_child_node(void** nodePtrPtr,
     }
 }
 
-static std::unique_ptr<in_radix_node4> in_create_expanded_node(
-    in_radix_sort_func sortFuncPtr,
+static in_radix_node_unique_ptr<in_radix_node4> in_create_expanded_node(
+    in_radix_arena* arena, in_radix_sort_func sortFuncPtr,
     const char* key, const char* leafKey,
     in_radix_leaf& leaf, in_radix_leaf& newLeaf)
 {
     // Create new node4.
-    auto newNodePtr = std::unique_ptr<in_radix_node4>(new in_radix_node4());
+    auto newNodePtr = in_radix_make_node<in_radix_node4>(arena);
 
     // Setup new node prefix.
     auto newPrefix = newNodePtr->prefix.begin();
@@ -452,7 +645,7 @@ static std::unique_ptr<in_radix_node4> in_create_expanded_node(
     {
         assert(*key);
 
-        auto childNodePtr = in_create_expanded_node(sortFuncPtr,
+        auto childNodePtr = in_create_expanded_node(arena, sortFuncPtr,
             key + 1, leafKey + 1, leaf, newLeaf);
 
         newNodePtr->set_child_unchecked(0, *key, childNodePtr.release());
@@ -488,10 +681,10 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
             // Create a new leaf node.
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                m_arena, leafSize, m_leafNodes.size(), key), { m_arena });
 
             // Create a new expanded node.
-            auto newNodePtr = in_create_expanded_node(m_sortFuncPtr,
+            auto newNodePtr = in_create_expanded_node(m_arena, m_sortFuncPtr,
                 keySlice, leafKeySlice, leaf, *newLeaf);
 
             // Add new leaf to tree, update existing node pointer, and return new leaf iterator.
@@ -506,7 +699,7 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
         if (prefixMatchLen != node.prefixLen)
         {
             // Create a new node4.
-            std::unique_ptr<in_radix_node4> newNodePtr(new in_radix_node4());
+            auto newNodePtr = in_radix_make_node<in_radix_node4>(m_arena);
 
             // Setup new node prefix.
             char* oldPrefix = node.prefix.data();
@@ -525,7 +718,7 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
             // Create a new leaf node.
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                m_arena, leafSize, m_leafNodes.size(), key), { m_arena });
 
             // Add children to new node in the correct sorting order.
             const char newFirstCh = keySlice[0];
@@ -558,9 +751,10 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
         if (!nextNodePtrPtr)
         {
             in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-                leafSize, m_leafNodes.size(), key));
+                m_arena, leafSize, m_leafNodes.size(), key), { m_arena });
 
-            in_add_child_node(nodePtrPtr, m_sortFuncPtr, *keySlice, newLeaf.get());
+            in_add_child_node(nodePtrPtr, m_arena, m_sortFuncPtr,
+                *keySlice, newLeaf.get());
             const auto newLeafIt = in_add_leaf(*newLeaf);
             newLeaf.release();
 
@@ -580,7 +774,7 @@ std::pair<in_radix_tree::in_iterator, bool> in_radix_tree::in_insert(
 
     // Add new leaf to tree, update existing node pointer, and return new leaf iterator.
     in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
-        leafSize, m_leafNodes.size(), key));
+        m_arena, leafSize, m_leafNodes.size(), key), { m_arena });
 
     const auto newLeafIt = in_add_leaf(*newLeaf);
     *nodePtrPtr = newLeaf.release();
@@ -622,12 +816,315 @@ const in_radix_leaf* in_radix_tree::in_find_leaf(
     return nullptr;
 }
 
-void in_radix_tree::in_destroy() noexcept
+static int in_radix_compare_keys(in_radix_sort_func sortFuncPtr,
+    const char* key1, const char* key2) noexcept
 {
-    if (m_rootNode)
+    for (; *key1 == *key2 && *key1; ++key1, ++key2) {}
+
+    return sortFuncPtr(static_cast<unsigned char>(*key1),
+        static_cast<unsigned char>(*key2));
+}
+
+static void in_radix_free_inner_nodes(in_radix_arena* arena, void* nodePtr) noexcept
+{
+    auto& node = *static_cast<in_radix_node*>(nodePtr);
+    if (node.is_leaf()) return;
+
+    // Recursively free child nodes (but not leaves).
+    switch (node.type())
+    {
+    case in_radix_node_type::node4:
+    {
+        const auto& node4 = static_cast<const in_radix_node4&>(node);
+        for (u8 i = 0; i < node4.small_node_child_count(); ++i)
+        {
+            in_radix_free_inner_nodes(arena, node4.children[i]);
+        }
+
+        break;
+    }
+
+    case in_radix_node_type::node16:
+    {
+        const auto& node16 = static_cast<const in_radix_node16&>(node);
+        for (u8 i = 0; i < node16.small_node_child_count(); ++i)
+        {
+            in_radix_free_inner_nodes(arena, node16.children[i]);
+        }
+
+        break;
+    }
+
+    case in_radix_node_type::node48:
+    {
+        for (auto child : static_cast<const in_radix_node48&>(node).children)
+        {
+            if (child) in_radix_free_inner_nodes(arena, child);
+        }
+
+        break;
+    }
+
+    case in_radix_node_type::node256:
+    {
+        for (auto child : static_cast<const in_radix_node256&>(node).children)
+        {
+            if (child) in_radix_free_inner_nodes(arena, child);
+        }
+
+        break;
+    }
+    }
+
+    // Free the node itself.
+    in_radix_delete_node(arena, &node);
+}
+
+static in_radix_node* in_radix_create_node(in_radix_arena* arena,
+    std::size_t childCount)
+{
+    if (childCount <= 4)
+    {
+        return in_radix_new_node<in_radix_node4>(arena);
+    }
+    else if (childCount <= 16)
+    {
+        return in_radix_new_node<in_radix_node16>(arena);
+    }
+    else if (childCount <= 48)
+    {
+        return in_radix_new_node<in_radix_node48>(arena);
+    }
+    else
+    {
+        return in_radix_new_node<in_radix_node256>(arena);
+    }
+}
+
+static void in_radix_add_built_child(in_radix_node& node, u8 key, void* child) noexcept
+{
+    switch (node.type())
+    {
+    case in_radix_node_type::node4:
+    {
+        auto& node4 = static_cast<in_radix_node4&>(node);
+        node4.set_child_unchecked(node4.small_node_child_count(), key, child);
+        ++node4.flags;
+        break;
+    }
+
+    case in_radix_node_type::node16:
+    {
+        auto& node16 = static_cast<in_radix_node16&>(node);
+        node16.set_child_unchecked(node16.small_node_child_count(), key, child);
+        ++node16.flags;
+        break;
+    }
+
+    case in_radix_node_type::node48:
+    {
+        auto& node48 = static_cast<in_radix_node48&>(node);
+        node48.set_child_unchecked(node48.small_node_child_count(), key, child);
+        ++node48.flags;
+        break;
+    }
+
+    case in_radix_node_type::node256:
+        static_cast<in_radix_node256&>(node).children[key] = child;
+        break;
+    }
+}
+
+static void* in_radix_build_node(in_radix_arena* arena,
+    in_radix_leaf* const* leaves, std::size_t leafCount,
+    std::size_t leafSize, std::size_t depth)
+{
+    // Just use the leaf directly if there's only one.
+    if (leafCount == 1) return leaves[0];
+
+    // Get the prefix shared by all of the given keys (up to the maximum prefix length).
+    // NOTE: Since the keys are unique and sorted, this is just the prefix
+    // shared by the first and last keys, and it never includes the null terminator.
+    const auto firstKey = (ptradd<char>(leaves[0], leafSize) + depth);
+    const auto lastKey = (ptradd<char>(leaves[leafCount - 1], leafSize) + depth);
+    u8 prefixLen = 0;
+
+    while (prefixLen < in_radix_max_prefix_len &&
+        firstKey[prefixLen] == lastKey[prefixLen])
+    {
+        ++prefixLen;
+    }
+
+    // Count the children of the new node; one for each distinct character
+    // after the prefix. Keys which start with the same character are contiguous.
+    const auto childDepth = (depth + prefixLen);
+    std::size_t childCount = 1;
+
+    for (std::size_t i = 1; i < leafCount; ++i)
+    {
+        if (ptradd<char>(leaves[i], leafSize)[childDepth] !=
+            ptradd<char>(leaves[i - 1], leafSize)[childDepth])
+        {
+            ++childCount;
+        }
+    }
+
+    // Create a node of the smallest type which can fit all of the children.
+    const auto node = in_radix_create_node(arena, childCount);
+    node->prefixLen = prefixLen;
+    std::memcpy(node->prefix.data(), firstKey, prefixLen);
+
+    // Recursively build the children, and add them to the node in sorted order.
+    try
+    {
+        std::size_t childBegin = 0;
+        for (std::size_t i = 1; i <= leafCount; ++i)
+        {
+            const char childKey = ptradd<char>(
+                leaves[childBegin], leafSize)[childDepth];
+
+            if (i < leafCount && ptradd<char>(
+                leaves[i], leafSize)[childDepth] == childKey)
+            {
+                continue;
+            }
+
+            const auto child = in_radix_build_node(arena, leaves + childBegin,
+                i - childBegin, leafSize, childDepth + 1);
+
+            in_radix_add_built_child(*node, static_cast<u8>(childKey), child);
+            childBegin = i;
+        }
+    }
+    catch (...)
+    {
+        in_radix_free_inner_nodes(arena, node);
+        throw;
+    }
+
+    return node;
+}
+
+static void* in_radix_build_tree(in_radix_arena* arena,
+    in_radix_sort_func sortFuncPtr, in_radix_leaf* const* leaves,
+    std::size_t leafCount, std::size_t leafSize)
+{
+    // Ensure the keys are unique and sorted.
+    for (std::size_t i = 1; i < leafCount; ++i)
+    {
+        if (in_radix_compare_keys(sortFuncPtr,
+            ptradd<char>(leaves[i - 1], leafSize),
+            ptradd<char>(leaves[i], leafSize)) >= 0)
+        {
+            throw invalid_arg_exception("leaves");
+        }
+    }
+
+    // Build the tree's nodes.
+    return (leafCount) ? in_radix_build_node(arena,
+        leaves, leafCount, leafSize, 0) : nullptr;
+}
+
+in_radix_leaf& in_radix_tree::in_add_unlinked_leaf(
+    const char* key, std::size_t leafSize)
+{
+    assert(!m_rootNode && "Unlinked leaves can only be added before building the nodes!");
+
+    in_radix_leaf_unique_ptr newLeaf(in_radix_leaf::create(
+        m_arena, leafSize, m_leafNodes.size(), key), { m_arena });
+
+    in_add_leaf(*newLeaf);
+    return *newLeaf.release();
+}
+
+void in_radix_tree::in_remove_last_unlinked_leaf() noexcept
+{
+    in_radix_leaf_deleter{ m_arena }(m_leafNodes.back());
+    m_leafNodes.pop_back();
+}
+
+void in_radix_tree::in_destroy_unlinked_leaves() noexcept
+{
+    if (m_arena)
+    {
+        m_arena->release();
+    }
+    else
+    {
+        for (auto leaf : m_leafNodes)
+        {
+            hl::deallocate(leaf);
+        }
+    }
+
+    m_leafNodes.clear();
+}
+
+void in_radix_tree::in_link_sorted_leaves(std::size_t leafSize)
+{
+    assert(!m_rootNode && "The nodes have already been built!");
+
+    m_rootNode = in_radix_build_tree(m_arena, m_sortFuncPtr,
+        m_leafNodes.data(), m_leafNodes.size(), leafSize);
+}
+
+void in_radix_tree::in_link_leaves(std::size_t leafSize)
+{
+    assert(!m_rootNode && "The nodes have already been built!");
+
+    // Sort a copy of the leaf list by key.
+    std::vector<in_radix_leaf*> sortedLeaves(m_leafNodes);
+    std::sort(sortedLeaves.begin(), sortedLeaves.end(),
+        [sortFuncPtr = m_sortFuncPtr, leafSize](
+            const in_radix_leaf* a, const in_radix_leaf* b)
+        {
+            return (in_radix_compare_keys(sortFuncPtr,
+                ptradd<char>(a, leafSize), ptradd<char>(b, leafSize)) < 0);
+        });
+
+    // Build the tree's nodes from the sorted leaves.
+    m_rootNode = in_radix_build_tree(m_arena, m_sortFuncPtr,
+        sortedLeaves.data(), sortedLeaves.size(), leafSize);
+}
+
+void in_radix_tree::in_set_arena_enabled(bool enabled)
+{
+    assert(!m_rootNode && m_leafNodes.empty() &&
+        "The tree must be empty to change how it allocates memory!");
+
+    if (enabled && !m_arena)
+    {
+        m_arena = new in_radix_arena();
+    }
+    else if (!enabled && m_arena)
+    {
+        delete m_arena;
+        m_arena = nullptr;
+    }
+}
+
+void in_radix_tree::in_clear() noexcept
+{
+    // Free all nodes and leaves.
+    // NOTE: Arena-allocated nodes and leaves are all freed at once by releasing the arena.
+    if (m_arena)
+    {
+        m_arena->release();
+    }
+    else if (m_rootNode)
     {
         static_cast<in_radix_node*>(m_rootNode)->destroy();
     }
+
+    m_rootNode = nullptr;
+    m_leafNodes.clear();
+}
+
+void in_radix_tree::in_destroy() noexcept
+{
+    in_clear();
+    delete m_arena;
+    m_arena = nullptr;
 }
 
 in_radix_tree& in_radix_tree::operator=(in_radix_tree&& other) noexcept
@@ -639,8 +1136,10 @@ in_radix_tree& in_radix_tree::operator=(in_radix_tree&& other) noexcept
         m_rootNode = other.m_rootNode;
         m_sortFuncPtr = other.m_sortFuncPtr;
         m_leafNodes = std::move(other.m_leafNodes);
+        m_arena = other.m_arena;
         
         other.m_rootNode = nullptr;
+        other.m_arena = nullptr;
     }
     
     return *this;
@@ -652,9 +1151,11 @@ in_radix_tree::in_radix_tree() noexcept :
 in_radix_tree::in_radix_tree(in_radix_tree&& other) noexcept :
     m_rootNode(other.m_rootNode),
     m_sortFuncPtr(other.m_sortFuncPtr),
-    m_leafNodes(std::move(other.m_leafNodes))
+    m_leafNodes(std::move(other.m_leafNodes)),
+    m_arena(other.m_arena)
 {
     other.m_rootNode = nullptr;
+    other.m_arena = nullptr;
 }
 } // internal
 } // hl
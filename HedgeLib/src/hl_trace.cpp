@@ -0,0 +1,208 @@
+#include "hedgelib/hl_trace.h"
+#include "hedgelib/io/hl_file.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hl
+{
+namespace trace
+{
+struct in_zone
+{
+    const char* name;
+    u64 startTime;
+    u64 endTime;
+};
+
+struct in_thread_buffer
+{
+    std::mutex mutex;
+    std::vector<in_zone> zones;
+    u32 threadID;
+
+    inline in_thread_buffer(u32 threadID) :
+        threadID(threadID) {}
+};
+
+// NOTE: Thread buffers are owned by this list rather than by their threads,
+// so zones recorded on worker threads outlive those threads.
+static std::mutex in_thread_buffers_mutex;
+static std::vector<std::unique_ptr<in_thread_buffer>> in_thread_buffers;
+/** @brief Buffers whose threads have exited, which new threads can reuse. */
+static std::vector<in_thread_buffer*> in_free_thread_buffers;
+static std::atomic<bool> in_is_running(false);
+static const auto in_epoch = std::chrono::steady_clock::now();
+
+struct in_thread_buffer_owner
+{
+    in_thread_buffer* buffer = nullptr;
+
+    ~in_thread_buffer_owner()
+    {
+        // Return this thread's buffer to the free list so it can be reused, rather
+        // than allocating a new one for every thread (e.g. in_parallel_for workers).
+        if (buffer)
+        {
+            std::lock_guard<std::mutex> lock(in_thread_buffers_mutex);
+            in_free_thread_buffers.push_back(buffer);
+        }
+    }
+};
+
+static in_thread_buffer& in_get_thread_buffer()
+{
+    thread_local in_thread_buffer_owner threadBufferOwner;
+    if (!threadBufferOwner.buffer)
+    {
+        std::lock_guard<std::mutex> lock(in_thread_buffers_mutex);
+        if (!in_free_thread_buffers.empty())
+        {
+            // Reuse the buffer of a thread which has exited.
+            // NOTE: Any zones it still contains are kept, so they can still be written.
+            threadBufferOwner.buffer = in_free_thread_buffers.back();
+            in_free_thread_buffers.pop_back();
+        }
+        else
+        {
+            in_thread_buffers.emplace_back(new in_thread_buffer(
+                static_cast<u32>(in_thread_buffers.size() + 1)));
+
+            threadBufferOwner.buffer = in_thread_buffers.back().get();
+        }
+    }
+
+    return *threadBufferOwner.buffer;
+}
+
+void start()
+{
+    clear();
+    in_is_running.store(true, std::memory_order_release);
+}
+
+void stop() noexcept
+{
+    in_is_running.store(false, std::memory_order_release);
+}
+
+bool is_running() noexcept
+{
+    return in_is_running.load(std::memory_order_relaxed);
+}
+
+void clear()
+{
+    std::lock_guard<std::mutex> lock(in_thread_buffers_mutex);
+    for (auto& threadBuffer : in_thread_buffers)
+    {
+        std::lock_guard<std::mutex> bufLock(threadBuffer->mutex);
+        threadBuffer->zones.clear();
+    }
+}
+
+static void in_write_json_str(const char* str, std::string& json)
+{
+    json += '"';
+    for (; *str != '\0'; ++str)
+    {
+        const unsigned char c = static_cast<unsigned char>(*str);
+        if (c == '"' || c == '\\')
+        {
+            json += '\\';
+            json += static_cast<char>(c);
+        }
+        else if (c < 0x20)
+        {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned int>(c));
+            json += buf;
+        }
+        else
+        {
+            json += static_cast<char>(c);
+        }
+    }
+
+    json += '"';
+}
+
+static void in_write_json_time(u64 time, std::string& json)
+{
+    // NOTE: Chrome traces store times in microseconds; we store nanoseconds.
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03u",
+        static_cast<unsigned long long>(time / 1000),
+        static_cast<unsigned int>(time % 1000));
+
+    json += buf;
+}
+
+void write(stream& stream)
+{
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool isFirstEvent = true;
+
+    {
+        std::lock_guard<std::mutex> lock(in_thread_buffers_mutex);
+        for (auto& threadBuffer : in_thread_buffers)
+        {
+            std::lock_guard<std::mutex> bufLock(threadBuffer->mutex);
+            if (threadBuffer->zones.empty()) continue;
+
+            const std::string tid = std::to_string(threadBuffer->threadID);
+
+            // Write thread name metadata event.
+            if (!isFirstEvent) json += ',';
+            isFirstEvent = false;
+
+            json += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            json += tid;
+            json += ",\"args\":{\"name\":\"Thread ";
+            json += tid;
+            json += "\"}}";
+
+            // Write complete events for each zone.
+            for (const auto& zone : threadBuffer->zones)
+            {
+                json += ",\n{\"name\":";
+                in_write_json_str(zone.name, json);
+                json += ",\"cat\":\"hedgelib\",\"ph\":\"X\",\"ts\":";
+                in_write_json_time(zone.startTime, json);
+                json += ",\"dur\":";
+                in_write_json_time(zone.endTime - zone.startTime, json);
+                json += ",\"pid\":1,\"tid\":";
+                json += tid;
+                json += '}';
+            }
+        }
+    }
+
+    json += "\n]}\n";
+    stream.write_all(json.size(), json.data());
+}
+
+void save(const nchar* filePath)
+{
+    file_stream file(filePath, file::mode::write);
+    write(file);
+}
+
+u64 in_get_time() noexcept
+{
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - in_epoch).count());
+}
+
+void in_add_zone(const char* name, u64 startTime, u64 endTime)
+{
+    auto& threadBuffer = in_get_thread_buffer();
+    std::lock_guard<std::mutex> lock(threadBuffer.mutex);
+    threadBuffer.zones.push_back({ name, startTime, endTime });
+}
+} // trace
+} // hl
@@ -52,15 +52,64 @@ void pac_pack_meta::fix(void* rawData, endian_flag endianFlag)
     }
 }
 
+static const char in_pac_pack_meta_sig[] = "PACPACK_METADATA";
+
 const pac_pack_meta* get_pac_pack_meta(const void* rawData, std::size_t dataSize)
 {
+    // Return early if the data is too small to contain PACPACK_METADATA.
+    if (dataSize <= sizeof(pac_pack_meta)) return nullptr;
+
+    // (NOTE: The signature may begin anywhere before this pointer.)
     const u8* curDataPtr = static_cast<const u8*>(rawData);
-    const u8* endDataPtr = (curDataPtr + dataSize);
+    const u8* endDataPtr = (curDataPtr + (dataSize - sizeof(pac_pack_meta)));
+
+#ifdef HL_IN_HAS_SSE2
+    // Search 16 possible signature positions at a time for the first and last
+    // characters of "PACPACK_METADATA", and only compare the entire signature
+    // at positions where both of those characters match.
+    const __m128i firstChar = _mm_set1_epi8('P');
+    const __m128i lastChar = _mm_set1_epi8('A');
+
+    // (NOTE: The last character load reads up to curDataPtr + 30, which is
+    // safe as there are always at least 20 bytes after endDataPtr.)
+    while ((endDataPtr - curDataPtr) >= 16)
+    {
+        const __m128i firstBlock = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(curDataPtr));
+
+        const __m128i lastBlock = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(curDataPtr + 15));
+
+        unsigned int bitmask = static_cast<unsigned int>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(firstBlock, firstChar),
+            _mm_cmpeq_epi8(lastBlock, lastChar))));
+
+        while (bitmask)
+        {
+            const u8* sigPtr = (curDataPtr + bit_ctz(bitmask));
+            if (std::memcmp(sigPtr, in_pac_pack_meta_sig, 16) == 0)
+            {
+                return reinterpret_cast<const pac_pack_meta*>(sigPtr);
+            }
+
+            // Clear the lowest set bit.
+            bitmask &= (bitmask - 1);
+        }
+
+        curDataPtr += 16;
+    }
+#endif
 
-    // Search file for "PACPACK_METADATA" and return pointer if found.
-    while ((curDataPtr + sizeof(pac_pack_meta)) < endDataPtr)
+    // Search the remaining data for the first character of "PACPACK_METADATA"
+    // with memchr, and only compare the entire signature where it matches.
+    while (curDataPtr < endDataPtr)
     {
-        if (std::memcmp(curDataPtr, "PACPACK_METADATA", 16) == 0)
+        curDataPtr = static_cast<const u8*>(std::memchr(curDataPtr,
+            'P', static_cast<std::size_t>(endDataPtr - curDataPtr)));
+
+        if (!curDataPtr) break;
+
+        if (std::memcmp(curDataPtr, in_pac_pack_meta_sig, 16) == 0)
         {
             return reinterpret_cast<const pac_pack_meta*>(curDataPtr);
         }
@@ -445,6 +494,13 @@ endian_flag fix_container(void* rawData)
 
     return oldEndianFlag;
 }
+
+data_view get_data_view(const void* rawData) noexcept
+{
+    // NOTE: Offsets within the data are relative to the data, not the header.
+    const auto headerPtr = static_cast<const raw_header*>(rawData);
+    return data_view(headerPtr->data(), needs_swap(headerPtr->endianFlag));
+}
 } // v1
 
 namespace v2
@@ -764,6 +820,37 @@ endian_flag fix_container64(void* rawData)
     return oldEndianFlag;
 }
 
+data_view get_data_view(const void* rawData)
+{
+    const auto headerPtr = static_cast<const raw_header*>(rawData);
+    const bool swap = needs_swap(headerPtr->endianFlag);
+    const data_view header(rawData, swap);
+
+    // Find the data block.
+    const u16 blockCount = header.read<u16>(offsetof(raw_header, blockCount));
+    data_view block = header.at(sizeof(raw_header));
+
+    for (u16 i = 0; i < blockCount; ++i)
+    {
+        // Return a view of the data within the data block.
+        // NOTE: Offsets within the data are relative to the data, not the header.
+        if (block.get<raw_block_header>()->signature ==
+            static_cast<u32>(raw_block_type::data))
+        {
+            const u16 relDataOff = block.read<u16>(offsetof(
+                raw_data_block_header, relativeDataOffset));
+
+            return data_view(block.at(sizeof(raw_data_block_header) +
+                relDataOff).get(), swap);
+        }
+
+        // Go to the next block.
+        block = block.at(block.read<u32>(offsetof(raw_block_header, size)));
+    }
+
+    return data_view();
+}
+
 void writer32::start(bina::endian_flag endianFlag, ver version)
 {
     // Store header position and endian flag.
@@ -1,5 +1,6 @@
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/hl_blob.h"
+#include "hedgelib/hl_trace.h"
 
 #ifdef _WIN32
 #include "../hl_in_win32.h"
@@ -16,8 +17,10 @@ namespace hl
 {
 namespace file
 {
-std::unique_ptr<u8[]> load(const nchar* filePath, std::size_t* dataSize)
+unique_buffer load(const nchar* filePath, std::size_t* dataSize)
 {
+    HL_TRACE_ZONE("file::load");
+
     // Open a stream to the file at the given file path.
     file_stream file(filePath, mode::read);
 
@@ -25,7 +28,7 @@ std::unique_ptr<u8[]> load(const nchar* filePath, std::size_t* dataSize)
     const auto fileSize = file.get_size();
 
     // Allocate a buffer large enough to hold the entire contents of the file.
-    std::unique_ptr<u8[]> data(new u8[fileSize]);
+    auto data = make_unique_buffer(fileSize, memory_subsystem::file);
 
     // Read all bytes from the file into the buffer.
     file.read_all(fileSize, data.get());
@@ -41,6 +44,8 @@ std::unique_ptr<u8[]> load(const nchar* filePath, std::size_t* dataSize)
 
 void save(const void* data, std::size_t dataSize, const nchar* filePath)
 {
+    HL_TRACE_ZONE("file::save");
+
     // Open the file at the given file path, creating it if it doesn't yet exist.
     file_stream file(filePath, mode::write);
 
@@ -305,6 +310,82 @@ std::size_t file_stream::get_size()
 #endif
 }
 
+std::size_t file_stream::read_at(std::size_t pos, std::size_t size, void* buf)
+{
+#ifdef _WIN32
+    // Ensure size can fit within a DWORD before casting to one.
+    if (size > ULONG_MAX)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Read the given number of bytes from the given position within the file.
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(
+        static_cast<unsigned long long>(pos) & 0xFFFFFFFFULL);
+
+    overlapped.OffsetHigh = static_cast<DWORD>(
+        static_cast<unsigned long long>(pos) >> 32);
+
+    DWORD readBytes = 0;
+    const auto succeeded = ReadFile(reinterpret_cast<HANDLE>(m_handle),
+        buf, static_cast<DWORD>(size), &readBytes, &overlapped);
+
+    // Throw an exception if we encountered an error.
+    // (NOTE: Reading past the end of the file is not an error; it just reads 0 bytes.)
+    if (!succeeded && GetLastError() != ERROR_HANDLE_EOF)
+    {
+        throw in_win32_get_last_exception();
+    }
+
+    // Restore the file pointer, as ReadFile moves it even when given an offset.
+    // (NOTE: Concurrent read_at calls only ever restore it to the same m_curPos
+    // value, so the file pointer is still correct once all of them have returned.)
+    LARGE_INTEGER lcurPos;
+    lcurPos.QuadPart = static_cast<LONGLONG>(m_curPos);
+
+    if (!SetFilePointerEx(reinterpret_cast<HANDLE>(m_handle),
+        lcurPos, NULL, FILE_BEGIN))
+    {
+        throw in_win32_get_last_exception();
+    }
+
+    // Return read byte count.
+    return static_cast<std::size_t>(readBytes);
+#else
+    // Ensure size can fit within a ssize_t before casting to one.
+    if (size > SSIZE_MAX)
+    {
+        throw out_of_range_exception();
+    }
+
+    // Read the given number of bytes from the given position within the file.
+    // (NOTE: pread doesn't use or modify the file offset, so this is thread-safe.)
+    std::size_t totalReadBytes = 0;
+    while (totalReadBytes < size)
+    {
+        const auto readBytes = ::pread(static_cast<int>(m_handle),
+            static_cast<u8*>(buf) + totalReadBytes,
+            size - totalReadBytes,
+            static_cast<off_t>(pos + totalReadBytes));
+
+        // Throw an exception if we encountered an error.
+        if (readBytes == -1)
+        {
+            throw in_posix_get_last_exception();
+        }
+
+        // Stop once we've reached the end of the file.
+        if (readBytes == 0) break;
+
+        totalReadBytes += static_cast<std::size_t>(readBytes);
+    }
+
+    // Return read byte count.
+    return totalReadBytes;
+#endif
+}
+
 file_stream::~file_stream()
 {
     close();
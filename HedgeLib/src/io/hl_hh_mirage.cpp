@@ -8,6 +8,12 @@ namespace hh
 {
 namespace mirage
 {
+#ifdef HL_IS_BIG_ENDIAN
+constexpr bool in_view_needs_swap = false;
+#else
+constexpr bool in_view_needs_swap = true;
+#endif
+
 namespace standard
 {
 const_off_table_handle raw_header::offsets() const noexcept
@@ -114,6 +120,20 @@ void raw_header::finish_write(std::size_t headerPos,
         stream.pad(4);
     }
 }
+data_view get_data_view(const void* rawData, u32* version) noexcept
+{
+    // Get version number if requested.
+    const data_view header(rawData, in_view_needs_swap);
+    if (version)
+    {
+        *version = header.read<u32>(offsetof(raw_header, version));
+    }
+
+    // Get data view and return it.
+    // NOTE: Offsets within the data are relative to the data, not the header.
+    const data_view data = header.deref32(offsetof(raw_header, data));
+    return data_view(data.get(), in_view_needs_swap);
+}
 } // standard
 
 namespace sample_chunk
@@ -256,6 +276,72 @@ void raw_header::fix()
     }
 }
 
+static u32 in_view_get_node_flags(const raw_node* node) noexcept
+{
+    return data_view(node, in_view_needs_swap).read<u32>(
+        offsetof(raw_node, flags));
+}
+
+static const raw_node* in_view_get_child(const raw_node* curNode,
+    const char* name, bool recursive) noexcept
+{
+    while (curNode)
+    {
+        // Check the current node's name and return if we've found a match.
+        if (std::strncmp(curNode->name, name, 8) == 0)
+        {
+            return curNode;
+        }
+
+        // If recursion is allowed and this node has children, recurse through them.
+        const u32 flags = in_view_get_node_flags(curNode);
+        if (recursive && (flags & static_cast<u32>(node_flags::is_leaf)) == 0)
+        {
+            const raw_node* childMatch = in_view_get_child(
+                curNode + 1, name, recursive);
+
+            if (childMatch) return childMatch;
+        }
+
+        // Get the next node.
+        curNode = ((flags & static_cast<u32>(node_flags::is_last_or_root)) != 0) ?
+            nullptr : ptradd<raw_node>(curNode, flags &
+                static_cast<u32>(node_flags::size_mask));
+    }
+
+    return nullptr;
+}
+
+data_view get_data_view(const void* rawData, u32* version)
+{
+    // Return a null view if this sample chunk header has no nodes.
+    const auto header = static_cast<const raw_header*>(rawData);
+    if ((in_view_get_node_flags(reinterpret_cast<const raw_node*>(
+        header)) & static_cast<u32>(node_flags::is_leaf)) != 0)
+    {
+        return data_view();
+    }
+
+    // Get contexts node; return a null view if there was none.
+    char nameBuf[9];
+    make_node_name("Contexts", nameBuf);
+
+    const auto nodesPtr = reinterpret_cast<const raw_node*>(header + 1);
+    const raw_node* contextsNode = in_view_get_child(nodesPtr, nameBuf, true);
+    if (!contextsNode) return data_view();
+
+    // Get version number if requested.
+    if (version)
+    {
+        *version = data_view(contextsNode, in_view_needs_swap).read<u32>(
+            offsetof(raw_node, value));
+    }
+
+    // Get data view and return it.
+    // NOTE: Offsets within the data are relative to the nodes, not the header.
+    return data_view(nodesPtr, contextsNode->data(), in_view_needs_swap);
+}
+
 void raw_header::start_write(stream& stream)
 {
     // Write placeholder HH sample chunk header.
@@ -363,16 +449,23 @@ void fix(void* rawData)
     }
 }
 
+data_view get_data_view(const void* rawData, u32* version)
+{
+    return (has_sample_chunk_header_unfixed(rawData)) ?
+        sample_chunk::get_data_view(rawData, version) :
+        standard::get_data_view(rawData, version);
+}
+
 void offsets_fix(off_table_handle offsets, void* base)
 {
-    // Fix all the offsets in the offset table.
-    for (auto& relOffPos : offsets)
-    {
-        // Endian swap offset position if necessary.
+    // Endian swap all offset positions in one go if necessary.
 #ifndef HL_IS_BIG_ENDIAN
-        hl::endian_swap(relOffPos);
+    endian_swap_array(offsets.off_table(), offsets.off_count());
 #endif
 
+    // Fix all the offsets in the offset table.
+    for (auto relOffPos : offsets)
+    {
         // Get pointer to current offset.
         off32<void>* curOff = ptradd<off32<void>>(base, relOffPos);
 
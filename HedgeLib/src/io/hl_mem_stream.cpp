@@ -96,6 +96,20 @@ std::size_t readonly_mem_stream::get_size()
     return m_dataSize;
 }
 
+std::size_t readonly_mem_stream::read_at(std::size_t pos,
+    std::size_t size, void* buf)
+{
+    // Return early if the given position is past the end of the stream.
+    if (pos >= m_dataSize) return 0;
+
+    // Copy as many bytes as we safely can into the given buffer.
+    const std::size_t readBytes = std::min(size, m_dataSize - pos);
+    std::memcpy(buf, m_handle + pos, readBytes);
+
+    // Return read byte count.
+    return readBytes;
+}
+
 readonly_mem_stream::~readonly_mem_stream() {}
 
 void mem_stream::in_grow(std::size_t reqCap)
@@ -109,14 +123,14 @@ void mem_stream::in_grow(std::size_t reqCap)
     newDataCap = hl::align(newDataCap, 1024);
 
     // Allocate new data buffer.
-    std::unique_ptr<u8[]> newDataBuf(new u8[newDataCap]);
+    auto newDataBuf = make_unique_buffer(newDataCap, memory_subsystem::stream);
     u8* dataBuf = const_cast<u8*>(m_handle);
     
     // Copy existing data into new buffer.
     std::memcpy(newDataBuf.get(), dataBuf, m_dataSize);
 
     // Free existing data buffer.
-    delete[] dataBuf;
+    hl::deallocate(dataBuf);
 
     // Set new buffer pointer and capacity.
     m_handle = newDataBuf.release();
@@ -163,7 +177,7 @@ void* mem_stream::release() noexcept
     u8* ptr = const_cast<u8*>(m_handle);
 
     // Reset the memory stream.
-    m_curPos = m_dataSize = 0;
+    m_curPos = m_dataSize = m_dataCap = 0;
     m_handle = nullptr;
 
     // Return data pointer; it is now the user's responsibility to free it.
@@ -177,8 +191,9 @@ void mem_stream::close()
     if (!dataBuf) return;
 
     // Free data and set m_handle to null so we can detect it on any subsequent calls to close.
-    delete[] dataBuf;
+    hl::deallocate(dataBuf);
     m_handle = nullptr;
+    m_curPos = m_dataSize = m_dataCap = 0;
 }
     
 void mem_stream::reopen() noexcept
@@ -214,7 +229,8 @@ void mem_stream::reopen(const void* initialData,
 }
 
 mem_stream::mem_stream(const void* initialData, std::size_t initialDataSize) :
-    readonly_mem_stream(new u8[initialDataSize], initialDataSize),
+    readonly_mem_stream(hl::allocate(initialDataSize,
+        memory_subsystem::stream), initialDataSize),
     m_dataCap(initialDataSize)
 {
     // Copy initial data into internal data buffer.
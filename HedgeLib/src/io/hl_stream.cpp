@@ -15,6 +15,28 @@ void stream::read_all(std::size_t size, void* buf)
     }
 }
 
+std::size_t stream::read_at(std::size_t pos, std::size_t size, void* buf)
+{
+    // Jump to the given position, read, and jump back.
+    const std::size_t prevPos = m_curPos;
+    jump_to(pos);
+
+    const std::size_t readByteCount = read(size, buf);
+    jump_to(prevPos);
+
+    return readByteCount;
+}
+
+void stream::read_all_at(std::size_t pos, std::size_t size, void* buf)
+{
+    const std::size_t readByteCount = read_at(pos, size, buf);
+    if (readByteCount != size)
+    {
+        // TODO: Throw a better error?
+        throw unknown_exception();
+    }
+}
+
 void stream::write_all(std::size_t size, const void* buf)
 {
     const std::size_t writtenByteCount = write(size, buf);
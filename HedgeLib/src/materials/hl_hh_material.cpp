@@ -116,7 +116,7 @@ void material::in_parse(const raw_material_v1& rawMat, const nchar* texsetDir)
     else
     {
         texset = mirage::texset();
-        texset.name = texsetName;
+        if (texsetName) texset.name = texsetName;
     }
 }
 
@@ -0,0 +1,309 @@
+#include "hedgelib/materials/hl_hh_res_cache.h"
+#include "hedgelib/archives/hl_archive.h"
+#include "hedgelib/io/hl_path.h"
+#include "hedgelib/hl_blob.h"
+#include "../hl_in_parallel.h"
+
+namespace hl
+{
+namespace hh
+{
+namespace mirage
+{
+void res_cache::in_add_arc_entries(const archive_entry_list& arc)
+{
+    for (auto& entry : arc)
+    {
+        if (entry.is_dir())
+        {
+            in_add_arc_entries(entry.dir_entries());
+        }
+        else if (entry.is_regular_file())
+        {
+            // NOTE: We purposely don't overwrite existing entries here, so
+            // that the archives which were added first take priority.
+            m_arcEntries.insert(std::make_pair(
+#ifdef HL_IN_WIN32_UNICODE
+                text::conv<text::native_to_utf8>(entry.name()),
+#else
+                std::string(entry.name()),
+#endif
+                &entry));
+        }
+    }
+}
+
+std::unique_ptr<blob> res_cache::in_load(const std::string& name, const nchar* ext) const
+{
+    // Get file name.
+    nstring fileName =
+#ifdef HL_IN_WIN32_UNICODE
+        text::conv<text::utf8_to_native>(name);
+#else
+        name;
+#endif
+
+    fileName += ext;
+
+    // Look for the file within the added archives.
+    if (!m_arcEntries.empty())
+    {
+        const auto it = m_arcEntries.find(
+#ifdef HL_IN_WIN32_UNICODE
+            text::conv<text::native_to_utf8>(fileName));
+#else
+            fileName);
+#endif
+
+        if (it != m_arcEntries.end())
+        {
+            const archive_entry& entry = *it->second;
+
+            // NOTE: We copy the data, as fixing it would modify the archive.
+            return std::unique_ptr<blob>((entry.is_reference_file()) ?
+                new blob(entry.path()) :
+                new blob(entry.size(), entry.file_data()));
+        }
+    }
+
+    // Look for the file within the added directories.
+    for (auto& dir : m_dirs)
+    {
+        const nstring filePath = path::combine(dir, fileName);
+        if (path::exists(filePath))
+        {
+            return std::unique_ptr<blob>(new blob(filePath));
+        }
+    }
+
+    return nullptr;
+}
+
+void res_cache::add_dir(const nchar* dir)
+{
+    m_dirs.emplace_back(dir);
+}
+
+void res_cache::add_archive(const archive_entry_list& arc)
+{
+    in_add_arc_entries(arc);
+}
+
+static bool in_res_needs_deps(const blob& rawMat, const material*)
+{
+    // NOTE: Only material v1 references a separate texset; v3 stores its texture entries itself.
+    u32 version = 0;
+    get_data(rawMat, &version);
+    return (version == 1);
+}
+
+static bool in_res_needs_deps(const blob& /*rawTexset*/, const texset*)
+{
+    return true;
+}
+
+static bool in_res_needs_deps(const blob& /*rawTexEntry*/, const texture_entry*)
+{
+    return false;
+}
+
+template<typename T>
+res_cache::in_loaded_res<T> res_cache::in_load_res(const std::string& name) const
+{
+    // NOTE: This function doesn't modify the cache, so it's safe to call concurrently.
+    in_loaded_res<T> loadedRes;
+    auto rawData = in_load(name, T::ext);
+    if (!rawData) return loadedRes;
+
+    T::fix(*rawData);
+    loadedRes.res.reset(new T(rawData->data(), name));
+    loadedRes.needsDeps = in_res_needs_deps(*rawData, loadedRes.res.get());
+
+    return loadedRes;
+}
+
+template<typename T>
+T* res_cache::in_get(res_map<T>& resMap, const std::string& name)
+{
+    // Return the resource if it's already within the cache.
+    auto it = resMap.find(name);
+    if (it != resMap.end())
+    {
+        ++m_hitCount;
+        return it->second.get();
+    }
+
+    // Otherwise, load it.
+    // NOTE: We only add it to the cache once it has been loaded successfully, so
+    // resources which couldn't be found or loaded aren't treated as cache hits later.
+    auto loadedRes = in_load_res<T>(name);
+    if (!loadedRes.res) return nullptr;
+
+    ++m_loadCount;
+    T* res = loadedRes.res.get();
+    resMap[name] = std::move(loadedRes.res);
+
+    if (loadedRes.needsDeps)
+    {
+        in_resolve_deps(*res);
+    }
+
+    return res;
+}
+
+template<typename T>
+std::vector<T*> res_cache::in_preload(res_map<T>& resMap,
+    const std::vector<std::string>& names)
+{
+    // Get the names of the resources which aren't already within the cache.
+    // (NOTE: We add placeholders for them, so duplicate names are only loaded once.)
+    std::vector<const std::string*> namesToLoad;
+    for (auto& name : names)
+    {
+        if (resMap.insert(std::make_pair(name, std::unique_ptr<T>())).second)
+        {
+            namesToLoad.push_back(&name);
+        }
+    }
+
+    // Load and parse resources in parallel.
+    std::vector<in_loaded_res<T>> loadedRes(namesToLoad.size());
+    try
+    {
+        in_parallel_for(namesToLoad.size(), [&](std::size_t i)
+        {
+            loadedRes[i] = in_load_res<T>(*namesToLoad[i]);
+        });
+    }
+    catch (...)
+    {
+        // Remove the placeholders, so they aren't treated as cache hits later.
+        for (auto name : namesToLoad)
+        {
+            resMap.erase(*name);
+        }
+
+        throw;
+    }
+
+    // Add the resources to the cache in order, and return the ones
+    // whose dependencies still need to be resolved.
+    std::vector<T*> resWithDeps;
+    for (std::size_t i = 0; i < namesToLoad.size(); ++i)
+    {
+        if (!loadedRes[i].res)
+        {
+            // Remove the placeholder for this resource, as it couldn't be found.
+            resMap.erase(*namesToLoad[i]);
+            continue;
+        }
+
+        ++m_loadCount;
+        if (loadedRes[i].needsDeps)
+        {
+            resWithDeps.push_back(loadedRes[i].res.get());
+        }
+
+        resMap[*namesToLoad[i]] = std::move(loadedRes[i].res);
+    }
+
+    return resWithDeps;
+}
+
+void res_cache::in_resolve_deps(material& mat)
+{
+    if (mat.texset.name.empty()) return;
+
+    if (const auto tset = get_texset(mat.texset.name))
+    {
+        mat.texset = *tset;
+    }
+}
+
+void res_cache::in_resolve_deps(texset& tset)
+{
+    for (auto& texEntry : tset)
+    {
+        if (const auto cachedTexEntry = get_texture_entry(texEntry.name))
+        {
+            texEntry = *cachedTexEntry;
+        }
+    }
+}
+
+material* res_cache::get_material(const std::string& name)
+{
+    return in_get(m_materials, name);
+}
+
+texset* res_cache::get_texset(const std::string& name)
+{
+    return in_get(m_texsets, name);
+}
+
+texture_entry* res_cache::get_texture_entry(const std::string& name)
+{
+    return in_get(m_texEntries, name);
+}
+
+void res_cache::preload_materials(const std::vector<std::string>& names)
+{
+    // Load materials.
+    const auto mats = in_preload(m_materials, names);
+
+    // Load the materials' texsets.
+    std::vector<std::string> texsetNames;
+    for (auto mat : mats)
+    {
+        if (!mat->texset.name.empty())
+        {
+            texsetNames.push_back(mat->texset.name);
+        }
+    }
+
+    const auto texsets = in_preload(m_texsets, texsetNames);
+
+    // Load the texsets' texture entries.
+    std::vector<std::string> texEntryNames;
+    for (auto tset : texsets)
+    {
+        for (auto& texEntry : *tset)
+        {
+            texEntryNames.push_back(texEntry.name);
+        }
+    }
+
+    in_preload(m_texEntries, texEntryNames);
+
+    // Resolve dependencies, which are all within the cache by now.
+    for (auto tset : texsets)
+    {
+        in_resolve_deps(*tset);
+    }
+
+    for (auto mat : mats)
+    {
+        in_resolve_deps(*mat);
+    }
+}
+
+bool res_cache::resolve(res_ref<material>& ref)
+{
+    if (ref.has_res()) return true;
+
+    const auto mat = get_material(ref.name());
+    if (!mat) return false;
+
+    ref = *mat;
+    return true;
+}
+
+void res_cache::clear() noexcept
+{
+    m_materials.clear();
+    m_texsets.clear();
+    m_texEntries.clear();
+}
+} // mirage
+} // hh
+} // hl
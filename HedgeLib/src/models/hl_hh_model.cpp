@@ -1,14 +1,17 @@
 #include "hedgelib/models/hl_hh_model.h"
 #include "hedgelib/materials/hl_hh_material.h"
+#include "hedgelib/materials/hl_hh_res_cache.h"
 #include "hedgelib/hh/hl_hh_needle.h"
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_path.h"
 #include "hedgelib/hl_blob.h"
+#include "hedgelib/hl_trace.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include <algorithm>
 #include <cstring>
 
 namespace hl
@@ -773,25 +776,30 @@ void raw_vertex_element::convert_to_ivec4(const void* vtx, ivec4& ivec) const
     }
 }
 
-static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
+static void in_get_vertex_swap_words(raw_vertex_format format,
+    u32& wordSize, u32& wordCount)
 {
-    // Swap vertex based on vertex element.
-    switch (rawVtxElem.format)
+    // Get the size and count of the words which make up vertex elements of the given format.
+    switch (format)
     {
     case raw_vertex_format::float1:
-        endian_swap(*static_cast<float*>(rawVtx));
+        wordSize = 4;
+        wordCount = 1;
         break;
 
     case raw_vertex_format::float2:
-        endian_swap(*static_cast<vec2*>(rawVtx));
+        wordSize = 4;
+        wordCount = 2;
         break;
 
     case raw_vertex_format::float3:
-        endian_swap(*static_cast<vec3*>(rawVtx));
+        wordSize = 4;
+        wordCount = 3;
         break;
 
     case raw_vertex_format::float4:
-        endian_swap(*static_cast<vec4*>(rawVtx));
+        wordSize = 4;
+        wordCount = 4;
         break;
 
     case raw_vertex_format::int1:
@@ -815,32 +823,32 @@ static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
     case raw_vertex_format::dhen3:
     case raw_vertex_format::udhen3_norm:
     case raw_vertex_format::dhen3_norm:
-        endian_swap(*static_cast<u32*>(rawVtx));
+        wordSize = 4;
+        wordCount = 1;
         break;
 
     case raw_vertex_format::int2:
     case raw_vertex_format::int2_norm:
     case raw_vertex_format::uint2:
     case raw_vertex_format::uint2_norm:
-        endian_swap(*(static_cast<u32*>(rawVtx)));
-        endian_swap(*(static_cast<u32*>(rawVtx) + 1));
+        wordSize = 4;
+        wordCount = 2;
         break;
 
     case raw_vertex_format::int4:
     case raw_vertex_format::int4_norm:
     case raw_vertex_format::uint4:
     case raw_vertex_format::uint4_norm:
-        endian_swap(*(static_cast<u32*>(rawVtx)));
-        endian_swap(*(static_cast<u32*>(rawVtx) + 1));
-        endian_swap(*(static_cast<u32*>(rawVtx) + 2));
-        endian_swap(*(static_cast<u32*>(rawVtx) + 3));
+        wordSize = 4;
+        wordCount = 4;
         break;
 
     case raw_vertex_format::ubyte4:
     case raw_vertex_format::byte4:
     case raw_vertex_format::ubyte4_norm:
     case raw_vertex_format::byte4_norm:
-        endian_swap(*static_cast<u32*>(rawVtx));
+        wordSize = 4;
+        wordCount = 1;
         break;
 
     case raw_vertex_format::short2:
@@ -848,8 +856,8 @@ static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
     case raw_vertex_format::ushort2:
     case raw_vertex_format::ushort2_norm:
     case raw_vertex_format::float16_2:
-        endian_swap(*(static_cast<u16*>(rawVtx)));
-        endian_swap(*(static_cast<u16*>(rawVtx) + 1));
+        wordSize = 2;
+        wordCount = 2;
         break;
 
     case raw_vertex_format::short4:
@@ -857,10 +865,8 @@ static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
     case raw_vertex_format::ushort4:
     case raw_vertex_format::ushort4_norm:
     case raw_vertex_format::float16_4:
-        endian_swap(*(static_cast<u16*>(rawVtx)));
-        endian_swap(*(static_cast<u16*>(rawVtx) + 1));
-        endian_swap(*(static_cast<u16*>(rawVtx) + 2));
-        endian_swap(*(static_cast<u16*>(rawVtx) + 3));
+        wordSize = 2;
+        wordCount = 4;
         break;
 
     default:
@@ -868,6 +874,78 @@ static void in_swap_vertex(const raw_vertex_element& rawVtxElem, void* rawVtx)
     }
 }
 
+static void in_swap_vertex_words(void* rawVtx, u32 wordSize, u32 wordCount) noexcept
+{
+    if (wordSize == 2)
+    {
+        endian_swap_array(static_cast<u16*>(rawVtx), wordCount);
+    }
+    else
+    {
+        endian_swap_array(static_cast<u32*>(rawVtx), wordCount);
+    }
+}
+
+static void in_swap_vertices(const raw_vertex_element* rawVtxElems,
+    u32 vertexCount, u32 vertexSize, void* rawVertices)
+{
+    // Generate a pattern describing how to swap a single vertex.
+    u8 pattern[endian_swap_max_record_size];
+    const bool canUsePattern = (vertexSize <= endian_swap_max_record_size);
+
+    if (canUsePattern)
+    {
+        for (u32 i = 0; i < vertexSize; ++i)
+        {
+            pattern[i] = static_cast<u8>(i);
+        }
+    }
+
+    for (auto curVtxElem = rawVtxElems; curVtxElem->format !=
+        raw_vertex_format::last_entry; ++curVtxElem)
+    {
+        u32 wordSize, wordCount;
+        in_get_vertex_swap_words(curVtxElem->format, wordSize, wordCount);
+
+        // Ensure the vertex element fits within the vertex.
+        if ((curVtxElem->offset + (wordSize * wordCount)) > vertexSize)
+        {
+            throw std::runtime_error("Invalid HH vertex element offset");
+        }
+
+        // Add vertex element to swap pattern.
+        if (canUsePattern)
+        {
+            for (u32 i = 0; i < wordCount; ++i)
+            {
+                const u32 wordPos = (curVtxElem->offset + (i * wordSize));
+                for (u32 i2 = 0; i2 < wordSize; ++i2)
+                {
+                    pattern[wordPos + i2] = static_cast<u8>(
+                        wordPos + (wordSize - 1 - i2));
+                }
+            }
+        }
+
+        // Swap vertex element within every vertex if we can't use a pattern.
+        else
+        {
+            void* curVtx = ptradd(rawVertices, curVtxElem->offset);
+            for (u32 i = 0; i < vertexCount; ++i)
+            {
+                in_swap_vertex_words(curVtx, wordSize, wordCount);
+                curVtx = ptradd(curVtx, vertexSize);
+            }
+        }
+    }
+
+    // Swap all vertices in one go using the pattern.
+    if (canUsePattern)
+    {
+        endian_swap_records(rawVertices, vertexCount, vertexSize, pattern);
+    }
+}
+
 template<typename RawMeshType>
 static void in_swap_recursive(RawMeshType& rawMesh)
 {
@@ -875,10 +953,7 @@ static void in_swap_recursive(RawMeshType& rawMesh)
     endian_swap<false>(rawMesh);
 
     // Swap faces.
-    for (auto& face : rawMesh.faces)
-    {
-        endian_swap(face);
-    }
+    endian_swap_array(rawMesh.faces.data(), rawMesh.faces.count);
 
     // Swap vertex format (array of vertex elements).
     raw_vertex_element* curVtxElem = rawMesh.vertexElements.get();
@@ -889,31 +964,14 @@ static void in_swap_recursive(RawMeshType& rawMesh)
     while ((curVtxElem++)->format != raw_vertex_format::last_entry);
 
     // Swap vertices based on vertex format.
-    curVtxElem = rawMesh.vertexElements.get();
-    while (curVtxElem->format != raw_vertex_format::last_entry)
-    {
-        // Swap vertices based on vertex element.
-        void* curVtx = ptradd(rawMesh.vertices.get(), curVtxElem->offset);
-        for (u32 i = 0; i < rawMesh.vertexCount; ++i)
-        {
-            // Swap vertex.
-            in_swap_vertex(*curVtxElem, curVtx);
-
-            // Increase vertices pointer.
-            curVtx = ptradd(curVtx, rawMesh.vertexSize);
-        }
-
-        // Increase current vertex element pointer.
-        ++curVtxElem;
-    }
+    in_swap_vertices(rawMesh.vertexElements.get(), rawMesh.vertexCount,
+        rawMesh.vertexSize, rawMesh.vertices.get());
 
     // Swap bone node indices if necessary.
     if constexpr (std::is_same_v<RawMeshType, raw_mesh_r2>)
     {
-        for (auto& boneNodeIndex : rawMesh.boneNodeIndices)
-        {
-            endian_swap(boneNodeIndex);
-        }
+        endian_swap_array(rawMesh.boneNodeIndices.data(),
+            rawMesh.boneNodeIndices.count);
     }
 }
 
@@ -2262,34 +2320,24 @@ std::unordered_set<std::string> model::get_unique_material_names() const
     return uniqueMatNames;
 }
 
-void model::import_materials(const nchar* materialDir,
+void model::import_materials(res_cache& resCache, const nchar* texDir,
     scene& scene, bool merge, bool includeLibGensTags) const
 {
-    nstring matPath = materialDir;
-    if (path::combine_needs_sep1(matPath))
-    {
-        matPath += path::separator;
-    }
+    // Get unique material names, sorted so the scene is the same every time.
+    const std::unordered_set<std::string> uniqueMatNames = get_unique_material_names();
+    std::vector<std::string> matNames(uniqueMatNames.begin(), uniqueMatNames.end());
+    std::sort(matNames.begin(), matNames.end());
 
-    const std::size_t matNamePos = matPath.size();
-    std::unordered_set<std::string> uniqueMatNames = get_unique_material_names();
+    // Load all of the materials, texsets, and texture entries in parallel.
+    resCache.preload_materials(matNames);
 
-    for (auto& matName : uniqueMatNames)
+    // Add materials to scene.
+    for (auto& matName : matNames)
     {
-        matPath +=
-#ifdef HL_IN_WIN32_UNICODE
-            text::conv<text::utf8_to_native>(matName);
-#else
-            matName;
-#endif
-
-        matPath += material::ext;
-
-        if (path::exists(matPath))
+        const auto mat = resCache.get_material(matName);
+        if (mat)
         {
-            material mat(matPath);
-            mat.add_to_hl_scene(materialDir, scene, merge, includeLibGensTags);
-            matPath.erase(matNamePos);
+            mat->add_to_hl_scene(texDir, scene, merge, includeLibGensTags);
         }
         else
         {
@@ -2298,6 +2346,15 @@ void model::import_materials(const nchar* materialDir,
     }
 }
 
+void model::import_materials(const nchar* materialDir,
+    scene& scene, bool merge, bool includeLibGensTags) const
+{
+    res_cache resCache;
+    resCache.add_dir(materialDir);
+
+    import_materials(resCache, materialDir, scene, merge, includeLibGensTags);
+}
+
 void terrain_model::in_parse(const raw_terrain_model_v5r1& rawMdl)
 {
     // Parse mesh groups.
@@ -2324,6 +2381,8 @@ void terrain_model::in_parse(const raw_terrain_model_v5r2& rawMdl)
 
 void terrain_model::in_parse(const void* rawData)
 {
+    HL_TRACE_ZONE("hh::mirage::terrain_model::parse");
+
     // Get terrain model data and version number.
     u32 version;
     const auto mdlData = get_data(rawData, &version);
@@ -2353,6 +2412,8 @@ void terrain_model::in_parse(const void* rawData)
 
 void terrain_model::in_load(const nchar* filePath)
 {
+    HL_TRACE_ZONE("hh::mirage::terrain_model::load");
+
     // Load and parse terrain model.
     blob rawMdl(filePath);
     fix(rawMdl);
@@ -2368,6 +2429,8 @@ void terrain_model::in_clear() noexcept
 
 void terrain_model::fix(void* rawData)
 {
+    HL_TRACE_ZONE("hh::mirage::terrain_model::fix");
+
     // Fix mirage data.
     mirage::fix(rawData);
 
@@ -2414,6 +2477,8 @@ header_type terrain_model::get_default_header_type() const
 
 void terrain_model::add_to_node(hl::node& parentNode, bool includeLibGensTags) const
 {
+    HL_TRACE_ZONE("hh::mirage::terrain_model::add_to_node");
+
     // Get model topology type.
     const auto topType = get_topology_type();
 
@@ -2466,6 +2531,8 @@ void terrain_model::load(const nchar* filePath)
 void terrain_model::write(writer& writer,
     header_type headerType, u32 version, u32 revision) const
 {
+    HL_TRACE_ZONE("hh::mirage::terrain_model::write");
+
     // Start writing model.
     if (headerType != header_type::standard)
     {
@@ -2676,6 +2743,8 @@ void skeletal_model::in_parse(const raw_skeletal_model_v6& rawMdl)
 
 void skeletal_model::in_parse(const void* rawData)
 {
+    HL_TRACE_ZONE("hh::mirage::skeletal_model::parse");
+
     // Get skeletal model data and version number.
     u32 version;
     const auto mdlData = get_data(rawData, &version);
@@ -2708,6 +2777,8 @@ void skeletal_model::in_parse(const void* rawData)
 
 void skeletal_model::in_load(const nchar* filePath)
 {
+    HL_TRACE_ZONE("hh::mirage::skeletal_model::load");
+
     // Load and parse skeletal model.
     blob rawMdl(filePath);
     fix(rawMdl);
@@ -2723,6 +2794,8 @@ void skeletal_model::in_clear() noexcept
 
 void skeletal_model::fix(void* rawData)
 {
+    HL_TRACE_ZONE("hh::mirage::skeletal_model::fix");
+
     // Fix mirage data.
     mirage::fix(rawData);
 
@@ -2777,6 +2850,8 @@ header_type skeletal_model::get_default_header_type() const
 
 void skeletal_model::add_to_node(hl::node& parentNode, bool includeLibGensTags) const
 {
+    HL_TRACE_ZONE("hh::mirage::skeletal_model::add_to_node");
+
     // Get model topology type.
     const auto topType = get_topology_type();
 
@@ -2859,6 +2934,8 @@ void skeletal_model::load(const nchar* filePath)
 void skeletal_model::write(writer& writer,
     header_type headerType, u32 version) const
 {
+    HL_TRACE_ZONE("hh::mirage::skeletal_model::write");
+
     // Start writing model.
     if (headerType != header_type::standard)
     {
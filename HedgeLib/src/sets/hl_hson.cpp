@@ -3,6 +3,7 @@
 #include "hedgelib/io/hl_file.h"
 #include "hedgelib/io/hl_mem_stream.h"
 #include "hedgelib/hl_reflect.h"
+#include "hedgelib/hl_trace.h"
 #include <DirectXMath.h>
 
 namespace hl
@@ -1523,7 +1524,12 @@ radix_tree<parameter> object::get_flattened_parameters(
     const ordered_map<guid, object>& objects,
     const char* rootPath) const
 {
+    // NOTE: Flattened parameter trees are built once and then only read
+    // (e.g. while writing set data), so there's no point in freeing their
+    // nodes one at a time.
     radix_tree<parameter> result;
+    result.use_arena();
+
     get_flattened_parameters(objects, result);
     return result;
 }
@@ -1591,6 +1597,8 @@ void project_metadata::clear() noexcept
 
 void project::write(stream& stream) const
 {
+    HL_TRACE_ZONE("hson::write");
+
     // Create RapidJSON writer.
     internal::in_rapidjson_output_stream_wrapper jsonStream(stream);
     internal::in_rapidjson_writer writer(jsonStream);
@@ -1677,18 +1685,24 @@ void project::save(const nchar* filePath) const
 
 void project::in_parse(const void* rawData, std::size_t rawDataSize)
 {
+    HL_TRACE_ZONE("hson::parse");
+
     in_project_json_handler handler(*this);
     internal::in_parse_json(handler, rawData, rawDataSize);
 }
 
 void project::in_read(stream& stream)
 {
+    HL_TRACE_ZONE("hson::read");
+
     in_project_json_handler handler(*this);
     internal::in_read_json(handler, stream);
 }
 
 void project::in_load(const nchar* filePath)
 {
+    HL_TRACE_ZONE("hson::load");
+
     in_project_json_handler handler(*this);
     internal::in_load_json(handler, filePath);
 }
@@ -1,5 +1,6 @@
 #include "../io/hl_in_rapidjson.h"
 #include "hedgelib/sets/hl_set_obj_type.h"
+#include "hedgelib/hl_trace.h"
 #include <string_view>
 
 namespace hl
@@ -1172,18 +1173,24 @@ bool in_set_object_type_database_json_handler::EndArray(SizeType elementCount)
 void set_object_type_database::in_parse(
     const void* rawData, std::size_t rawDataSize)
 {
+    HL_TRACE_ZONE("set_object_type_database::parse");
+
     internal::in_set_object_type_database_json_handler handler(*this);
     internal::in_parse_json(handler, rawData, rawDataSize);
 }
 
 void set_object_type_database::in_read(stream& stream)
 {
+    HL_TRACE_ZONE("set_object_type_database::read");
+
     internal::in_set_object_type_database_json_handler handler(*this);
     internal::in_read_json(handler, stream);
 }
 
 void set_object_type_database::in_load(const nchar* filePath)
 {
+    HL_TRACE_ZONE("set_object_type_database::load");
+
     internal::in_set_object_type_database_json_handler handler(*this);
     internal::in_load_json(handler, filePath);
 }
@@ -1215,18 +1222,28 @@ void set_object_type_database::load(const nchar* filePath)
     in_load(filePath);
 }
 
+set_object_type_database::set_object_type_database()
+{
+    // Object type databases can contain tens of thousands of
+    // entries, so allocate their nodes from an arena.
+    use_arena();
+}
+
 set_object_type_database::set_object_type_database(
-    const void* rawData, std::size_t rawDataSize)
+    const void* rawData, std::size_t rawDataSize) :
+    set_object_type_database()
 {
     in_parse(rawData, rawDataSize);
 }
 
-set_object_type_database::set_object_type_database(stream& stream)
+set_object_type_database::set_object_type_database(stream& stream) :
+    set_object_type_database()
 {
     in_read(stream);
 }
 
-set_object_type_database::set_object_type_database(const nchar* filePath)
+set_object_type_database::set_object_type_database(const nchar* filePath) :
+    set_object_type_database()
 {
     in_load(filePath);
 }
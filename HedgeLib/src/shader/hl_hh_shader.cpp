@@ -92,6 +92,9 @@ void shader_params::in_parse(const raw_shader_params_v2& rawShaderParams)
     in_parse_shader_consts(rawShaderParams.bools, bools);
     in_parse_shader_resources(rawShaderParams.textures, textures);
     //in_parse_shader_resources(rawShaderParams.unknown2, unknown2);
+
+    // Build lookup.
+    build_lookup();
 }
 
 void shader_params::in_parse(const void* rawData)
@@ -113,6 +116,11 @@ void shader_params::in_parse(const void* rawData)
     }
 }
 
+void shader_params::build_lookup()
+{
+    build_name_lookup(textures, m_texLookup);
+}
+
 void shader_params::in_load(const nchar* filePath)
 {
     // Load and parse shader parameters.
@@ -128,6 +136,7 @@ void shader_params::in_clear() noexcept
     bools.clear();
     textures.clear();
     //unknown2.clear();
+    m_texLookup.clear();
 }
 
 void shader_params::fix(void* rawData)
@@ -167,21 +176,6 @@ std::size_t shader_params::total_param_count() const noexcept
     return (total_constant_count() + total_resource_count());
 }
 
-template<typename T>
-static const shader_param_resource* in_get_shader_resource(
-    const std::vector<shader_param_resource>& params, T name)
-{
-    for (auto& param : params)
-    {
-        if (param.name == name)
-        {
-            return &param;
-        }
-    }
-
-    return nullptr;
-}
-
 //const shader_param_constant* shader_params::get_float_param(const char* name) const
 //{
 //    return floats.get(name);
@@ -214,12 +208,12 @@ static const shader_param_resource* in_get_shader_resource(
 //
 const shader_param_resource* shader_params::get_texture_param(const char* name) const
 {
-    return in_get_shader_resource(textures, name);
+    return find_by_name(textures, m_texLookup, name);
 }
 
 const shader_param_resource* shader_params::get_texture_param(const std::string& name) const
 {
-    return in_get_shader_resource<const std::string&>(textures, name);
+    return find_by_name(textures, m_texLookup, name);
 }
 
 void shader_params::parse(const void* rawData, std::string name)
@@ -302,6 +296,7 @@ void shader::in_clear() noexcept
 {
     codeDataPtr = nullptr;
     paramLists.clear();
+    clear_param_lookup();
 }
 
 void shader::fix(void* rawData)
@@ -326,8 +321,64 @@ void shader::fix(void* rawData)
     }
 }
 
+static void in_build_shader_const_lookup(
+    const hl::radix_tree<shader_param_constant>& params,
+    shader_name_lookup<const shader_param_constant*>& lookup)
+{
+    for (const auto param : params)
+    {
+        lookup.add(param.first, &param.second);
+    }
+}
+
+void shader::build_param_lookup()
+{
+    // Clear any existing lookups.
+    clear_param_lookup();
+
+    // Add the parameters of all of the resolved parameter lists to the lookups.
+    // (NOTE: Parameters from earlier lists take priority, just like without the lookups.)
+    for (auto& paramList : paramLists)
+    {
+        if (!paramList.has_res()) continue;
+
+        in_build_shader_const_lookup(paramList->floats, m_floatLookup);
+        in_build_shader_const_lookup(paramList->ints, m_intLookup);
+        in_build_shader_const_lookup(paramList->bools, m_boolLookup);
+
+        for (auto& texParam : paramList->textures)
+        {
+            m_texLookup.add(texParam.name, &texParam);
+        }
+    }
+
+    m_hasParamLookup = true;
+}
+
+void shader::clear_param_lookup() noexcept
+{
+    m_floatLookup.clear();
+    m_intLookup.clear();
+    m_boolLookup.clear();
+    m_texLookup.clear();
+    m_hasParamLookup = false;
+}
+
+template<typename T>
+static const T* in_shader_find_param(const shader_name_lookup<const T*>& lookup,
+    const char* name)
+{
+    const auto param = lookup.find(name);
+    return (param) ? *param : nullptr;
+}
+
 const shader_param_constant* shader::get_float_param(const char* name) const
 {
+    if (m_hasParamLookup)
+    {
+        return in_shader_find_param(m_floatLookup, name);
+    }
+
     for (auto& paramList : paramLists)
     {
         if (!paramList.has_res()) continue;
@@ -354,6 +405,11 @@ const shader_param_constant* shader::get_float_param(const char* name) const
 
 const shader_param_constant* shader::get_int_param(const char* name) const
 {
+    if (m_hasParamLookup)
+    {
+        return in_shader_find_param(m_intLookup, name);
+    }
+
     for (auto& paramList : paramLists)
     {
         if (!paramList.has_res()) continue;
@@ -380,6 +436,11 @@ const shader_param_constant* shader::get_int_param(const char* name) const
 
 const shader_param_constant* shader::get_bool_param(const char* name) const
 {
+    if (m_hasParamLookup)
+    {
+        return in_shader_find_param(m_boolLookup, name);
+    }
+
     for (auto& paramList : paramLists)
     {
         if (!paramList.has_res()) continue;
@@ -406,6 +467,11 @@ const shader_param_constant* shader::get_bool_param(const char* name) const
 
 const shader_param_resource* shader::get_texture_param(const char* name) const
 {
+    if (m_hasParamLookup)
+    {
+        return in_shader_find_param(m_texLookup, name);
+    }
+
     for (auto& paramList : paramLists)
     {
         if (!paramList.has_res()) continue;
@@ -419,15 +485,7 @@ const shader_param_resource* shader::get_texture_param(const char* name) const
 
 const shader_param_resource* shader::get_texture_param(const std::string& name) const
 {
-    for (auto& paramList : paramLists)
-    {
-        if (!paramList.has_res()) continue;
-
-        const auto param = paramList->get_texture_param(name);
-        if (param) return param;
-    }
-
-    return nullptr;
+    return get_texture_param(name.c_str());
 }
 
 void shader::parse(const void* rawData, std::string name)
@@ -475,29 +533,13 @@ vertex_shader_permutation::vertex_shader_permutation(
 const vertex_shader_permutation* pixel_shader_permutation::get_vertex_permutation(
     const char* name) const
 {
-    for (auto& vertexPermutation : vertexPermutations)
-    {
-        if (vertexPermutation.name == name)
-        {
-            return &vertexPermutation;
-        }
-    }
-
-    return nullptr;
+    return find_by_name(vertexPermutations, vertexPermutationLookup, name);
 }
 
 const vertex_shader_permutation* pixel_shader_permutation::get_vertex_permutation(
     const std::string& name) const
 {
-    for (auto& vertexPermutation : vertexPermutations)
-    {
-        if (vertexPermutation.name == name)
-        {
-            return &vertexPermutation;
-        }
-    }
-
-    return nullptr;
+    return find_by_name(vertexPermutations, vertexPermutationLookup, name);
 }
 
 pixel_shader_permutation::pixel_shader_permutation(
@@ -512,6 +554,9 @@ pixel_shader_permutation::pixel_shader_permutation(
     {
         vertexPermutations.emplace_back(*vertexPermutation);
     }
+
+    // Build vertex permutation lookup.
+    build_name_lookup(vertexPermutations, vertexPermutationLookup);
 }
 
 void shader_list::in_parse(const raw_shader_list_v0& rawShaderList)
@@ -522,6 +567,9 @@ void shader_list::in_parse(const raw_shader_list_v0& rawShaderList)
     {
         pixelPermutations.emplace_back(*pixelPermutation);
     }
+
+    // Build pixel permutation lookup.
+    build_name_lookup(pixelPermutations, m_pixelPermutationLookup);
 }
 
 void shader_list::in_parse(const void* rawData)
@@ -573,38 +621,34 @@ void shader_list::fix(void* rawData)
     }
 }
 
-const pixel_shader_permutation* shader_list::get_pixel_permutation(
-    const char* name) const
+void shader_list::build_lookup()
 {
+    build_name_lookup(pixelPermutations, m_pixelPermutationLookup);
+
     for (auto& pixelPermutation : pixelPermutations)
     {
-        if (pixelPermutation.name == name)
-        {
-            return &pixelPermutation;
-        }
+        build_name_lookup(pixelPermutation.vertexPermutations,
+            pixelPermutation.vertexPermutationLookup);
     }
+}
 
-    return nullptr;
+const pixel_shader_permutation* shader_list::get_pixel_permutation(
+    const char* name) const
+{
+    return find_by_name(pixelPermutations, m_pixelPermutationLookup, name);
 }
 
 const pixel_shader_permutation* shader_list::get_pixel_permutation(
     const std::string& name) const
 {
-    for (auto& pixelPermutation : pixelPermutations)
-    {
-        if (pixelPermutation.name == name)
-        {
-            return &pixelPermutation;
-        }
-    }
-    
-    return nullptr;
+    return find_by_name(pixelPermutations, m_pixelPermutationLookup, name);
 }
 
 void shader_list::parse(const void* rawData, std::string name)
 {
     // Clear any existing data.
     pixelPermutations.clear();
+    m_pixelPermutationLookup.clear();
 
     // Set new name.
     this->name = std::move(name);
@@ -617,6 +661,7 @@ void shader_list::load(const nchar* filePath)
 {
     // Clear any existing data.
     pixelPermutations.clear();
+    m_pixelPermutationLookup.clear();
 
     // Set new name.
     name = get_res_name(filePath);
@@ -0,0 +1,475 @@
+#include "bench.h"
+#include <hedgelib/io/hl_path.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/* Allocation tracking */
+// NOTE: Every allocation made through the global operator new is prefixed with a
+// small header containing its size, so operator delete can keep track of how much
+// memory is still in use. Over-aligned allocations are left untracked.
+static std::atomic<std::uint64_t> in_alloc_count(0);
+static std::atomic<std::uint64_t> in_alloc_bytes(0);
+static std::atomic<std::uint64_t> in_live_bytes(0);
+static std::atomic<std::uint64_t> in_peak_live_bytes(0);
+
+constexpr std::size_t in_alloc_header_size = alignof(std::max_align_t);
+
+static void* in_tracked_alloc(std::size_t size) noexcept
+{
+    // Allocate memory for the header and the requested data.
+    void* const block = std::malloc(size + in_alloc_header_size);
+    if (!block) return nullptr;
+
+    // Write header.
+    *static_cast<std::size_t*>(block) = size;
+
+    // Update stats.
+    in_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    in_alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    const std::uint64_t liveBytes = (in_live_bytes.fetch_add(
+        size, std::memory_order_relaxed) + size);
+
+    std::uint64_t peakLiveBytes = in_peak_live_bytes.load(
+        std::memory_order_relaxed);
+
+    while (liveBytes > peakLiveBytes && !in_peak_live_bytes.compare_exchange_weak(
+        peakLiveBytes, liveBytes, std::memory_order_relaxed)) {}
+
+    return (static_cast<unsigned char*>(block) + in_alloc_header_size);
+}
+
+static void in_tracked_free(void* ptr) noexcept
+{
+    if (!ptr) return;
+
+    // Get header and update stats.
+    void* const block = (static_cast<unsigned char*>(ptr) - in_alloc_header_size);
+    in_live_bytes.fetch_sub(*static_cast<std::size_t*>(block),
+        std::memory_order_relaxed);
+
+    // Free memory.
+    std::free(block);
+}
+
+static void* in_tracked_alloc_or_throw(std::size_t size)
+{
+    while (true)
+    {
+        void* const ptr = in_tracked_alloc(size);
+        if (ptr) return ptr;
+
+        // Give the new-handler a chance to free up some memory, as required by the standard.
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+
+        handler();
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return in_tracked_alloc_or_throw(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return in_tracked_alloc_or_throw(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return in_tracked_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return in_tracked_alloc(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    in_tracked_free(ptr);
+}
+
+namespace bench
+{
+struct in_registered_bench
+{
+    const char* name;
+    bench_func func;
+};
+
+static std::vector<in_registered_bench>& in_get_registered_benches()
+{
+    // NOTE: This is a function-local static so it's guaranteed to be
+    // constructed before any registrars (which are static too) use it.
+    static std::vector<in_registered_bench> benches;
+    return benches;
+}
+
+registrar::registrar(const char* name, bench_func func)
+{
+    in_get_registered_benches().push_back({ name, func });
+}
+
+alloc_stats get_alloc_stats() noexcept
+{
+    return
+    {
+        in_alloc_count.load(std::memory_order_relaxed),
+        in_alloc_bytes.load(std::memory_order_relaxed),
+        in_live_bytes.load(std::memory_order_relaxed),
+        in_peak_live_bytes.load(std::memory_order_relaxed)
+    };
+}
+
+void reset_peak_heap() noexcept
+{
+    in_peak_live_bytes.store(in_live_bytes.load(
+        std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void reset_peak_rss() noexcept
+{
+#ifdef __linux__
+    // Writing 5 to clear_refs resets the peak RSS (VmHWM) on Linux 4.0+.
+    std::FILE* const file = std::fopen("/proc/self/clear_refs", "w");
+    if (file)
+    {
+        std::fputs("5", file);
+        std::fclose(file);
+    }
+#endif
+}
+
+std::uint64_t get_peak_rss() noexcept
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+    }
+
+    return 0;
+#else
+#ifdef __linux__
+    // Read VmHWM from /proc/self/status, as it can be reset, unlike ru_maxrss.
+    std::FILE* const file = std::fopen("/proc/self/status", "r");
+    if (file)
+    {
+        char line[256];
+        unsigned long long kib = 0;
+        bool found = false;
+
+        while (std::fgets(line, sizeof(line), file))
+        {
+            if (std::sscanf(line, "VmHWM: %llu kB", &kib) == 1)
+            {
+                found = true;
+                break;
+            }
+        }
+
+        std::fclose(file);
+        if (found) return (static_cast<std::uint64_t>(kib) * 1024);
+    }
+#endif
+
+    // Fallback to getrusage.
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    return (static_cast<std::uint64_t>(usage.ru_maxrss) * 1024);
+#endif
+#endif
+}
+
+void state::skip(std::string reason)
+{
+    m_result.status = result_status::skipped;
+    m_result.message = std::move(reason);
+}
+
+void state::in_run(const std::function<void()>& setup,
+    const std::function<void()>& func)
+{
+    using clock = std::chrono::steady_clock;
+
+    // Run once without measuring, to warm up caches and lazily-initialized state.
+    if (setup) setup();
+    func();
+
+    // Measure.
+    const auto minDuration = std::chrono::duration<double>(m_opts.minTime);
+    clock::duration totalTime = clock::duration::zero();
+    clock::duration minTime = clock::duration::max();
+    std::uint64_t iterations = 0, allocCount = 0, allocBytes = 0, peakHeapBytes = 0;
+
+    reset_peak_rss();
+
+    while (iterations < m_opts.maxIterations &&
+        (iterations < m_opts.minIterations || totalTime < minDuration))
+    {
+        if (setup) setup();
+
+        reset_peak_heap();
+        const alloc_stats before = get_alloc_stats();
+        const auto start = clock::now();
+
+        func();
+
+        const auto time = (clock::now() - start);
+        const alloc_stats after = get_alloc_stats();
+
+        totalTime += time;
+        minTime = std::min(minTime, time);
+        allocCount += (after.count - before.count);
+        allocBytes += (after.bytes - before.bytes);
+        peakHeapBytes = std::max<std::uint64_t>(peakHeapBytes,
+            after.peakLiveBytes - before.liveBytes);
+
+        ++iterations;
+    }
+
+    // Store results.
+    const double iterationCount = static_cast<double>(iterations);
+
+    m_result.iterations = iterations;
+    m_result.meanSeconds = (std::chrono::duration<double>(
+        totalTime).count() / iterationCount);
+
+    m_result.minSeconds = std::chrono::duration<double>(minTime).count();
+    m_result.allocsPerIteration = (allocCount / iterationCount);
+    m_result.allocBytesPerIteration = (allocBytes / iterationCount);
+    m_result.peakHeapBytes = peakHeapBytes;
+    m_result.peakRssBytes = get_peak_rss();
+}
+
+hl::nstring state::temp_path(const hl::nchar* fileName) const
+{
+    return hl::path::combine(m_opts.tempDir, hl::nstring(fileName));
+}
+
+std::vector<hl::nstring> state::data_files(const hl::nchar* subDir,
+    const hl::nchar* ext) const
+{
+    std::vector<hl::nstring> files;
+    if (m_opts.dataDir.empty()) return files;
+
+    // Return early if the given sub-directory doesn't exist.
+    const hl::nstring dirPath = hl::path::combine(m_opts.dataDir, hl::nstring(subDir));
+    if (!hl::path::is_dir(dirPath)) return files;
+
+    // Get all of the matching files within the sub-directory.
+    for (const auto& dirEntry : hl::path::dir(dirPath))
+    {
+        if (dirEntry.type() != hl::path::dir_entry_type::regular)
+            continue;
+
+        if (ext && !hl::text::iequal(hl::path::get_ext(dirEntry.name()), ext))
+            continue;
+
+        files.push_back(hl::path::combine(dirPath, hl::nstring(dirEntry.name())));
+    }
+
+    // Sort the files so results are comparable across runs and platforms.
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static bool in_matches_filter(const char* name, const std::string& filter)
+{
+    return (filter.empty() || std::strstr(name, filter.c_str()));
+}
+
+std::vector<std::string> get_benchmark_names(const std::string& filter)
+{
+    std::vector<std::string> names;
+    for (const auto& bench : in_get_registered_benches())
+    {
+        if (in_matches_filter(bench.name, filter))
+        {
+            names.emplace_back(bench.name);
+        }
+    }
+
+    return names;
+}
+
+std::vector<result> run_all(const options& opts)
+{
+    std::vector<result> results;
+
+    for (const auto& bench : in_get_registered_benches())
+    {
+        // Skip benchmarks which don't match the filter.
+        if (!in_matches_filter(bench.name, opts.filter))
+            continue;
+
+        // Run the benchmark.
+        result res;
+        res.name = bench.name;
+
+        std::fprintf(stderr, "Running %s...\n", bench.name);
+
+        try
+        {
+            state state(opts, res);
+            bench.func(state);
+
+            if (res.status == result_status::ok && res.iterations == 0)
+            {
+                state.skip("Nothing was measured.");
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            res.status = result_status::error;
+            res.message = ex.what();
+        }
+        catch (...)
+        {
+            res.status = result_status::error;
+            res.message = "Unknown error.";
+        }
+
+        results.push_back(std::move(res));
+    }
+
+    return results;
+}
+
+std::vector<hl::u8> make_synthetic_data(std::size_t size, unsigned int seed)
+{
+    // Generate data consisting of short runs of a few recurring byte patterns,
+    // interspersed with noise, so it compresses roughly like real game data.
+    std::vector<hl::u8> data(size);
+    std::uint32_t rng = (seed * 2654435761U) | 1;
+
+    const auto next = [&rng]()
+    {
+        // xorshift32.
+        rng ^= (rng << 13);
+        rng ^= (rng >> 17);
+        rng ^= (rng << 5);
+        return rng;
+    };
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        const std::uint32_t r = next();
+        const std::size_t runLen = std::min<std::size_t>(
+            (r & 0x3F) + 1, size - i);
+
+        if (r & 0x300)
+        {
+            // Recurring pattern.
+            const hl::u8 pattern = static_cast<hl::u8>((r >> 16) & 0x7);
+            for (std::size_t j = 0; j < runLen; ++j)
+            {
+                data[i + j] = static_cast<hl::u8>(pattern * 31 + (j & 3));
+            }
+        }
+        else
+        {
+            // Noise.
+            for (std::size_t j = 0; j < runLen; ++j)
+            {
+                data[i + j] = static_cast<hl::u8>(next());
+            }
+        }
+
+        i += runLen;
+    }
+
+    return data;
+}
+
+std::vector<std::string> make_synthetic_names(std::size_t count, unsigned int seed)
+{
+    static const char* const prefixes[] =
+    {
+        "ObjRing", "ObjSpring", "ObjDashPanel", "ObjEnemy", "ObjBox",
+        "cmn_obj", "stg_terrain", "chr_sonic", "bg_sky", "evt_"
+    };
+
+    static const char* const suffixes[] =
+    {
+        "", "_HD", "_lod1", "_col", "_mat", "_anim", "_fx"
+    };
+
+    constexpr std::size_t prefixCount = (sizeof(prefixes) / sizeof(*prefixes));
+    constexpr std::size_t suffixCount = (sizeof(suffixes) / sizeof(*suffixes));
+
+    std::vector<std::string> names;
+    names.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // NOTE: Names are made unique by including i, and mixed with
+        // the seed so different seeds give different orderings.
+        const std::size_t h = ((i + seed) * 2654435761U);
+        std::string name = prefixes[h % prefixCount];
+
+        name += std::to_string(i);
+        name += suffixes[(h >> 8) % suffixCount];
+        names.push_back(std::move(name));
+    }
+
+    return names;
+}
+} // bench
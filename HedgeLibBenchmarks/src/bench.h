@@ -0,0 +1,187 @@
+#ifndef HLB_BENCH_H_INCLUDED
+#define HLB_BENCH_H_INCLUDED
+#include <hedgelib/hl_internal.h>
+#include <hedgelib/hl_text.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace bench
+{
+struct options
+{
+    /** @brief Optional directory containing user-supplied data, sorted into sub-directories by format. */
+    hl::nstring dataDir;
+    /** @brief Directory benchmarks can write temporary files to. */
+    hl::nstring tempDir;
+    /** @brief Directory containing the set object templates (e.g. frontiers.json). */
+    hl::nstring templatesDir;
+    /** @brief Only benchmarks whose names contain this string are run. */
+    std::string filter;
+    /** @brief The minimum amount of time to spend measuring each benchmark, in seconds. */
+    double minTime = 0.5;
+    /** @brief The minimum number of measured iterations per benchmark. */
+    unsigned int minIterations = 3;
+    /** @brief The maximum number of measured iterations per benchmark. */
+    unsigned int maxIterations = 1000;
+    /** @brief A multiplier applied to the size of all synthetic data. */
+    std::size_t scale = 1;
+};
+
+enum class result_status
+{
+    ok,
+    skipped,
+    error
+};
+
+struct result
+{
+    std::string name;
+    result_status status = result_status::ok;
+    /** @brief Why the benchmark was skipped, or the error it ran into. */
+    std::string message;
+    std::uint64_t iterations = 0;
+    double meanSeconds = 0;
+    double minSeconds = 0;
+    std::uint64_t bytesPerIteration = 0;
+    std::uint64_t itemsPerIteration = 0;
+    double allocsPerIteration = 0;
+    double allocBytesPerIteration = 0;
+    /** @brief The peak heap usage during measurement, above what was in use beforehand. */
+    std::uint64_t peakHeapBytes = 0;
+    /** @brief The peak resident set size of the process during measurement, if known. */
+    std::uint64_t peakRssBytes = 0;
+
+    inline double mb_per_sec() const noexcept
+    {
+        return (meanSeconds > 0) ? ((bytesPerIteration /
+            (1024.0 * 1024.0)) / meanSeconds) : 0;
+    }
+
+    inline double items_per_sec() const noexcept
+    {
+        return (meanSeconds > 0) ? (itemsPerIteration / meanSeconds) : 0;
+    }
+};
+
+class state
+{
+    const options& m_opts;
+    result& m_result;
+
+    void in_run(const std::function<void()>& setup,
+        const std::function<void()>& func);
+
+public:
+    inline const options& opts() const noexcept
+    {
+        return m_opts;
+    }
+
+    /** @brief Sets how many bytes of data one iteration processes, for MB/s figures. */
+    inline void set_bytes(std::uint64_t bytesPerIteration) noexcept
+    {
+        m_result.bytesPerIteration = bytesPerIteration;
+    }
+
+    /** @brief Sets how many items one iteration processes, for items/s figures. */
+    inline void set_items(std::uint64_t itemsPerIteration) noexcept
+    {
+        m_result.itemsPerIteration = itemsPerIteration;
+    }
+
+    /** @brief Marks the benchmark as skipped (e.g. because no data was supplied for it). */
+    void skip(std::string reason);
+
+    /**
+        @brief Repeatedly calls func, measuring its time and allocations, until
+        the configured minimum time and iteration count have been reached.
+    */
+    inline void run(const std::function<void()>& func)
+    {
+        in_run(nullptr, func);
+    }
+
+    /**
+        @brief Like run, but calls setup before each call to func, without
+        measuring it. Useful for benchmarking operations which work in-place.
+    */
+    inline void run(const std::function<void()>& setup,
+        const std::function<void()>& func)
+    {
+        in_run(setup, func);
+    }
+
+    /** @brief Gets the path to a file with the given name within the temporary directory. */
+    hl::nstring temp_path(const hl::nchar* fileName) const;
+
+    /**
+        @brief Gets the paths to all of the user-supplied files within the given
+        sub-directory of the data directory which have the given extension (or all
+        of them if ext is null). Returns an empty list if no data directory was given.
+    */
+    std::vector<hl::nstring> data_files(const hl::nchar* subDir,
+        const hl::nchar* ext = nullptr) const;
+
+    inline state(const options& opts, result& result) noexcept :
+        m_opts(opts), m_result(result) {}
+};
+
+using bench_func = void (*)(state& state);
+
+struct registrar
+{
+    registrar(const char* name, bench_func func);
+};
+
+struct alloc_stats
+{
+    std::uint64_t count;
+    std::uint64_t bytes;
+    std::uint64_t liveBytes;
+    std::uint64_t peakLiveBytes;
+};
+
+/** @brief Gets the allocations made through operator new so far. */
+alloc_stats get_alloc_stats() noexcept;
+
+/** @brief Resets the peak heap usage to the current heap usage. */
+void reset_peak_heap() noexcept;
+
+/** @brief Resets the peak RSS, if the platform allows it. */
+void reset_peak_rss() noexcept;
+
+/** @brief Gets the process' peak resident set size, in bytes, or 0 if unknown. */
+std::uint64_t get_peak_rss() noexcept;
+
+/** @brief Gets the names of every registered benchmark whose name contains filter. */
+std::vector<std::string> get_benchmark_names(const std::string& filter);
+
+/** @brief Runs every registered benchmark which matches the given options. */
+std::vector<result> run_all(const options& opts);
+
+/**
+    @brief Generates size bytes of deterministic, moderately-compressible
+    data, resembling typical game data.
+*/
+std::vector<hl::u8> make_synthetic_data(std::size_t size, unsigned int seed);
+
+/** @brief Generates count deterministic, unique object-like names. */
+std::vector<std::string> make_synthetic_names(std::size_t count, unsigned int seed);
+} // bench
+
+#define HLB_IN_CONCAT2(a, b) a##b
+#define HLB_IN_CONCAT(a, b) HLB_IN_CONCAT2(a, b)
+
+/**
+    @brief Defines and registers a benchmark with the given name
+    (e.g. "pacx/v3/save"), followed by its body.
+*/
+#define HLB_BENCHMARK(name)\
+    static void HLB_IN_CONCAT(in_bench_func_, __LINE__)(bench::state& state);\
+    static const bench::registrar HLB_IN_CONCAT(in_bench_registrar_, __LINE__)(\
+        name, &HLB_IN_CONCAT(in_bench_func_, __LINE__));\
+    static void HLB_IN_CONCAT(in_bench_func_, __LINE__)(bench::state& state)
+#endif
@@ -0,0 +1,374 @@
+#include "bench.h"
+#include <hedgelib/archives/hl_pacx.h>
+#include <hedgelib/archives/hl_hh_archive.h>
+#include <hedgelib/io/hl_path.h>
+
+static std::size_t get_data_size(const hl::archive_entry_list& arc)
+{
+    std::size_t dataSize = 0;
+    for (const auto& entry : arc)
+    {
+        if (entry.is_regular_file())
+        {
+            dataSize += entry.size();
+        }
+    }
+
+    return dataSize;
+}
+
+/**
+    @brief Generates an archive containing files of varying sizes, using
+    only those of the given extensions which can be stored in split PACs
+    (so the data doesn't have to be valid BINA data).
+*/
+static hl::archive_entry_list make_synthetic_archive(const bench::options& opts,
+    const hl::pacx::supported_ext* exts, std::size_t extCount)
+{
+    // Get the extensions we can use.
+    std::vector<const hl::nchar*> usableExts;
+    for (std::size_t i = 0; i < extCount; ++i)
+    {
+        if (exts[i].is_split_type() && !hl::text::equal(exts[i].ext, HL_NTEXT("pac")))
+        {
+            usableExts.push_back(exts[i].ext);
+        }
+    }
+
+    // Use a generic extension if there are no usable extensions.
+    if (usableExts.empty())
+    {
+        usableExts.push_back(HL_NTEXT("bin"));
+    }
+
+    // Generate files.
+    const std::size_t fileCount = (256 * opts.scale);
+    hl::archive_entry_list arc;
+    arc.reserve(fileCount);
+
+    for (std::size_t i = 0; i < fileCount; ++i)
+    {
+        // NOTE: This gives file sizes between 1 and 64 KiB, for ~8 MiB of data in total.
+        const std::size_t fileSize = (1024 + ((i * 7919) % 64512));
+        const auto data = bench::make_synthetic_data(fileSize,
+            static_cast<unsigned int>(i));
+
+        hl::nstring fileName = hl::text::conv<hl::text::utf8_to_native>(
+            "file" + std::to_string(i));
+
+        fileName += HL_NTEXT('.');
+        fileName += usableExts[i % usableExts.size()];
+
+        arc.push_back(hl::archive_entry::make_regular_file(
+            fileName.c_str(), fileSize, data.data()));
+    }
+
+    return arc;
+}
+
+template<typename save_func_t, typename load_func_t>
+static void bench_synthetic_archive(bench::state& state,
+    const hl::pacx::supported_ext* exts, std::size_t extCount,
+    const hl::nchar* fileName, save_func_t saveFunc, load_func_t loadFunc,
+    bool measureSave)
+{
+    auto arc = make_synthetic_archive(state.opts(), exts, extCount);
+    const hl::nstring filePath = state.temp_path(fileName);
+
+    state.set_bytes(get_data_size(arc));
+    state.set_items(arc.size());
+
+    if (measureSave)
+    {
+        state.run([&]()
+        {
+            saveFunc(arc, filePath);
+        });
+    }
+    else
+    {
+        saveFunc(arc, filePath);
+        state.run([&]()
+        {
+            hl::archive_entry_list loadedArc;
+            loadFunc(filePath, loadedArc);
+        });
+    }
+}
+
+template<typename load_func_t>
+static void bench_user_archives(bench::state& state, const hl::nchar* subDir,
+    const hl::nchar* ext, load_func_t loadFunc)
+{
+    const auto files = state.data_files(subDir, ext);
+    if (files.empty())
+    {
+        state.skip("No user-supplied data.");
+        return;
+    }
+
+    // Get the total amount of (uncompressed) data within the given archives.
+    std::size_t dataSize = 0, fileCount = 0;
+    for (const auto& filePath : files)
+    {
+        hl::archive_entry_list arc;
+        loadFunc(filePath, arc);
+
+        dataSize += get_data_size(arc);
+        fileCount += arc.size();
+    }
+
+    state.set_bytes(dataSize);
+    state.set_items(fileCount);
+
+    // Measure.
+    state.run([&]()
+    {
+        for (const auto& filePath : files)
+        {
+            hl::archive_entry_list arc;
+            loadFunc(filePath, arc);
+        }
+    });
+}
+
+/* PACx V2 */
+static void save_pacx_v2(const hl::archive_entry_list& arc, const hl::nstring& filePath)
+{
+    hl::pacx::v2::save(arc, hl::bina::endian_flag::big,
+        hl::pacx::lw_exts, hl::pacx::lw_ext_count, filePath);
+}
+
+static void load_pacx_v2(const hl::nstring& filePath, hl::archive_entry_list& arc)
+{
+    hl::pacx::v2::load(filePath, &arc);
+}
+
+HLB_BENCHMARK("pacx/v2/save")
+{
+    bench_synthetic_archive(state, hl::pacx::lw_exts, hl::pacx::lw_ext_count,
+        HL_NTEXT("bench_v2.pac"), save_pacx_v2, load_pacx_v2, true);
+}
+
+HLB_BENCHMARK("pacx/v2/load")
+{
+    bench_synthetic_archive(state, hl::pacx::lw_exts, hl::pacx::lw_ext_count,
+        HL_NTEXT("bench_v2.pac"), save_pacx_v2, load_pacx_v2, false);
+}
+
+HLB_BENCHMARK("pacx/v2/load (user)")
+{
+    bench_user_archives(state, HL_NTEXT("pacx_v2"),
+        HL_NTEXT(".pac"), load_pacx_v2);
+}
+
+/* PACPACK_METADATA */
+static void bench_get_pac_pack_meta(bench::state& state,
+    const hl::archive_entry_list& arc)
+{
+    state.set_bytes(get_data_size(arc));
+    state.set_items(arc.size());
+
+    state.run([&]()
+    {
+        for (const auto& entry : arc)
+        {
+            if (entry.is_regular_file() && !entry.is_reference_file())
+            {
+                hl::bina::get_pac_pack_meta(entry.file_data(), entry.size());
+            }
+        }
+    });
+}
+
+HLB_BENCHMARK("pacx/v2/get_pac_pack_meta")
+{
+    // NOTE: This is the worst case, which is also the common one while packing
+    // PACxV2: a large non-BINA file (e.g. a texture) without PACPACK_METADATA.
+    const std::size_t fileSize = ((32 * 1024 * 1024) * state.opts().scale);
+    const auto data = bench::make_synthetic_data(fileSize, 0);
+
+    hl::archive_entry_list arc;
+    arc.push_back(hl::archive_entry::make_regular_file(
+        HL_NTEXT("file.dds"), fileSize, data.data()));
+
+    bench_get_pac_pack_meta(state, arc);
+}
+
+HLB_BENCHMARK("pacx/v2/get_pac_pack_meta (user)")
+{
+    const auto files = state.data_files(HL_NTEXT("pacx_v2"), HL_NTEXT(".pac"));
+    if (files.empty())
+    {
+        state.skip("No user-supplied data.");
+        return;
+    }
+
+    // Load the entries of all of the given archives into a single list.
+    hl::archive_entry_list arc;
+    for (const auto& filePath : files)
+    {
+        load_pacx_v2(filePath, arc);
+    }
+
+    // Measure.
+    bench_get_pac_pack_meta(state, arc);
+}
+
+/* PACx V3 */
+static void save_pacx_v3(const hl::archive_entry_list& arc, const hl::nstring& filePath)
+{
+    hl::pacx::v3::save(arc, hl::bina::endian_flag::little,
+        hl::pacx::forces_exts, hl::pacx::forces_ext_count, filePath);
+}
+
+static void load_pacx_v3(const hl::nstring& filePath, hl::archive_entry_list& arc)
+{
+    hl::pacx::v3::load(filePath, &arc);
+}
+
+HLB_BENCHMARK("pacx/v3/save")
+{
+    bench_synthetic_archive(state, hl::pacx::forces_exts, hl::pacx::forces_ext_count,
+        HL_NTEXT("bench_v3.pac"), save_pacx_v3, load_pacx_v3, true);
+}
+
+HLB_BENCHMARK("pacx/v3/load")
+{
+    bench_synthetic_archive(state, hl::pacx::forces_exts, hl::pacx::forces_ext_count,
+        HL_NTEXT("bench_v3.pac"), save_pacx_v3, load_pacx_v3, false);
+}
+
+HLB_BENCHMARK("pacx/v3/load (user)")
+{
+    bench_user_archives(state, HL_NTEXT("pacx_v3"),
+        HL_NTEXT(".pac"), load_pacx_v3);
+}
+
+/**
+    @brief Measures parsing an (unfixed) root PACxV3 file which has already been
+    loaded into memory, either by fixing a copy of it, or by using a header_view.
+*/
+static void bench_pacx_v3_parse(bench::state& state, bool useView)
+{
+    const auto arc = make_synthetic_archive(state.opts(),
+        hl::pacx::forces_exts, hl::pacx::forces_ext_count);
+
+    const hl::nstring filePath = state.temp_path(HL_NTEXT("bench_v3_parse.pac"));
+    save_pacx_v3(arc, filePath);
+
+    const hl::blob pac(filePath);
+    state.set_bytes(pac.size());
+    state.set_items(arc.size());
+
+    if (useView)
+    {
+        state.run([&]()
+        {
+            hl::archive_entry_list parsedArc;
+            hl::pacx::v3::header_view(pac.data()).parse(parsedArc, false);
+        });
+    }
+    else
+    {
+        state.run([&]()
+        {
+            // NOTE: fix() modifies the data in-place, so we have to fix a copy.
+            hl::blob pacCopy(pac);
+            hl::pacx::v3::fix(pacCopy.data());
+
+            hl::archive_entry_list parsedArc;
+            hl::pacx::v3::parse(pacCopy.data(), parsedArc, false);
+        });
+    }
+}
+
+HLB_BENCHMARK("pacx/v3/parse (fix)")
+{
+    bench_pacx_v3_parse(state, false);
+}
+
+HLB_BENCHMARK("pacx/v3/parse (view)")
+{
+    bench_pacx_v3_parse(state, true);
+}
+
+/* PACx V4 */
+static void save_pacx_v402(hl::archive_entry_list& arc, const hl::nstring& filePath)
+{
+    hl::pacx::v4::v02::save(arc, hl::pacx::v4::default_lz4_max_chunk_size,
+        hl::compress_type::lz4, hl::bina::endian_flag::little,
+        hl::pacx::tokyo1_ext_count, hl::pacx::tokyo1_exts, filePath);
+}
+
+static void save_pacx_v403(hl::archive_entry_list& arc, const hl::nstring& filePath)
+{
+    hl::pacx::v4::v03::save(arc, hl::pacx::v4::default_lz4_max_chunk_size,
+        hl::compress_type::lz4, hl::bina::endian_flag::little,
+        hl::pacx::rangers_ext_count, hl::pacx::rangers_exts, filePath);
+}
+
+static void load_pacx_v4(const hl::nstring& filePath, hl::archive_entry_list& arc)
+{
+    hl::pacx::v4::load(filePath, &arc);
+}
+
+HLB_BENCHMARK("pacx/v4.02/save")
+{
+    bench_synthetic_archive(state, hl::pacx::tokyo1_exts, hl::pacx::tokyo1_ext_count,
+        HL_NTEXT("bench_v402.pac"), save_pacx_v402, load_pacx_v4, true);
+}
+
+HLB_BENCHMARK("pacx/v4.02/load")
+{
+    bench_synthetic_archive(state, hl::pacx::tokyo1_exts, hl::pacx::tokyo1_ext_count,
+        HL_NTEXT("bench_v402.pac"), save_pacx_v402, load_pacx_v4, false);
+}
+
+HLB_BENCHMARK("pacx/v4.03/save")
+{
+    bench_synthetic_archive(state, hl::pacx::rangers_exts, hl::pacx::rangers_ext_count,
+        HL_NTEXT("bench_v403.pac"), save_pacx_v403, load_pacx_v4, true);
+}
+
+HLB_BENCHMARK("pacx/v4.03/load")
+{
+    bench_synthetic_archive(state, hl::pacx::rangers_exts, hl::pacx::rangers_ext_count,
+        HL_NTEXT("bench_v403.pac"), save_pacx_v403, load_pacx_v4, false);
+}
+
+HLB_BENCHMARK("pacx/v4/load (user)")
+{
+    bench_user_archives(state, HL_NTEXT("pacx_v4"),
+        HL_NTEXT(".pac"), load_pacx_v4);
+}
+
+/* HH AR */
+static void save_hh_ar(const hl::archive_entry_list& arc, const hl::nstring& filePath)
+{
+    // NOTE: We don't generate splits or an .arl, so the whole archive is in one file.
+    hl::hh::ar::save(arc, filePath, 0, hl::hh::ar::default_alignment,
+        hl::compress_type::none, false);
+}
+
+static void load_hh_ar(const hl::nstring& filePath, hl::archive_entry_list& arc)
+{
+    hl::hh::ar::load(filePath, &arc);
+}
+
+HLB_BENCHMARK("hh_ar/save")
+{
+    bench_synthetic_archive(state, nullptr, 0, HL_NTEXT("bench.ar"),
+        save_hh_ar, load_hh_ar, true);
+}
+
+HLB_BENCHMARK("hh_ar/load")
+{
+    bench_synthetic_archive(state, nullptr, 0, HL_NTEXT("bench.ar"),
+        save_hh_ar, load_hh_ar, false);
+}
+
+HLB_BENCHMARK("hh_ar/load (user)")
+{
+    bench_user_archives(state, HL_NTEXT("ar"), HL_NTEXT(".arl"), load_hh_ar);
+}
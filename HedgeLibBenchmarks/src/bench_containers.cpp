@@ -0,0 +1,206 @@
+#include "bench.h"
+#include <hedgelib/hl_radix_tree.h>
+#include <hedgelib/hl_ordered_map.h>
+#include <algorithm>
+#include <utility>
+
+static std::vector<std::string> get_names(const bench::state& state)
+{
+    return bench::make_synthetic_names(50000 * state.opts().scale, 3);
+}
+
+static std::size_t get_total_size(const std::vector<std::string>& names)
+{
+    std::size_t totalSize = 0;
+    for (const auto& name : names)
+    {
+        totalSize += name.size();
+    }
+
+    return totalSize;
+}
+
+/* radix_tree */
+static void bench_radix_tree_insert(bench::state& state, bool useArena)
+{
+    const auto names = get_names(state);
+
+    state.set_bytes(get_total_size(names));
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        hl::radix_tree<std::size_t> tree;
+        tree.use_arena(useArena);
+
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            tree.insert(names[i], i);
+        }
+    });
+}
+
+HLB_BENCHMARK("radix_tree/insert")
+{
+    bench_radix_tree_insert(state, false);
+}
+
+HLB_BENCHMARK("radix_tree/insert (arena)")
+{
+    bench_radix_tree_insert(state, true);
+}
+
+HLB_BENCHMARK("radix_tree/assign_sorted (arena)")
+{
+    const auto names = get_names(state);
+    std::vector<std::pair<std::string, std::size_t>> sortedLeaves;
+
+    sortedLeaves.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        sortedLeaves.emplace_back(names[i], i);
+    }
+
+    std::sort(sortedLeaves.begin(), sortedLeaves.end());
+
+    state.set_bytes(get_total_size(names));
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        hl::radix_tree<std::size_t> tree;
+        tree.use_arena();
+        tree.assign_sorted(sortedLeaves.begin(), sortedLeaves.end());
+    });
+}
+
+static hl::radix_tree<std::size_t> make_radix_tree(
+    const std::vector<std::string>& names)
+{
+    hl::radix_tree<std::size_t> tree;
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        tree.insert(names[i], i);
+    }
+
+    return tree;
+}
+
+HLB_BENCHMARK("radix_tree/find")
+{
+    const auto names = get_names(state);
+    const auto tree = make_radix_tree(names);
+    std::size_t sum = 0;
+
+    state.set_bytes(get_total_size(names));
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        for (const auto& name : names)
+        {
+            sum += *tree.get(name.c_str());
+        }
+    });
+
+    // NOTE: Use the sum so the lookups can't be optimized away.
+    if (sum == 0) state.skip("Unexpected lookup results.");
+}
+
+HLB_BENCHMARK("radix_tree/copy")
+{
+    const auto names = get_names(state);
+    const auto tree = make_radix_tree(names);
+
+    state.set_bytes(get_total_size(names));
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        hl::radix_tree<std::size_t> treeCopy(tree);
+    });
+}
+
+/* ordered_map */
+static hl::ordered_map<std::string, std::size_t> make_ordered_map(
+    const std::vector<std::string>& names)
+{
+    hl::ordered_map<std::string, std::size_t> map;
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        map.emplace(names[i], i);
+    }
+
+    return map;
+}
+
+HLB_BENCHMARK("ordered_map/insert")
+{
+    const auto names = get_names(state);
+
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        make_ordered_map(names);
+    });
+}
+
+HLB_BENCHMARK("ordered_map/find")
+{
+    const auto names = get_names(state);
+    const auto map = make_ordered_map(names);
+    std::size_t sum = 0;
+
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        for (const auto& name : names)
+        {
+            sum += map.find(name)->second;
+        }
+    });
+
+    // NOTE: Use the sum so the lookups can't be optimized away.
+    if (sum == 0) state.skip("Unexpected lookup results.");
+}
+
+HLB_BENCHMARK("ordered_map/erase_half")
+{
+    const auto names = get_names(state);
+    hl::ordered_map<std::string, std::size_t> map;
+
+    // Measure erasing every other element, in insertion order.
+    state.set_items(names.size() / 2);
+    state.run([&]()
+    {
+        map = make_ordered_map(names);
+    },
+    [&]()
+    {
+        for (std::size_t i = 0; i < names.size(); i += 2)
+        {
+            map.erase(names[i]);
+        }
+    });
+}
+
+HLB_BENCHMARK("ordered_map/iterate")
+{
+    const auto names = get_names(state);
+    auto map = make_ordered_map(names);
+    std::size_t sum = 0;
+
+    // Erase some elements first, so iteration has to skip over them.
+    for (std::size_t i = 0; i < names.size(); i += 3)
+    {
+        map.erase(names[i]);
+    }
+
+    state.set_items(map.size());
+    state.run([&]()
+    {
+        for (const auto& it : map)
+        {
+            sum += it.second;
+        }
+    });
+
+    // NOTE: Use the sum so the iteration can't be optimized away.
+    if (sum == 0) state.skip("Unexpected iteration results.");
+}
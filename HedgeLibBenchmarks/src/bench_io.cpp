@@ -0,0 +1,296 @@
+#include "bench.h"
+#include <hedgelib/io/hl_bina.h>
+#include <hedgelib/io/hl_mem_stream.h>
+#include <hedgelib/hl_compression.h>
+#include <hedgelib/hl_blob.h>
+#include <cstddef>
+#include <cstring>
+
+/* BINA */
+struct bench_raw_record
+{
+    hl::off64<char> name;
+    hl::u32 id;
+    hl::u32 flags;
+    float position[3];
+    float scale;
+
+    template<bool swapOffsets = true>
+    void endian_swap() noexcept
+    {
+        hl::endian_swap<swapOffsets>(name);
+        hl::endian_swap(id);
+        hl::endian_swap(flags);
+        hl::endian_swap(position[0]);
+        hl::endian_swap(position[1]);
+        hl::endian_swap(position[2]);
+        hl::endian_swap(scale);
+    }
+};
+
+struct bench_raw_records
+{
+    hl::off64<bench_raw_record> records;
+    hl::u64 recordCount;
+
+    template<bool swapOffsets = true>
+    void endian_swap() noexcept
+    {
+        hl::endian_swap<swapOffsets>(records);
+        hl::endian_swap(recordCount);
+    }
+};
+
+static void write_bina_records(hl::bina::endian_flag endianFlag,
+    const std::vector<std::string>& names, hl::stream& stream)
+{
+    hl::bina::v2::writer64 writer(stream);
+    writer.start(endianFlag);
+    writer.start_data_block();
+
+    // Write header.
+    bench_raw_records rawRecords;
+    const std::size_t headerPos = stream.tell();
+
+    rawRecords.records = nullptr;
+    rawRecords.recordCount = static_cast<hl::u64>(names.size());
+
+    writer.swap_and_write_obj(rawRecords);
+    writer.fix_offset(headerPos + offsetof(bench_raw_records, records));
+
+    // Write records.
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        bench_raw_record rawRecord;
+        const std::size_t recordPos = stream.tell();
+
+        rawRecord.name = nullptr;
+        rawRecord.id = static_cast<hl::u32>(i);
+        rawRecord.flags = static_cast<hl::u32>(i * 2654435761U);
+        rawRecord.position[0] = static_cast<float>(i);
+        rawRecord.position[1] = 0;
+        rawRecord.position[2] = static_cast<float>(i) * -0.5f;
+        rawRecord.scale = 1;
+
+        writer.swap_and_write_obj(rawRecord);
+        writer.add_string(names[i], recordPos + offsetof(bench_raw_record, name));
+    }
+
+    // Finish writing.
+    writer.finish_data_block();
+    writer.finish();
+}
+
+static void bench_bina_write(bench::state& state, hl::bina::endian_flag endianFlag)
+{
+    const auto names = bench::make_synthetic_names(20000 * state.opts().scale, 1);
+
+    // Get the size of the written data.
+    {
+        hl::mem_stream stream;
+        write_bina_records(endianFlag, names, stream);
+        state.set_bytes(stream.get_size());
+    }
+
+    state.set_items(names.size());
+    state.run([&]()
+    {
+        hl::mem_stream stream;
+        write_bina_records(endianFlag, names, stream);
+    });
+}
+
+static void bench_bina_fix(bench::state& state, hl::bina::endian_flag endianFlag)
+{
+    const auto names = bench::make_synthetic_names(20000 * state.opts().scale, 1);
+
+    // Write records.
+    hl::mem_stream stream;
+    write_bina_records(endianFlag, names, stream);
+
+    const auto data = stream.get_data_ptr<hl::u8>();
+    const std::vector<hl::u8> bina(data, data + stream.get_size());
+    std::vector<hl::u8> binaCopy;
+
+    state.set_bytes(bina.size());
+    state.set_items(names.size());
+
+    // Measure fixing a fresh copy of the data each iteration, as fixing happens in-place.
+    state.run([&]()
+    {
+        binaCopy = bina;
+    },
+    [&]()
+    {
+        hl::bina::fix_container64(binaCopy.data(), binaCopy.size());
+    });
+}
+
+HLB_BENCHMARK("bina/v2/write64 (little)")
+{
+    bench_bina_write(state, hl::bina::endian_flag::little);
+}
+
+HLB_BENCHMARK("bina/v2/write64 (big)")
+{
+    bench_bina_write(state, hl::bina::endian_flag::big);
+}
+
+HLB_BENCHMARK("bina/v2/fix64 (little)")
+{
+    bench_bina_fix(state, hl::bina::endian_flag::little);
+}
+
+HLB_BENCHMARK("bina/v2/fix64 (big)")
+{
+    bench_bina_fix(state, hl::bina::endian_flag::big);
+}
+
+/* Endian swapping */
+template<typename T>
+static void bench_endian_swap(bench::state& state, bool bulk)
+{
+    const auto data = bench::make_synthetic_data(
+        (16 * 1024 * 1024) * state.opts().scale, 3);
+
+    const std::size_t count = (data.size() / sizeof(T));
+    std::vector<T> values(count);
+    std::memcpy(values.data(), data.data(), count * sizeof(T));
+
+    state.set_bytes(count * sizeof(T));
+    state.set_items(count);
+    state.run([&]()
+    {
+        if (bulk)
+        {
+            hl::endian_swap_array(values.data(), values.size());
+        }
+        else
+        {
+            for (auto& value : values)
+            {
+                hl::endian_swap(value);
+            }
+        }
+    });
+}
+
+HLB_BENCHMARK("endian/u16 (one at a time)")
+{
+    bench_endian_swap<hl::u16>(state, false);
+}
+
+HLB_BENCHMARK("endian/u16 (bulk)")
+{
+    bench_endian_swap<hl::u16>(state, true);
+}
+
+HLB_BENCHMARK("endian/u32 (one at a time)")
+{
+    bench_endian_swap<hl::u32>(state, false);
+}
+
+HLB_BENCHMARK("endian/u32 (bulk)")
+{
+    bench_endian_swap<hl::u32>(state, true);
+}
+
+HLB_BENCHMARK("endian/u64 (one at a time)")
+{
+    bench_endian_swap<hl::u64>(state, false);
+}
+
+HLB_BENCHMARK("endian/u64 (bulk)")
+{
+    bench_endian_swap<hl::u64>(state, true);
+}
+
+HLB_BENCHMARK("endian/records (vertices)")
+{
+    // A typical HH terrain vertex: position, normal, tangent, binormal (float3 each),
+    // two UV sets (float16_2 each), and a color (d3d_color).
+    constexpr std::size_t vertexSize = 60;
+    const auto data = bench::make_synthetic_data(
+        (16 * 1024 * 1024) * state.opts().scale, 4);
+
+    const std::size_t vertexCount = (data.size() / vertexSize);
+    std::vector<hl::u8> vertices(data.begin(), data.begin() +
+        (vertexCount * vertexSize));
+
+    hl::u8 pattern[vertexSize];
+    for (std::size_t i = 0; i < 48; ++i)
+    {
+        pattern[i] = static_cast<hl::u8>(i ^ 3);
+    }
+
+    for (std::size_t i = 48; i < 56; ++i)
+    {
+        pattern[i] = static_cast<hl::u8>(i ^ 1);
+    }
+
+    for (std::size_t i = 56; i < 60; ++i)
+    {
+        pattern[i] = static_cast<hl::u8>(i ^ 3);
+    }
+
+    state.set_bytes(vertices.size());
+    state.set_items(vertexCount);
+    state.run([&]()
+    {
+        hl::endian_swap_records(vertices.data(),
+            vertexCount, vertexSize, pattern);
+    });
+}
+
+/* Compression */
+static void bench_compress(bench::state& state, hl::compress_type type)
+{
+    const auto data = bench::make_synthetic_data(
+        (8 * 1024 * 1024) * state.opts().scale, 2);
+
+    state.set_bytes(data.size());
+    state.run([&]()
+    {
+        hl::compress_blob(type, data.size(), data.data());
+    });
+}
+
+static void bench_decompress(bench::state& state, hl::compress_type type)
+{
+    const auto data = bench::make_synthetic_data(
+        (8 * 1024 * 1024) * state.opts().scale, 2);
+
+    const auto compressedData = hl::compress_blob(
+        type, data.size(), data.data());
+
+    std::vector<hl::u8> decompressedData(data.size());
+
+    // NOTE: Throughput is measured in terms of the decompressed data.
+    state.set_bytes(data.size());
+    state.run([&]()
+    {
+        hl::decompress_no_alloc(type, compressedData.size(),
+            compressedData.data(), decompressedData.size(),
+            decompressedData.data());
+    });
+}
+
+HLB_BENCHMARK("compression/lz4/compress")
+{
+    bench_compress(state, hl::compress_type::lz4);
+}
+
+HLB_BENCHMARK("compression/lz4/decompress")
+{
+    bench_decompress(state, hl::compress_type::lz4);
+}
+
+HLB_BENCHMARK("compression/deflate/compress")
+{
+    bench_compress(state, hl::compress_type::deflate);
+}
+
+HLB_BENCHMARK("compression/deflate/decompress")
+{
+    bench_decompress(state, hl::compress_type::deflate);
+}
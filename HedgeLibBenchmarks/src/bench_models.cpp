@@ -0,0 +1,166 @@
+#include "bench.h"
+#include <hedgelib/models/hl_hh_model.h>
+#include <hedgelib/io/hl_mem_stream.h>
+#include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_scene.h>
+#include <memory>
+
+// NOTE: HedgeLib has no way to generate meaningful models from scratch
+// yet, so these are only benchmarked with user data.
+
+template<typename model_t>
+static std::vector<hl::nstring> get_model_files(
+    bench::state& state, const hl::nchar* subDir)
+{
+    auto files = state.data_files(subDir, model_t::extension);
+    if (files.empty())
+    {
+        state.skip("No user-supplied data.");
+        return files;
+    }
+
+    std::size_t dataSize = 0;
+    for (const auto& filePath : files)
+    {
+        dataSize += hl::path::get_size(filePath);
+    }
+
+    state.set_bytes(dataSize);
+    state.set_items(files.size());
+    return files;
+}
+
+template<typename model_t>
+static void bench_model_load(bench::state& state, const hl::nchar* subDir)
+{
+    const auto files = get_model_files<model_t>(state, subDir);
+    if (files.empty()) return;
+
+    state.run([&]()
+    {
+        for (const auto& filePath : files)
+        {
+            model_t model(filePath.c_str());
+        }
+    });
+}
+
+template<typename model_t>
+static std::vector<std::unique_ptr<model_t>> load_models(
+    const std::vector<hl::nstring>& files)
+{
+    std::vector<std::unique_ptr<model_t>> models;
+    models.reserve(files.size());
+
+    for (const auto& filePath : files)
+    {
+        models.emplace_back(new model_t(filePath.c_str()));
+    }
+
+    return models;
+}
+
+template<typename model_t>
+static void bench_model_fix(bench::state& state, const hl::nchar* subDir)
+{
+    const auto files = get_model_files<model_t>(state, subDir);
+    if (files.empty()) return;
+
+    std::vector<hl::blob> rawModels;
+    std::vector<hl::blob> rawModelCopies;
+    rawModels.reserve(files.size());
+
+    for (const auto& filePath : files)
+    {
+        rawModels.emplace_back(filePath);
+    }
+
+    // Measure fixing a fresh copy of the data each iteration, as fixing happens in-place.
+    state.run([&]()
+    {
+        rawModelCopies = rawModels;
+    },
+    [&]()
+    {
+        for (auto& rawModel : rawModelCopies)
+        {
+            model_t::fix(rawModel);
+        }
+    });
+}
+
+template<typename model_t>
+static void bench_model_to_scene(bench::state& state, const hl::nchar* subDir)
+{
+    const auto files = get_model_files<model_t>(state, subDir);
+    if (files.empty()) return;
+
+    const auto models = load_models<model_t>(files);
+    state.run([&]()
+    {
+        hl::scene scene;
+        for (const auto& model : models)
+        {
+            model->add_to_scene(scene);
+        }
+    });
+}
+
+template<typename model_t>
+static void bench_model_save(bench::state& state, const hl::nchar* subDir)
+{
+    const auto files = get_model_files<model_t>(state, subDir);
+    if (files.empty()) return;
+
+    const auto models = load_models<model_t>(files);
+    state.run([&]()
+    {
+        for (const auto& model : models)
+        {
+            hl::mem_stream stream;
+            model->save(stream);
+        }
+    });
+}
+
+/* Skeletal models */
+HLB_BENCHMARK("models/skeletal/load (user)")
+{
+    bench_model_load<hl::hh::mirage::skeletal_model>(state, HL_NTEXT("models"));
+}
+
+HLB_BENCHMARK("models/skeletal/fix (user)")
+{
+    bench_model_fix<hl::hh::mirage::skeletal_model>(state, HL_NTEXT("models"));
+}
+
+HLB_BENCHMARK("models/skeletal/to_scene (user)")
+{
+    bench_model_to_scene<hl::hh::mirage::skeletal_model>(state, HL_NTEXT("models"));
+}
+
+HLB_BENCHMARK("models/skeletal/save (user)")
+{
+    bench_model_save<hl::hh::mirage::skeletal_model>(state, HL_NTEXT("models"));
+}
+
+/* Terrain models */
+HLB_BENCHMARK("models/terrain/load (user)")
+{
+    bench_model_load<hl::hh::mirage::terrain_model>(state, HL_NTEXT("terrain"));
+}
+
+HLB_BENCHMARK("models/terrain/fix (user)")
+{
+    bench_model_fix<hl::hh::mirage::terrain_model>(state, HL_NTEXT("terrain"));
+}
+
+HLB_BENCHMARK("models/terrain/to_scene (user)")
+{
+    bench_model_to_scene<hl::hh::mirage::terrain_model>(state, HL_NTEXT("terrain"));
+}
+
+HLB_BENCHMARK("models/terrain/save (user)")
+{
+    bench_model_save<hl::hh::mirage::terrain_model>(state, HL_NTEXT("terrain"));
+}
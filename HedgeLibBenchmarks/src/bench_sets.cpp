@@ -0,0 +1,329 @@
+#include "bench.h"
+#include <hedgelib/hh/hl_hh_gedit.h>
+#include <hedgelib/sets/hl_hson.h>
+#include <hedgelib/sets/hl_set_obj_type.h>
+#include <hedgelib/io/hl_mem_stream.h>
+#include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_blob.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+static std::unique_ptr<hl::set_object_type_database> load_templates(
+    bench::state& state, const hl::nchar* templatesFileName)
+{
+    const hl::nstring filePath = hl::path::combine(state.opts().templatesDir,
+        hl::nstring(templatesFileName));
+
+    if (state.opts().templatesDir.empty() || !hl::path::exists(filePath))
+    {
+        state.skip("The set object templates could not be found.");
+        return nullptr;
+    }
+
+    return std::unique_ptr<hl::set_object_type_database>(
+        new hl::set_object_type_database(filePath.c_str()));
+}
+
+/**
+    @brief Generates a HSON project whose objects use types from the given
+    database. The objects have no parameters, so the default values from
+    the database are used when writing them as gedits.
+*/
+static hl::hson::project make_synthetic_project(const bench::options& opts,
+    const hl::set_object_type_database& objTypeDB)
+{
+    // Get the object types we can use.
+    std::vector<std::string> typeNames;
+    for (const auto it : objTypeDB)
+    {
+        typeNames.emplace_back(it.first);
+    }
+
+    if (typeNames.empty())
+    {
+        throw std::runtime_error("The set object type database is empty.");
+    }
+
+    // Generate objects.
+    const std::size_t objCount = (2000 * opts.scale);
+    const auto names = bench::make_synthetic_names(objCount, 0);
+    hl::hson::project project;
+
+    project.metadata.name = "Benchmark";
+    project.metadata.author = "HedgeLibBenchmarks";
+
+    for (std::size_t i = 0; i < objCount; ++i)
+    {
+        // Generate a deterministic, non-zero guid for this object.
+        hl::guid id(nullptr);
+        const hl::u64 idVal = (static_cast<hl::u64>(i) + 1);
+
+        std::memcpy(id.data.data(), &idVal, sizeof(idVal));
+        id.data[15] = 0x42;
+
+        // Setup object.
+        hl::hson::object obj;
+        obj.name = names[i];
+        obj.type = typeNames[(i * 7) % typeNames.size()];
+        obj.position = hl::vec3(static_cast<float>(i % 100) * 10.0f,
+            static_cast<float>(i % 7), static_cast<float>(i / 100) * -10.0f);
+
+        obj.rotation = hl::quat(0, 0.3826834f, 0, 0.9238795f);
+
+        // Parent every fourth object to the object before it.
+        if (i % 4 == 3)
+        {
+            hl::guid parentID(nullptr);
+            std::memcpy(parentID.data.data(), &i, sizeof(hl::u64));
+            parentID.data[15] = 0x42;
+
+            obj.parentID = parentID;
+        }
+
+        project.objects.emplace(id, std::move(obj));
+    }
+
+    return project;
+}
+
+static std::vector<hl::u8> write_gedit_v3(const hl::hson::project& project,
+    const hl::set_object_type_database& objTypeDB)
+{
+    hl::mem_stream stream;
+    hl::hh::gedit::v3::save(project, objTypeDB,
+        hl::bina::endian_flag::little, stream);
+
+    const auto data = stream.get_data_ptr<hl::u8>();
+    return std::vector<hl::u8>(data, data + stream.get_size());
+}
+
+static std::vector<hl::u8> write_hson(const hl::hson::project& project)
+{
+    hl::mem_stream stream;
+    project.write(stream);
+
+    const auto data = stream.get_data_ptr<hl::u8>();
+    return std::vector<hl::u8>(data, data + stream.get_size());
+}
+
+/* Set object templates */
+HLB_BENCHMARK("set_obj_types/load (frontiers)")
+{
+    const hl::nstring filePath = hl::path::combine(state.opts().templatesDir,
+        hl::nstring(HL_NTEXT("frontiers.json")));
+
+    if (state.opts().templatesDir.empty() || !hl::path::exists(filePath))
+    {
+        state.skip("The set object templates could not be found.");
+        return;
+    }
+
+    state.set_bytes(hl::path::get_size(filePath));
+    state.run([&]()
+    {
+        hl::set_object_type_database objTypeDB(filePath.c_str());
+    });
+}
+
+/* HSON */
+HLB_BENCHMARK("hson/write")
+{
+    const auto objTypeDB = load_templates(state, HL_NTEXT("frontiers.json"));
+    if (!objTypeDB) return;
+
+    const auto project = make_synthetic_project(state.opts(), *objTypeDB);
+
+    state.set_bytes(write_hson(project).size());
+    state.set_items(project.objects.size());
+    state.run([&]()
+    {
+        hl::mem_stream stream;
+        project.write(stream);
+    });
+}
+
+HLB_BENCHMARK("hson/parse")
+{
+    const auto objTypeDB = load_templates(state, HL_NTEXT("frontiers.json"));
+    if (!objTypeDB) return;
+
+    const auto project = make_synthetic_project(state.opts(), *objTypeDB);
+    const auto data = write_hson(project);
+
+    state.set_bytes(data.size());
+    state.set_items(project.objects.size());
+    state.run([&]()
+    {
+        hl::hson::project parsedProject(data.data(), data.size());
+    });
+}
+
+HLB_BENCHMARK("hson/parse (user)")
+{
+    std::vector<hl::blob> files;
+    std::size_t dataSize = 0;
+
+    for (const auto& filePath : state.data_files(HL_NTEXT("hson"), HL_NTEXT(".hson")))
+    {
+        files.emplace_back(filePath);
+        dataSize += files.back().size();
+    }
+
+    if (files.empty())
+    {
+        state.skip("No user-supplied data.");
+        return;
+    }
+
+    state.set_bytes(dataSize);
+    state.run([&]()
+    {
+        for (const auto& file : files)
+        {
+            hl::hson::project project(file.data(), file.size());
+        }
+    });
+}
+
+/* Gedit V3 */
+HLB_BENCHMARK("gedit/v3/from_hson")
+{
+    const auto objTypeDB = load_templates(state, HL_NTEXT("frontiers.json"));
+    if (!objTypeDB) return;
+
+    const auto project = make_synthetic_project(state.opts(), *objTypeDB);
+
+    state.set_bytes(write_gedit_v3(project, *objTypeDB).size());
+    state.set_items(project.objects.size());
+    state.run([&]()
+    {
+        hl::mem_stream stream;
+        hl::hh::gedit::v3::save(project, *objTypeDB,
+            hl::bina::endian_flag::little, stream);
+    });
+}
+
+/**
+    @brief Measures fixing the given gedits and converting them to HSON.
+    Each iteration works on a fresh copy of the data, as fixing happens in-place.
+*/
+template<typename fix_func_t>
+static void bench_gedit_to_hson(bench::state& state,
+    const std::vector<std::vector<hl::u8>>& gedits,
+    const hl::set_object_type_database& objTypeDB, fix_func_t fixFunc)
+{
+    std::vector<std::vector<hl::u8>> geditCopies(gedits.size());
+    std::size_t dataSize = 0;
+
+    for (const auto& gedit : gedits)
+    {
+        dataSize += gedit.size();
+    }
+
+    state.set_bytes(dataSize);
+    state.run([&]()
+    {
+        // Setup.
+        for (std::size_t i = 0; i < gedits.size(); ++i)
+        {
+            geditCopies[i] = gedits[i];
+        }
+    },
+    [&]()
+    {
+        // Measure.
+        for (auto& gedit : geditCopies)
+        {
+            hl::hson::project project;
+            const auto rawWorld = fixFunc(gedit);
+            if (rawWorld) rawWorld->add_to_hson(project, &objTypeDB);
+        }
+    });
+}
+
+static std::vector<std::vector<hl::u8>> load_user_files(
+    bench::state& state, const hl::nchar* subDir)
+{
+    std::vector<std::vector<hl::u8>> files;
+    for (const auto& filePath : state.data_files(subDir, hl::hh::gedit::extension))
+    {
+        const hl::blob file(filePath);
+        files.emplace_back(file.data<hl::u8>(), file.data<hl::u8>() + file.size());
+    }
+
+    if (files.empty())
+    {
+        state.skip("No user-supplied data.");
+    }
+
+    return files;
+}
+
+static hl::hh::gedit::v1::raw_world* fix_gedit_v1(std::vector<hl::u8>& gedit)
+{
+    return hl::bina::fix32<hl::hh::gedit::v1::raw_world>(
+        gedit.data(), gedit.size());
+}
+
+static hl::hh::gedit::v2::raw_world* fix_gedit_v2(std::vector<hl::u8>& gedit)
+{
+    return hl::bina::fix64<hl::hh::gedit::v2::raw_world>(
+        gedit.data(), gedit.size());
+}
+
+static hl::hh::gedit::v3::raw_world* fix_gedit_v3(std::vector<hl::u8>& gedit)
+{
+    return hl::bina::fix64<hl::hh::gedit::v3::raw_world>(
+        gedit.data(), gedit.size());
+}
+
+HLB_BENCHMARK("gedit/v3/to_hson")
+{
+    const auto objTypeDB = load_templates(state, HL_NTEXT("frontiers.json"));
+    if (!objTypeDB) return;
+
+    const auto project = make_synthetic_project(state.opts(), *objTypeDB);
+    const std::vector<std::vector<hl::u8>> gedits =
+    {
+        write_gedit_v3(project, *objTypeDB)
+    };
+
+    state.set_items(project.objects.size());
+    bench_gedit_to_hson(state, gedits, *objTypeDB, fix_gedit_v3);
+}
+
+HLB_BENCHMARK("gedit/v3/to_hson (user)")
+{
+    const auto gedits = load_user_files(state, HL_NTEXT("gedit_v3"));
+    if (gedits.empty()) return;
+
+    const auto objTypeDB = load_templates(state, HL_NTEXT("frontiers.json"));
+    if (!objTypeDB) return;
+
+    bench_gedit_to_hson(state, gedits, *objTypeDB, fix_gedit_v3);
+}
+
+/* Gedit V1/V2 */
+// NOTE: HedgeLib can't write V1/V2 gedits yet, so these are only benchmarked with user data.
+HLB_BENCHMARK("gedit/v1/to_hson (user)")
+{
+    const auto gedits = load_user_files(state, HL_NTEXT("gedit_v1"));
+    if (gedits.empty()) return;
+
+    const auto objTypeDB = load_templates(state, HL_NTEXT("lostworld.json"));
+    if (!objTypeDB) return;
+
+    bench_gedit_to_hson(state, gedits, *objTypeDB, fix_gedit_v1);
+}
+
+HLB_BENCHMARK("gedit/v2/to_hson (user)")
+{
+    const auto gedits = load_user_files(state, HL_NTEXT("gedit_v2"));
+    if (gedits.empty()) return;
+
+    const auto objTypeDB = load_templates(state, HL_NTEXT("forces.json"));
+    if (!objTypeDB) return;
+
+    bench_gedit_to_hson(state, gedits, *objTypeDB, fix_gedit_v2);
+}
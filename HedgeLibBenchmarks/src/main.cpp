@@ -0,0 +1,386 @@
+#include "bench.h"
+#include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_tool_helpers.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+enum class output_format
+{
+    table,
+    json,
+    csv
+};
+
+static const char* get_status_name(bench::result_status status)
+{
+    switch (status)
+    {
+    case bench::result_status::ok:
+        return "ok";
+
+    case bench::result_status::skipped:
+        return "skipped";
+
+    default:
+        return "error";
+    }
+}
+
+static void print_usage(std::FILE* s)
+{
+    hl::nfputs(HL_NTEXT(
+        "Usage: HedgeLibBenchmarks [options]\n\n"
+        "Measures load/parse/save throughput, allocations, and peak memory usage\n"
+        "of HedgeLib's formats and containers, on synthetic and user-supplied data.\n\n"
+        "Options:\n"
+        "  --data=DIR           Also benchmark the files within DIR's sub-directories\n"
+        "                       (pacx_v2, pacx_v3, pacx_v4, ar, gedit_v1, gedit_v2,\n"
+        "                       gedit_v3, hson, models, terrain).\n"
+        "  --temp=DIR           Write temporary files to DIR (default: current directory).\n"
+        "  --templates=DIR      Load set object templates from DIR.\n"
+        "  --filter=STR         Only run benchmarks whose names contain STR.\n"
+        "  --min-time=SECONDS   Minimum measuring time per benchmark (default: 0.5).\n"
+        "  --min-iters=N        Minimum measured iterations per benchmark (default: 3).\n"
+        "  --max-iters=N        Maximum measured iterations per benchmark (default: 1000).\n"
+        "  --scale=N            Multiply the size of all synthetic data by N (default: 1).\n"
+        "  --format=FORMAT      Output format: table, json, or csv (default: table).\n"
+        "  --out=FILE           Write results to FILE instead of stdout.\n"
+        "  --list               List all benchmarks and exit.\n"
+        "  --help               Show this help and exit.\n"), s);
+}
+
+static void write_json_string(const std::string& str, std::FILE* f)
+{
+    std::fputc('"', f);
+
+    for (const char c : str)
+    {
+        switch (c)
+        {
+        case '"':
+            std::fputs("\\\"", f);
+            break;
+
+        case '\\':
+            std::fputs("\\\\", f);
+            break;
+
+        case '\n':
+            std::fputs("\\n", f);
+            break;
+
+        case '\r':
+            std::fputs("\\r", f);
+            break;
+
+        case '\t':
+            std::fputs("\\t", f);
+            break;
+
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                std::fprintf(f, "\\u%04x", static_cast<unsigned int>(c));
+            }
+            else
+            {
+                std::fputc(c, f);
+            }
+            break;
+        }
+    }
+
+    std::fputc('"', f);
+}
+
+static void write_csv_string(const std::string& str, std::FILE* f)
+{
+    std::fputc('"', f);
+
+    for (const char c : str)
+    {
+        if (c == '"') std::fputc('"', f);
+        std::fputc(c, f);
+    }
+
+    std::fputc('"', f);
+}
+
+static void write_json(const std::vector<bench::result>& results, std::FILE* f)
+{
+    std::fputs("{\n  \"benchmarks\": [", f);
+
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& res = results[i];
+        std::fputs((i == 0) ? "\n    {\n" : ",\n    {\n", f);
+
+        std::fputs("      \"name\": ", f);
+        write_json_string(res.name, f);
+        std::fprintf(f, ",\n      \"status\": \"%s\"", get_status_name(res.status));
+
+        if (!res.message.empty())
+        {
+            std::fputs(",\n      \"message\": ", f);
+            write_json_string(res.message, f);
+        }
+
+        if (res.status == bench::result_status::ok)
+        {
+            std::fprintf(f,
+                ",\n      \"iterations\": %llu"
+                ",\n      \"mean_seconds\": %.9g"
+                ",\n      \"min_seconds\": %.9g"
+                ",\n      \"bytes_per_iteration\": %llu"
+                ",\n      \"mb_per_second\": %.6g"
+                ",\n      \"items_per_iteration\": %llu"
+                ",\n      \"items_per_second\": %.6g"
+                ",\n      \"allocs_per_iteration\": %.6g"
+                ",\n      \"alloc_bytes_per_iteration\": %.6g"
+                ",\n      \"peak_heap_bytes\": %llu"
+                ",\n      \"peak_rss_bytes\": %llu",
+                static_cast<unsigned long long>(res.iterations),
+                res.meanSeconds, res.minSeconds,
+                static_cast<unsigned long long>(res.bytesPerIteration),
+                res.mb_per_sec(),
+                static_cast<unsigned long long>(res.itemsPerIteration),
+                res.items_per_sec(), res.allocsPerIteration,
+                res.allocBytesPerIteration,
+                static_cast<unsigned long long>(res.peakHeapBytes),
+                static_cast<unsigned long long>(res.peakRssBytes));
+        }
+
+        std::fputs("\n    }", f);
+    }
+
+    std::fputs("\n  ]\n}\n", f);
+}
+
+static void write_csv(const std::vector<bench::result>& results, std::FILE* f)
+{
+    std::fputs("name,status,message,iterations,mean_seconds,min_seconds,"
+        "bytes_per_iteration,mb_per_second,items_per_iteration,items_per_second,"
+        "allocs_per_iteration,alloc_bytes_per_iteration,peak_heap_bytes,"
+        "peak_rss_bytes\n", f);
+
+    for (const auto& res : results)
+    {
+        write_csv_string(res.name, f);
+        std::fprintf(f, ",%s,", get_status_name(res.status));
+        write_csv_string(res.message, f);
+
+        std::fprintf(f, ",%llu,%.9g,%.9g,%llu,%.6g,%llu,%.6g,%.6g,%.6g,%llu,%llu\n",
+            static_cast<unsigned long long>(res.iterations),
+            res.meanSeconds, res.minSeconds,
+            static_cast<unsigned long long>(res.bytesPerIteration),
+            res.mb_per_sec(),
+            static_cast<unsigned long long>(res.itemsPerIteration),
+            res.items_per_sec(), res.allocsPerIteration,
+            res.allocBytesPerIteration,
+            static_cast<unsigned long long>(res.peakHeapBytes),
+            static_cast<unsigned long long>(res.peakRssBytes));
+    }
+}
+
+static void write_table(const std::vector<bench::result>& results, std::FILE* f)
+{
+    constexpr double mib = (1024.0 * 1024.0);
+
+    std::fprintf(f, "%-36s %8s %12s %10s %12s %12s %12s %11s %11s\n",
+        "Benchmark", "Iters", "Mean (ms)", "MB/s", "Items/s",
+        "Allocs/iter", "Alloc MB/it", "Peak heap", "Peak RSS");
+
+    for (const auto& res : results)
+    {
+        if (res.status != bench::result_status::ok)
+        {
+            std::fprintf(f, "%-36s %s: %s\n", res.name.c_str(),
+                get_status_name(res.status), res.message.c_str());
+
+            continue;
+        }
+
+        std::fprintf(f, "%-36s %8llu %12.3f %10.1f %12.0f %12.1f %12.2f %9.1fMB %9.1fMB\n",
+            res.name.c_str(), static_cast<unsigned long long>(res.iterations),
+            res.meanSeconds * 1000.0, res.mb_per_sec(), res.items_per_sec(),
+            res.allocsPerIteration, res.allocBytesPerIteration / mib,
+            res.peakHeapBytes / mib, res.peakRssBytes / mib);
+    }
+}
+
+static std::FILE* open_output_file(const hl::nchar* filePath)
+{
+#ifdef HL_IN_WIN32_UNICODE
+    return _wfopen(filePath, L"w");
+#else
+    return std::fopen(filePath, "w");
+#endif
+}
+
+static bool parse_flag(const hl::nchar* arg, const hl::nchar* name,
+    const hl::nchar*& value)
+{
+    const std::size_t nameLen = hl::text::len(name);
+    if (!hl::text::equal(arg, name, nameLen)) return false;
+
+    value = (arg + nameLen);
+    return true;
+}
+
+int HL_NMAIN(int argc, hl::nchar* argv[])
+{
+    bench::options opts;
+    output_format format = output_format::table;
+    const hl::nchar* outPath = nullptr;
+    bool listOnly = false;
+
+#ifdef HLB_DEFAULT_TEMPLATES_DIR
+    opts.templatesDir = hl::text::conv<hl::text::utf8_to_native>(
+        HLB_DEFAULT_TEMPLATES_DIR);
+#endif
+
+    // Parse arguments.
+    for (int i = 1; i < argc; ++i)
+    {
+        const hl::nchar* value;
+
+        if (parse_flag(argv[i], HL_NTEXT("--data="), value))
+        {
+            opts.dataDir = value;
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--temp="), value))
+        {
+            opts.tempDir = value;
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--templates="), value))
+        {
+            opts.templatesDir = value;
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--filter="), value))
+        {
+            opts.filter = hl::text::conv<hl::text::native_to_utf8>(value);
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--min-time="), value))
+        {
+            opts.minTime = std::atof(hl::text::conv<
+                hl::text::native_to_utf8>(value).c_str());
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--min-iters="), value))
+        {
+            opts.minIterations = static_cast<unsigned int>(std::strtoul(
+                hl::text::conv<hl::text::native_to_utf8>(value).c_str(), nullptr, 10));
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--max-iters="), value))
+        {
+            opts.maxIterations = static_cast<unsigned int>(std::strtoul(
+                hl::text::conv<hl::text::native_to_utf8>(value).c_str(), nullptr, 10));
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--scale="), value))
+        {
+            opts.scale = static_cast<std::size_t>(std::strtoul(
+                hl::text::conv<hl::text::native_to_utf8>(value).c_str(), nullptr, 10));
+
+            if (opts.scale == 0) opts.scale = 1;
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--format="), value))
+        {
+            if (hl::text::iequal(value, HL_NTEXT("table")))
+            {
+                format = output_format::table;
+            }
+            else if (hl::text::iequal(value, HL_NTEXT("json")))
+            {
+                format = output_format::json;
+            }
+            else if (hl::text::iequal(value, HL_NTEXT("csv")))
+            {
+                format = output_format::csv;
+            }
+            else
+            {
+                hl::nfprintf(stderr, HL_NTEXT("ERROR: Unknown format \"%s\".\n"), value);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (parse_flag(argv[i], HL_NTEXT("--out="), value))
+        {
+            outPath = value;
+        }
+        else if (hl::text::equal(argv[i], HL_NTEXT("--list")))
+        {
+            listOnly = true;
+        }
+        else if (hl::text::equal(argv[i], HL_NTEXT("--help")))
+        {
+            print_usage(stdout);
+            return EXIT_SUCCESS;
+        }
+        else
+        {
+            hl::nfprintf(stderr, HL_NTEXT("ERROR: Unknown argument \"%s\".\n\n"), argv[i]);
+            print_usage(stderr);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (opts.minIterations == 0) opts.minIterations = 1;
+    if (opts.maxIterations < opts.minIterations)
+    {
+        opts.maxIterations = opts.minIterations;
+    }
+
+    if (opts.tempDir.empty()) opts.tempDir = HL_NTEXT(".");
+
+    // List benchmarks if requested.
+    if (listOnly)
+    {
+        for (const auto& name : bench::get_benchmark_names(opts.filter))
+        {
+            std::puts(name.c_str());
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+    // Run benchmarks.
+    const auto results = bench::run_all(opts);
+
+    // Write results.
+    std::FILE* f = stdout;
+    if (outPath)
+    {
+        f = open_output_file(outPath);
+        if (!f)
+        {
+            hl::nfprintf(stderr, HL_NTEXT("ERROR: Could not open \"%s\" for writing.\n"), outPath);
+            return EXIT_FAILURE;
+        }
+    }
+
+    switch (format)
+    {
+    case output_format::json:
+        write_json(results, f);
+        break;
+
+    case output_format::csv:
+        write_csv(results, f);
+        break;
+
+    default:
+        write_table(results, f);
+        break;
+    }
+
+    if (f != stdout) std::fclose(f);
+
+    // Return failure if any benchmark ran into an error.
+    for (const auto& res : results)
+    {
+        if (res.status == bench::result_status::error)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+#include "hedgerender/base/hr_job_system.h"
+#include <system_error>
+
+namespace hr
+{
+void thread_pool::in_run_jobs(unsigned int threadIndex) noexcept
+{
+    unsigned int jobIndex;
+    while ((jobIndex = m_nextJobIndex.fetch_add(1,
+        std::memory_order_relaxed)) < m_jobCount)
+    {
+        try
+        {
+            (*m_func)(jobIndex, threadIndex);
+        }
+        catch (...)
+        {
+            // Store the first exception that was thrown, and skip all remaining jobs.
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception)
+            {
+                m_exception = std::current_exception();
+            }
+
+            m_nextJobIndex.store(m_jobCount, std::memory_order_relaxed);
+        }
+    }
+}
+
+void thread_pool::in_worker_main(unsigned int threadIndex) noexcept
+{
+    std::uint64_t lastGeneration = 0;
+    while (true)
+    {
+        // Wait for new jobs to be run (or for the pool to be stopped).
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [&]()
+            {
+                return (m_isStopping || m_generation != lastGeneration);
+            });
+
+            if (m_isStopping) return;
+            lastGeneration = m_generation;
+        }
+
+        // Run jobs until there are none left.
+        in_run_jobs(threadIndex);
+
+        // Let run() know this worker has finished.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busyWorkerCount == 0)
+        {
+            m_doneCondition.notify_one();
+        }
+    }
+}
+
+void thread_pool::run(unsigned int jobCount, const job_func& func)
+{
+    // Just run jobs on this thread if using more threads wouldn't help.
+    if (m_workers.empty() || jobCount <= 1)
+    {
+        for (unsigned int i = 0; i < jobCount; ++i)
+        {
+            func(i, 0);
+        }
+
+        return;
+    }
+
+    // Setup jobs and wake up workers.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = &func;
+        m_jobCount = jobCount;
+        m_nextJobIndex.store(0, std::memory_order_relaxed);
+        m_busyWorkerCount = static_cast<unsigned int>(m_workers.size());
+        m_exception = nullptr;
+        ++m_generation;
+    }
+
+    m_workCondition.notify_all();
+
+    // Run jobs on this thread as well, then wait for the workers to finish.
+    in_run_jobs(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [&]()
+    {
+        return (m_busyWorkerCount == 0);
+    });
+
+    m_func = nullptr;
+
+    // Re-throw the first exception that was thrown, if any.
+    if (m_exception)
+    {
+        std::rethrow_exception(std::move(m_exception));
+    }
+}
+
+thread_pool::thread_pool(unsigned int threadCount)
+{
+    // Determine how many threads to use.
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+
+    // Start worker threads.
+    // (NOTE: If a thread can't be started, we just make do with the ones we have.)
+    if (threadCount > 1)
+    {
+        m_workers.reserve(threadCount - 1);
+
+        try
+        {
+            for (unsigned int i = 1; i < threadCount; ++i)
+            {
+                m_workers.emplace_back(&thread_pool::in_worker_main, this, i);
+            }
+        }
+        catch (const std::system_error&) {}
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    // Stop and wait for all worker threads.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+
+    m_workCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+} // hr
@@ -23,15 +23,28 @@ void cmd_list::copy_buffer(const buffer& src, buffer& dst)
         1, &vkCopyRegion);
 }
 
+void cmd_list::copy_buffer(const buffer& src, buffer& dst,
+    unsigned int regionCount, const VkBufferCopy* regions)
+{
+    vkCmdCopyBuffer(m_vkCmdBuf, src.handle(), dst.handle(),
+        static_cast<uint32_t>(regionCount), regions);
+}
+
 void cmd_list::copy_buffer_to_image(const buffer& src,
     image& dst, VkImageLayout layout)
+{
+    copy_buffer_to_image(src, 0, dst, layout);
+}
+
+void cmd_list::copy_buffer_to_image(const buffer& src,
+    VkDeviceSize srcOffset, image& dst, VkImageLayout layout)
 {
     // Generate Vulkan buffer image copy regions.
     const auto vkCopyRegionCount = (dst.layer_count() * dst.mip_levels());
     hl::stack_or_heap_memory<VkBufferImageCopy, 16> vkCopyRegions(hl::no_value_init, vkCopyRegionCount);
     const in_vulkan_format_info fmtInfo(dst.format());
     VkBufferImageCopy* vkCurCopyRegion = vkCopyRegions.data();
-    VkDeviceSize vkCurBufOffset = 0;
+    VkDeviceSize vkCurBufOffset = srcOffset;
 
     for (unsigned int i = 0; i < dst.layer_count(); ++i)
     {
@@ -93,6 +106,44 @@ void cmd_list::transition_image_layout(image& img,
         0, 0, nullptr, 0, nullptr, 1, &vkImgMemoryBarrier);
 }
 
+void cmd_list::transition_image_layouts(unsigned int imageCount,
+    image* const* images, VkImageLayout oldLayout, VkImageLayout newLayout,
+    VkAccessFlags oldAccess, VkAccessFlags newAccess,
+    VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages)
+{
+    // Generate Vulkan image memory barriers.
+    hl::stack_or_heap_memory<VkImageMemoryBarrier, 16> vkImgMemoryBarriers(
+        hl::no_value_init, imageCount);
+
+    for (unsigned int i = 0; i < imageCount; ++i)
+    {
+        vkImgMemoryBarriers[i] =
+        {
+            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,                     // sType
+            nullptr,                                                    // pNext
+            static_cast<VkAccessFlags>(oldAccess),                      // srcAccessMask
+            static_cast<VkAccessFlags>(newAccess),                      // dstAccessMask
+            static_cast<VkImageLayout>(oldLayout),                      // oldLayout
+            static_cast<VkImageLayout>(newLayout),                      // newLayout
+            VK_QUEUE_FAMILY_IGNORED,                                    // srcQueueFamilyIndex
+            VK_QUEUE_FAMILY_IGNORED,                                    // dstQueueFamilyIndex
+            images[i]->handle(),                                        // image
+            {                                                           // subresourceRange
+                VK_IMAGE_ASPECT_COLOR_BIT,                              //  aspectMask
+                0,                                                      //  baseMipLevel
+                images[i]->mip_levels(),                                //  levelCount
+                0,                                                      //  baseArrayLayer
+                images[i]->layer_count()                                //  layerCount
+            }
+        };
+    }
+
+    // Transition all images at once.
+    vkCmdPipelineBarrier(m_vkCmdBuf, srcStages, dstStages,
+        0, 0, nullptr, 0, nullptr, static_cast<uint32_t>(imageCount),
+        vkImgMemoryBarriers.data());
+}
+
 void cmd_list::push_constants(const pipeline_layout& layout,
     VkShaderStageFlags vkShaderStages, unsigned int offset,
     unsigned int count, const void* values)
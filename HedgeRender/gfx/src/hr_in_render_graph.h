@@ -30,6 +30,7 @@ struct in_render_pass
 {
     std::vector<in_render_resource_transition> initialResTransitions;
     std::unique_ptr<render_pass> passData;
+    /** @brief Owned by the device's render pass cache; never destroyed by the graph. */
     VkRenderPass vkRenderPass = VK_NULL_HANDLE;
     std::size_t firstSubpassIndex;
     std::size_t subpassCount;
@@ -46,8 +47,6 @@ struct in_render_pass
 
     void transition_resources(cmd_list& cmdList);
 
-    void destroy(VkDevice vkDevice) noexcept;
-
     in_render_pass(std::vector<in_render_resource_transition>&& initialResTransitions,
         render_pass* pass, std::size_t firstSubpassIndex,
         std::size_t subpassCount, std::size_t firstClearValueIndex,
@@ -67,6 +66,9 @@ struct in_render_resource
 {
     gfx::image image;
     image_view imageView;
+    std::string debugName;
+    VkImageUsageFlags vkImageUsage = 0;
+    VkFormat vkFormat = VK_FORMAT_UNDEFINED;
     bool isValid = false;
 
     static constexpr memory_type in_get_memory_type(VkImageUsageFlags vkImageUsage) noexcept
@@ -89,9 +91,15 @@ struct in_render_resource
 
     in_render_resource() noexcept = default;
 
+    /**
+        @brief Re-creates this resource's image and image view with the given
+        size, keeping everything else (and the image's address) the same.
+    */
+    void recreate(render_device& device, unsigned int width, unsigned int height);
+
     in_render_resource(render_device& device, VkImageUsageFlags vkImageUsage,
         VkFormat vkFormat, unsigned int width, unsigned int height,
-        const char* debugName = "");
+        std::string debugName = "");
 };
 
 struct in_render_graph : public non_copyable
@@ -127,9 +135,30 @@ struct in_render_graph : public non_copyable
         of the framebuffers in this vector.
     */
     std::vector<VkFramebuffer> vkFramebuffers;
+
+    /**
+        @brief The render resources actually backed by images.
+
+        Transient resources whose lifetimes don't overlap can share the
+        same render resource, so this may contain fewer render resources
+        than there are resources in the graph; use resourceIndices to
+        get the render resource for a given resource ID.
+    */
     std::vector<in_render_resource> resources;
+
+    /** @brief The index within resources of each resource in the graph. */
+    std::vector<std::size_t> resourceIndices;
     std::vector<VkImageView> vkAttachments;
 
+    /**
+        @brief The index within resources of each attachment in vkAttachments,
+        or SIZE_MAX if the attachment is the screen output.
+    */
+    std::vector<std::size_t> attachmentResIndices;
+
+    /** @brief The size all of the render resources were created with. */
+    VkExtent2D vkResourceExtent = { 0, 0 };
+
     VkFramebuffer get_framebuffer(std::size_t renderPassIndex,
         std::size_t imageIndex) const;
 
@@ -138,11 +167,21 @@ struct in_render_graph : public non_copyable
 
     void create_framebuffers(const in_swap_chain& swapChain);
 
+    void destroy_framebuffers() noexcept;
+
+    /**
+        @brief Re-creates all render resources (and updates all attachments
+        which use them) if the swap chain size has changed since they were
+        created. Nothing else in the graph depends on the swap chain size.
+    */
+    void resize_resources(const in_swap_chain& swapChain);
+
     void destroy() noexcept;
 
     in_render_graph& operator=(in_render_graph&& other) noexcept;
 
-    in_render_graph(render_device& device, std::size_t resCount);
+    in_render_graph(render_device& device, std::size_t renderResCount,
+        std::vector<std::size_t>&& resourceIndices);
 
     in_render_graph(in_render_graph&& other) noexcept;
 
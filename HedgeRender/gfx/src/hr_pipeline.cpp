@@ -2,6 +2,7 @@
 #include "hedgerender/gfx/hr_pipeline.h"
 #include "hedgerender/gfx/hr_render_device.h"
 #include "hedgerender/gfx/hr_shader.h"
+#include <chrono>
 
 namespace hr
 {
@@ -385,13 +386,20 @@ static VkPipeline in_vulkan_create_pipeline(const hr::gfx::render_device& device
     };
 
     // Create Vulkan graphics pipeline.
+    const auto startTime = std::chrono::steady_clock::now();
     VkPipeline vkPipeline;
+
     if (vkCreateGraphicsPipelines(device.handle(), device.pipeline_cache(), 1,
         &vkPipelineCreateInfo, nullptr, &vkPipeline) != VK_SUCCESS)
     {
         throw std::runtime_error("Could not create Vulkan graphics pipeline");
     }
 
+    // Record how long it took to create the pipeline.
+    device.in_add_pipeline_create_time(static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startTime).count()));
+
     return vkPipeline;
 }
 
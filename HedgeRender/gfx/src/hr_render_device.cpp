@@ -5,6 +5,10 @@
 #include "hedgerender/gfx/hr_shader.h"
 #include "hedgerender/gfx/hr_surface.h"
 #include "hedgerender/gfx/hr_instance.h"
+#include <hedgelib/io/hl_file.h>
+#include <hedgelib/io/hl_path.h>
+#include <algorithm>
+#include <cstring>
 
 namespace hr
 {
@@ -106,6 +110,142 @@ void in_desc_pools::destroy(render_device& device) noexcept
     }
 }
 
+template<typename T>
+static void in_append_cache_key(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static void in_append_cache_key(std::string& key,
+    const T* data, uint32_t count)
+{
+    key.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count)
+    {
+        key.append(reinterpret_cast<const char*>(data), sizeof(T) * count);
+    }
+}
+
+static std::string in_vulkan_get_render_pass_key(
+    const VkRenderPassCreateInfo& vkRenderPassCreateInfo)
+{
+    // NOTE: None of the structs written directly here contain any pointers
+    // or padding, so their bytes alone are enough to tell them apart.
+    std::string key;
+    in_append_cache_key(key, vkRenderPassCreateInfo.flags);
+    in_append_cache_key(key, vkRenderPassCreateInfo.pAttachments,
+        vkRenderPassCreateInfo.attachmentCount);
+
+    // Write subpass descriptions, following their attachment pointers.
+    for (uint32_t i = 0; i < vkRenderPassCreateInfo.subpassCount; ++i)
+    {
+        const auto& vkSubpassDesc = vkRenderPassCreateInfo.pSubpasses[i];
+        in_append_cache_key(key, vkSubpassDesc.flags);
+        in_append_cache_key(key, vkSubpassDesc.pipelineBindPoint);
+        in_append_cache_key(key, vkSubpassDesc.pInputAttachments,
+            vkSubpassDesc.inputAttachmentCount);
+
+        in_append_cache_key(key, vkSubpassDesc.pColorAttachments,
+            vkSubpassDesc.colorAttachmentCount);
+
+        in_append_cache_key(key, vkSubpassDesc.pResolveAttachments,
+            (vkSubpassDesc.pResolveAttachments) ?
+            vkSubpassDesc.colorAttachmentCount : 0);
+
+        in_append_cache_key(key, vkSubpassDesc.pDepthStencilAttachment,
+            (vkSubpassDesc.pDepthStencilAttachment) ? 1 : 0);
+
+        in_append_cache_key(key, vkSubpassDesc.pPreserveAttachments,
+            vkSubpassDesc.preserveAttachmentCount);
+    }
+
+    in_append_cache_key(key, vkRenderPassCreateInfo.pDependencies,
+        vkRenderPassCreateInfo.dependencyCount);
+
+    return key;
+}
+
+VkRenderPass in_render_pass_cache::get(VkDevice vkDevice,
+    const VkRenderPassCreateInfo& vkRenderPassCreateInfo)
+{
+    // Return the existing Vulkan render pass if there is one.
+    std::string key = in_vulkan_get_render_pass_key(vkRenderPassCreateInfo);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = vkRenderPasses.find(key);
+    if (it != vkRenderPasses.end())
+    {
+        return it->second;
+    }
+
+    // Otherwise, create a new Vulkan render pass and cache it.
+    VkRenderPass vkRenderPass;
+    if (vkCreateRenderPass(vkDevice, &vkRenderPassCreateInfo,
+        nullptr, &vkRenderPass) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not create Vulkan render pass");
+    }
+
+    try
+    {
+        vkRenderPasses.emplace(std::move(key), vkRenderPass);
+    }
+    catch (...)
+    {
+        vkDestroyRenderPass(vkDevice, vkRenderPass, nullptr);
+        throw;
+    }
+
+    return vkRenderPass;
+}
+
+void in_render_pass_cache::destroy(VkDevice vkDevice) noexcept
+{
+    for (auto& it : vkRenderPasses)
+    {
+        vkDestroyRenderPass(vkDevice, it.second, nullptr);
+    }
+}
+
+void in_desc_set_cache::evict(VkDevice vkDevice, std::uint64_t minFrameIndex) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end();)
+    {
+        if (it->second.lastUsedFrameIndex < minFrameIndex)
+        {
+            vkFreeDescriptorSets(vkDevice, it->second.vkDescPool,
+                1, &it->second.vkDescSet);
+
+            it = entries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void in_desc_set_cache::clear(VkDevice vkDevice) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto vkDescPool : vkDescPools)
+    {
+        vkResetDescriptorPool(vkDevice, vkDescPool, 0);
+    }
+
+    entries.clear();
+}
+
+void in_desc_set_cache::destroy(VkDevice vkDevice) noexcept
+{
+    for (auto vkDescPool : vkDescPools)
+    {
+        vkDestroyDescriptorPool(vkDevice, vkDescPool, nullptr);
+    }
+}
+
 void in_swap_chain::create(VkPhysicalDevice vkPhyDev,
     VkDevice vkDevice, const in_queue_families& queueFamilies)
 {
@@ -319,6 +459,10 @@ in_per_frame_data::in_per_frame_data(render_device& device)
     }
 }
 
+in_staging_page::in_staging_page(render_device& device, std::size_t size) :
+    buf(device, memory_type::upload, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        size, &data) {}
+
 void in_per_thread_data::destroy(render_device& device) noexcept {}
 
 in_per_thread_data::in_per_thread_data(render_device& device) {}
@@ -401,6 +545,43 @@ in_per_frame_thread_data::in_per_frame_thread_data(
         transferCmdLists[i] = vkTransferCmdBufs[i];
     }
 }
+
+void in_per_frame_thread_data::reset_graphics_cmd_lists(render_device& device)
+{
+    if (vkResetCommandPool(device.handle(), vkGraphicsCmdPool, 0) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not reset Vulkan graphics command pool");
+    }
+
+    usedSecondaryCmdListCount = 0;
+}
+
+cmd_list& in_per_frame_thread_data::get_secondary_cmd_list(render_device& device)
+{
+    // Allocate a new Vulkan secondary command buffer if all existing ones are in use.
+    if (usedSecondaryCmdListCount == secondaryCmdLists.size())
+    {
+        const VkCommandBufferAllocateInfo vkCmdBufAllocInfo =
+        {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,             // sType
+            nullptr,                                                    // pNext
+            vkGraphicsCmdPool,                                          // commandPool
+            VK_COMMAND_BUFFER_LEVEL_SECONDARY,                          // level
+            1                                                           // commandBufferCount
+        };
+
+        VkCommandBuffer vkSecondaryCmdBuf;
+        if (vkAllocateCommandBuffers(device.handle(),
+            &vkCmdBufAllocInfo, &vkSecondaryCmdBuf) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Could not allocate Vulkan secondary command buffer");
+        }
+
+        secondaryCmdLists.emplace_back(vkSecondaryCmdBuf);
+    }
+
+    return secondaryCmdLists[usedSecondaryCmdListCount++];
+}
 } // internal
 
 void res_allocator::flush(uint32_t vmaAllocCount,
@@ -498,7 +679,7 @@ void render_device::wait_for_frame_render(unsigned int frameIndex, std::uint64_t
     }
 }
 
-bool render_device::is_upload_batch_done(std::uint64_t batchID) const
+std::uint64_t render_device::completed_upload_batch_id() const
 {
     uint64_t vkSemaphoreVal;
     if (vkGetSemaphoreCounterValue(m_vkDevice, m_vkUploadCompleteSemaphore,
@@ -507,7 +688,12 @@ bool render_device::is_upload_batch_done(std::uint64_t batchID) const
         throw std::runtime_error("Could not query status of upload batch");
     }
 
-    return (vkSemaphoreVal >= batchID);
+    return vkSemaphoreVal;
+}
+
+bool render_device::is_upload_batch_done(std::uint64_t batchID) const
+{
+    return (completed_upload_batch_id() >= batchID);
 }
 
 void render_device::wait_for_upload_batch(std::uint64_t batchID, std::uint64_t timeout) const
@@ -536,6 +722,48 @@ void render_device::wait_for_idle() const
     }
 }
 
+gfx::pipeline_cache_stats render_device::pipeline_cache_stats() const noexcept
+{
+    return
+    {
+        (m_pipelineCacheLoadedSize != 0),                               // isWarm
+        m_pipelineCacheLoadedSize,                                      // loadedSize
+        m_pipelineCount.load(std::memory_order_relaxed),                // pipelineCount
+        m_pipelineCreateTime.load(std::memory_order_relaxed)            // totalCreateTime
+    };
+}
+
+void render_device::save_pipeline_cache() const
+{
+    // Return early if we weren't given a path to save the pipeline cache to.
+    if (m_pipelineCachePath.empty()) return;
+
+    // Get pipeline cache data size.
+    std::size_t dataSize;
+    if (vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache,
+        &dataSize, nullptr) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not get Vulkan pipeline cache data size");
+    }
+
+    // Get pipeline cache data.
+    std::unique_ptr<std::uint8_t[]> data(new std::uint8_t[dataSize]);
+    if (vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache,
+        &dataSize, data.get()) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not get Vulkan pipeline cache data");
+    }
+
+    // Save pipeline cache data.
+    hl::file::save(data.get(), dataSize, m_pipelineCachePath);
+}
+
+void render_device::in_add_pipeline_create_time(std::uint64_t createTime) const noexcept
+{
+    m_pipelineCount.fetch_add(1, std::memory_order_relaxed);
+    m_pipelineCreateTime.fetch_add(createTime, std::memory_order_relaxed);
+}
+
 upload_batch render_device::start_upload_batch(unsigned int threadIndex)
 {
     // Get reference to data for the current frame/thread.
@@ -551,8 +779,10 @@ upload_batch render_device::start_upload_batch(unsigned int threadIndex)
     
     wait_for_upload_batch(curBatchData.curBatchID);
 
-    // Destroy all temporary upload buffers from the previous upload batch, if any.
-    curBatchData.uploadBuffers.clear();
+    // Destroy all dedicated staging pages from the previous upload batch, if any.
+    curBatchData.dedicatedStagingPages.clear();
+    curBatchData.bufferCopies.clear();
+    curBatchData.imageCopies.clear();
 
     // Reset Vulkan command buffer for this upload batch.
     VkCommandBuffer vkCmdBuf = curFrameThreadData.transferCmdLists[curBatchIndex].handle();
@@ -575,9 +805,9 @@ upload_batch render_device::start_upload_batch(unsigned int threadIndex)
         throw std::runtime_error("Could not begin recording Vulkan command buffer");
     }
 
-    // Set new upload batch ID and return new upload batch object.
-    curBatchData.curBatchID = ++m_curUploadBatchID;
-    return upload_batch(*this, curBatchData, vkCmdBuf);
+    // Return new upload batch object.
+    // NOTE: Its ID is assigned when it gets submitted.
+    return upload_batch(*this, curThreadData, curBatchData, vkCmdBuf);
 }
 
 static internal::in_desc_pool_types in_get_desc_pool_type(VkDescriptorType type)
@@ -803,6 +1033,184 @@ void render_device::update_shader_data(const shader_data_write_desc* shaderDataW
         vkWriteDescSets.data(), 0, nullptr);
 }
 
+static void in_append_shader_data_key(std::string& key,
+    const cached_shader_data_desc& desc)
+{
+    // NOTE: Write descriptions contain pointers and padding, so we write each
+    // member which affects the contents of the descriptor set individually.
+    in_append_cache_key(key, desc.paramGroup->handle());
+
+    for (std::size_t i = 0; i < desc.shaderDataWriteCount; ++i)
+    {
+        const auto& shaderDataWrite = desc.shaderDataWrites[i];
+        in_append_cache_key(key, shaderDataWrite.type);
+        in_append_cache_key(key, shaderDataWrite.firstRegisterIndex);
+        in_append_cache_key(key, shaderDataWrite.arrayElementIndex);
+        in_append_cache_key(key, shaderDataWrite.registerCount);
+
+        for (unsigned int i2 = 0; i2 < shaderDataWrite.registerCount; ++i2)
+        {
+            if (shaderDataWrite.imageWrites)
+            {
+                const auto& imageWrite = shaderDataWrite.imageWrites[i2];
+                in_append_cache_key(key, imageWrite.vkSampler);
+                in_append_cache_key(key, imageWrite.vkImageView);
+                in_append_cache_key(key, imageWrite.imageLayout);
+            }
+            else if (shaderDataWrite.bufferWrites)
+            {
+                const auto& bufferWrite = shaderDataWrite.bufferWrites[i2];
+                in_append_cache_key(key, bufferWrite.vkBuffer);
+                in_append_cache_key(key, bufferWrite.offset);
+                in_append_cache_key(key, bufferWrite.size);
+            }
+        }
+    }
+}
+
+static VkDescriptorSet in_vulkan_allocate_cached_desc_set(VkDevice vkDevice,
+    internal::in_desc_set_cache& descSetCache,
+    const internal::in_desc_pool_allocator& descPoolAllocator,
+    VkDescriptorSetLayout vkDescSetLayout, VkDescriptorPool& vkDescPool)
+{
+    using namespace internal;
+
+    // Generate Vulkan descriptor set allocate info.
+    VkDescriptorSetAllocateInfo vkDescSetAllocInfo =
+    {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,                 // sType
+        nullptr,                                                        // pNext
+        VK_NULL_HANDLE,                                                 // descriptorPool
+        1,                                                              // descriptorSetCount
+        &vkDescSetLayout                                                // pSetLayouts
+    };
+
+    // Attempt to allocate from the existing pools, newest first, as
+    // older pools may have had sets freed from them by evictions.
+    VkDescriptorSet vkDescSet;
+    for (auto it = descSetCache.vkDescPools.rbegin();
+        it != descSetCache.vkDescPools.rend(); ++it)
+    {
+        vkDescSetAllocInfo.descriptorPool = *it;
+        switch (vkAllocateDescriptorSets(vkDevice, &vkDescSetAllocInfo, &vkDescSet))
+        {
+        case VK_SUCCESS:
+            vkDescPool = *it;
+            return vkDescSet;
+
+        case VK_ERROR_FRAGMENTED_POOL:
+        case VK_ERROR_OUT_OF_POOL_MEMORY:
+            break;
+
+        default:
+            throw std::runtime_error("Could not allocate Vulkan descriptor sets.");
+        }
+    }
+
+    // All of the existing pools are full; create a new one.
+    const auto vkDescPoolSizes = descPoolAllocator.get_desc_pool_sizes();
+    const VkDescriptorPoolCreateInfo vkDescPoolCreateInfo =
+    {
+        VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,                  // sType
+        nullptr,                                                        // pNext
+        VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,              // flags
+        in_default_desc_pool_size,                                      // maxSets
+        static_cast<uint32_t>(vkDescPoolSizes.size()),                  // poolSizeCount
+        vkDescPoolSizes.data()                                          // pPoolSizes
+    };
+
+    descSetCache.vkDescPools.reserve(descSetCache.vkDescPools.size() + 1);
+    if (vkCreateDescriptorPool(vkDevice, &vkDescPoolCreateInfo,
+        nullptr, &vkDescPool) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not create Vulkan descriptor pool");
+    }
+
+    descSetCache.vkDescPools.push_back(vkDescPool);
+
+    // Allocate from the new pool.
+    vkDescSetAllocInfo.descriptorPool = vkDescPool;
+    if (vkAllocateDescriptorSets(vkDevice, &vkDescSetAllocInfo,
+        &vkDescSet) != VK_SUCCESS)
+    {
+        throw std::runtime_error("Could not allocate Vulkan descriptor sets.");
+    }
+
+    return vkDescSet;
+}
+
+void render_device::get_cached_shader_data(const cached_shader_data_desc* descs,
+    std::size_t descCount, shader_data* shaderDataHandles)
+{
+    using namespace internal;
+
+    assert(descs && shaderDataHandles && "Invalid arguments");
+
+    std::vector<shader_data_write_desc> shaderDataWrites;
+    std::string key;
+
+    // Lock the descriptor set cache mutex.
+    std::lock_guard<std::mutex> lock(m_descSetCache.mutex);
+
+    for (std::size_t i = 0; i < descCount; ++i)
+    {
+        // Generate the cache key for this shader data.
+        const auto& desc = descs[i];
+        key.clear();
+        in_append_shader_data_key(key, desc);
+
+        // Use the existing shader data if there is any.
+        const auto it = m_descSetCache.entries.find(key);
+        if (it != m_descSetCache.entries.end())
+        {
+            it->second.lastUsedFrameIndex = m_curTotalFrameIndex;
+            shaderDataHandles[i] = it->second.vkDescSet;
+            continue;
+        }
+
+        // Otherwise, allocate new shader data and add it to the cache.
+        VkDescriptorPool vkDescPool;
+        const VkDescriptorSet vkDescSet = in_vulkan_allocate_cached_desc_set(
+            m_vkDevice, m_descSetCache, m_globalDescPoolAllocator,
+            desc.paramGroup->handle(), vkDescPool);
+
+        try
+        {
+            m_descSetCache.entries.emplace(key, in_desc_set_cache_entry{
+                vkDescSet, vkDescPool, m_curTotalFrameIndex });
+        }
+        catch (...)
+        {
+            vkFreeDescriptorSets(m_vkDevice, vkDescPool, 1, &vkDescSet);
+            throw;
+        }
+
+        shaderDataHandles[i] = vkDescSet;
+
+        // Queue up writes for the new shader data.
+        for (std::size_t i2 = 0; i2 < desc.shaderDataWriteCount; ++i2)
+        {
+            shaderDataWrites.push_back(desc.shaderDataWrites[i2]);
+            shaderDataWrites.back().shaderData = vkDescSet;
+        }
+    }
+
+    // Write all of the new shader data at once.
+    if (!shaderDataWrites.empty())
+    {
+        update_shader_data(shaderDataWrites.data(), shaderDataWrites.size());
+    }
+}
+
+void render_device::clear_shader_data_cache()
+{
+    // Wait for Vulkan device to idle, as the cached shader data may still be in use.
+    wait_for_idle();
+
+    // Free all cached shader data.
+    m_descSetCache.clear(m_vkDevice);
+}
+
 void render_device::begin_frame()
 {
     // Wait for the current frame's fence to be signaled from the GPU.
@@ -819,6 +1227,12 @@ void render_device::begin_frame()
         throw std::runtime_error("Could not reset Vulkan fence");
     }
 
+    // Free cached shader data which hasn't been used by any frame still in flight.
+    if (m_curTotalFrameIndex >= m_frameCount)
+    {
+        m_descSetCache.evict(m_vkDevice, m_curTotalFrameIndex - m_frameCount + 1);
+    }
+
     // Acquire next image from Vulkan swap chain.
     VkResult vkResult;
     while ((vkResult = vkAcquireNextImageKHR(m_vkDevice, m_swapChain.vkSwapChain,
@@ -963,6 +1377,10 @@ void render_device::destroy() noexcept
     // Destroy per-frame descriptor pool allocator.
     m_perFrameDescPoolAllocator.destroy(*this);
 
+    // Destroy cached descriptor sets and render passes.
+    m_descSetCache.destroy(m_vkDevice);
+    m_renderPassCache.destroy(m_vkDevice);
+
     // Destroy swap chain data.
     m_swapChain.destroy(m_vkDevice);
 
@@ -972,6 +1390,26 @@ void render_device::destroy() noexcept
     // Destroy global descriptor pool allocator.
     m_globalDescPoolAllocator.destroy(*this);
 
+    // Report how long it took to create pipelines with this pipeline cache.
+    const auto stats = pipeline_cache_stats();
+    if (stats.pipelineCount)
+    {
+        HR_LOGF_INFO("Created %llu pipelines in %.3f ms using a %s pipeline cache",
+            static_cast<unsigned long long>(stats.pipelineCount),
+            static_cast<double>(stats.totalCreateTime) / 1000000.0,
+            (stats.isWarm) ? HL_NTEXT("warm") : HL_NTEXT("cold"));
+    }
+
+    // Save pipeline cache so the next device created can use it.
+    try
+    {
+        save_pipeline_cache();
+    }
+    catch (const std::exception&)
+    {
+        HR_LOG_WARN("Could not save Vulkan pipeline cache");
+    }
+
     // Destroy pipeline cache.
     vkDestroyPipelineCache(m_vkDevice, m_vkPipelineCache, nullptr);
 
@@ -1158,15 +1596,93 @@ static VkDevice in_vulkan_create_device(
     return vkDevice;
 }
 
-static VkPipelineCache in_vulkan_create_pipeline_cache(VkDevice vkDevice)
+/**
+    @brief The header at the beginning of all Vulkan pipeline cache data.
+    Equivalent to VkPipelineCacheHeaderVersionOne, which older Vulkan headers lack.
+*/
+struct in_vulkan_pipeline_cache_header
+{
+    uint32_t headerSize;
+    uint32_t headerVersion;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+};
+
+static bool in_vulkan_is_pipeline_cache_compatible(VkPhysicalDevice vkPhyDev,
+    const void* data, std::size_t dataSize)
+{
+    // Ensure the data is large enough to contain a header.
+    in_vulkan_pipeline_cache_header header;
+    if (dataSize < sizeof(header)) return false;
+
+    std::memcpy(&header, data, sizeof(header));
+
+    // Ensure the header is valid.
+    if (header.headerSize < sizeof(header) || header.headerSize > dataSize ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+    {
+        return false;
+    }
+
+    // Ensure the data was created by this exact device and driver.
+    VkPhysicalDeviceProperties vkPhyDevProps;
+    vkGetPhysicalDeviceProperties(vkPhyDev, &vkPhyDevProps);
+
+    return (header.vendorID == vkPhyDevProps.vendorID &&
+        header.deviceID == vkPhyDevProps.deviceID &&
+        std::memcmp(header.pipelineCacheUUID,
+            vkPhyDevProps.pipelineCacheUUID, VK_UUID_SIZE) == 0);
+}
+
+static hl::unique_buffer in_vulkan_load_pipeline_cache_data(
+    VkPhysicalDevice vkPhyDev, const hl::nchar* filePath,
+    std::size_t& dataSize) noexcept
 {
+    // Return early if there's no pipeline cache to load.
+    dataSize = 0;
+    if (!filePath) return nullptr;
+
+    // Load pipeline cache data.
+    hl::unique_buffer data;
+    try
+    {
+        if (!hl::path::exists(filePath)) return nullptr;
+        data = hl::file::load(filePath, &dataSize);
+    }
+    catch (const std::exception&)
+    {
+        HR_LOG_WARN("Could not load Vulkan pipeline cache; starting with an empty one");
+        dataSize = 0;
+        return nullptr;
+    }
+
+    // Discard the data if it isn't usable with this device.
+    if (!in_vulkan_is_pipeline_cache_compatible(vkPhyDev, data.get(), dataSize))
+    {
+        HR_LOG_INFO("Vulkan pipeline cache is out-of-date; starting with an empty one");
+        dataSize = 0;
+        return nullptr;
+    }
+
+    return data;
+}
+
+static VkPipelineCache in_vulkan_create_pipeline_cache(VkDevice vkDevice,
+    VkPhysicalDevice vkPhyDev, const hl::nchar* filePath, std::size_t& loadedSize)
+{
+    // Load pipeline cache data from the given file, if any.
+    const auto data = in_vulkan_load_pipeline_cache_data(
+        vkPhyDev, filePath, loadedSize);
+
+    // Create pipeline cache.
     const VkPipelineCacheCreateInfo vkPipelineCacheCreateInfo =
     {
         VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,                   // sType
         nullptr,                                                        // pNext
         0,                                                              // flags
-        0,                                                              // initialDataSize
-        nullptr                                                         // pInitialData
+        loadedSize,                                                     // initialDataSize
+        data.get()                                                      // pInitialData
     };
 
     VkPipelineCache vkPipelineCache;
@@ -1199,7 +1715,8 @@ static internal::in_swap_chain in_create_swap_chain_with_device_cleanup(
 
 render_device::render_device(const gfx::adapter& adapter,
     surface& surface, unsigned int width, unsigned int height,
-    unsigned int prefFrameBufCount, bool vsync, const char* debugName) :
+    unsigned int prefFrameBufCount, bool vsync, unsigned int threadCount,
+    const char* debugName, const hl::nchar* pipelineCachePath) :
 
     m_vkDevice(in_vulkan_create_device(adapter.parent().handle(),
         adapter.handle(), adapter.queue_families(),
@@ -1207,7 +1724,9 @@ render_device::render_device(const gfx::adapter& adapter,
 
     m_adapter(adapter),
     m_allocator(*this),
-    m_vkPipelineCache(in_vulkan_create_pipeline_cache(m_vkDevice)),
+    m_pipelineCachePath((pipelineCachePath) ? pipelineCachePath : HL_NTEXT("")),
+    m_vkPipelineCache(in_vulkan_create_pipeline_cache(m_vkDevice,
+        adapter.handle(), pipelineCachePath, m_pipelineCacheLoadedSize)),
 
     m_swapChain(in_create_swap_chain_with_device_cleanup(
         surface.m_vkSurface, adapter.handle(), m_vkDevice,
@@ -1257,7 +1776,7 @@ render_device::render_device(const gfx::adapter& adapter,
     }
 
     // Create per-thread data.
-    m_threadCount = 1; // TODO: Set to actual thread count!
+    m_threadCount = std::max(threadCount, 1U);
 
     try
     {
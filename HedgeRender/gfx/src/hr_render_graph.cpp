@@ -1,5 +1,6 @@
 #include "hr_in_render_graph.h"
 #include "hedgerender/gfx/hr_render_device.h"
+#include <algorithm>
 #include <memory>
 
 namespace hr
@@ -22,11 +23,6 @@ void in_render_pass::transition_resources(cmd_list& cmdList)
     }
 }
 
-void in_render_pass::destroy(VkDevice vkDevice) noexcept
-{
-    vkDestroyRenderPass(vkDevice, vkRenderPass, nullptr);
-}
-
 in_render_pass::in_render_pass(
     std::vector<in_render_resource_transition>&& initialResTransitions,
     render_pass* pass, std::size_t firstSubpassIndex,
@@ -48,15 +44,33 @@ in_render_subpass::in_render_subpass(render_subpass* subpass, uint32_t attachmen
     subpassData(subpass),
     vkColorAttachBlendStates(hl::no_value_init, attachmentCount) {}
 
+void in_render_resource::recreate(render_device& device,
+    unsigned int width, unsigned int height)
+{
+    // Destroy the old image view and image.
+    imageView = image_view();
+    image = gfx::image();
+
+    // Create a new image and image view with the new size.
+    image = gfx::image(device, in_get_memory_type(vkImageUsage), VK_IMAGE_TYPE_2D,
+        in_get_image_usage(vkImageUsage), vkFormat, width, height, 1, 1, 1,
+        (debugName.empty()) ? nullptr : debugName.c_str());
+
+    imageView = image_view(device, image, VK_IMAGE_VIEW_TYPE_2D);
+}
+
 in_render_resource::in_render_resource(render_device& device,
     VkImageUsageFlags vkImageUsage, VkFormat vkFormat,
-    unsigned int width, unsigned int height, const char* debugName) :
+    unsigned int width, unsigned int height, std::string debugName) :
     
     image(device, in_get_memory_type(vkImageUsage), VK_IMAGE_TYPE_2D,
         in_get_image_usage(vkImageUsage), vkFormat, width, height,
-        1, 1, 1, debugName),
+        1, 1, 1, (debugName.empty()) ? nullptr : debugName.c_str()),
     
     imageView(device, image, VK_IMAGE_VIEW_TYPE_2D),
+    debugName(std::move(debugName)),
+    vkImageUsage(vkImageUsage),
+    vkFormat(vkFormat),
     isValid(true) {}
 
 VkFramebuffer in_render_graph::get_framebuffer(
@@ -138,6 +152,51 @@ void in_render_graph::create_framebuffers(const in_swap_chain& swapChain)
     }
 }
 
+void in_render_graph::destroy_framebuffers() noexcept
+{
+    for (auto vkFramebuffer : vkFramebuffers)
+    {
+        vkDestroyFramebuffer(device->handle(), vkFramebuffer, nullptr);
+    }
+
+    vkFramebuffers.clear();
+    vkFramebuffersPerImagePass.clear();
+}
+
+void in_render_graph::resize_resources(const in_swap_chain& swapChain)
+{
+    // Return early if the render resources are already the right size.
+    const VkExtent2D& vkExtent = swapChain.vkSurfaceExtent;
+    if (vkExtent.width == vkResourceExtent.width &&
+        vkExtent.height == vkResourceExtent.height)
+    {
+        return;
+    }
+
+    // Wait for Vulkan device to idle, as the old images may still be in use.
+    device->wait_for_idle();
+
+    // Re-create render resources with the new size.
+    for (auto& renderRes : resources)
+    {
+        if (renderRes.isValid)
+        {
+            renderRes.recreate(*device, vkExtent.width, vkExtent.height);
+        }
+    }
+
+    // Update Vulkan attachments to use the new image views.
+    for (std::size_t i = 0; i < vkAttachments.size(); ++i)
+    {
+        if (attachmentResIndices[i] != SIZE_MAX)
+        {
+            vkAttachments[i] = resources[attachmentResIndices[i]].imageView.handle();
+        }
+    }
+
+    vkResourceExtent = vkExtent;
+}
+
 void in_render_graph::destroy() noexcept
 {
     // Return early if this graph is just an empty shell
@@ -148,16 +207,9 @@ void in_render_graph::destroy() noexcept
     device->wait_for_idle();
 
     // Destroy Vulkan framebuffers.
-    for (auto vkFramebuffer : vkFramebuffers)
-    {
-        vkDestroyFramebuffer(device->handle(), vkFramebuffer, nullptr);
-    }
-
-    // Destroy passes.
-    for (auto& pass : passes)
-    {
-        pass.destroy(device->handle());
-    }
+    // NOTE: The Vulkan render passes are owned by the device's
+    // render pass cache, so we don't destroy those here.
+    destroy_framebuffers();
 }
 
 in_render_graph& in_render_graph::operator=(in_render_graph&& other) noexcept
@@ -173,6 +225,10 @@ in_render_graph& in_render_graph::operator=(in_render_graph&& other) noexcept
         vkFramebuffersPerImagePass = std::move(other.vkFramebuffersPerImagePass);
         vkFramebuffers = std::move(other.vkFramebuffers);
         resources = std::move(other.resources);
+        resourceIndices = std::move(other.resourceIndices);
+        vkAttachments = std::move(other.vkAttachments);
+        attachmentResIndices = std::move(other.attachmentResIndices);
+        vkResourceExtent = other.vkResourceExtent;
 
         other.device = nullptr;
     }
@@ -180,9 +236,11 @@ in_render_graph& in_render_graph::operator=(in_render_graph&& other) noexcept
     return *this;
 }
 
-in_render_graph::in_render_graph(render_device& device, std::size_t resCount) :
+in_render_graph::in_render_graph(render_device& device, std::size_t renderResCount,
+    std::vector<std::size_t>&& resourceIndices) :
     device(&device),
-    resources(resCount) {}
+    resources(renderResCount),
+    resourceIndices(std::move(resourceIndices)) {}
 
 in_render_graph::in_render_graph(in_render_graph&& other) noexcept :
     device(other.device),
@@ -191,7 +249,11 @@ in_render_graph::in_render_graph(in_render_graph&& other) noexcept :
     vkClearValues(std::move(other.vkClearValues)),
     vkFramebuffersPerImagePass(std::move(other.vkFramebuffersPerImagePass)),
     vkFramebuffers(std::move(other.vkFramebuffers)),
-    resources(std::move(other.resources))
+    resources(std::move(other.resources)),
+    resourceIndices(std::move(other.resourceIndices)),
+    vkAttachments(std::move(other.vkAttachments)),
+    attachmentResIndices(std::move(other.attachmentResIndices)),
+    vkResourceExtent(other.vkResourceExtent)
 {
     other.device = nullptr;
 }
@@ -202,19 +264,16 @@ const image_view& render_graph::get_image_view(render_resource_id resID) const
     assert(resID != render_graph_builder::screen_output_id &&
         "The screen output is not a normal resource that is available for access.");
 
-    return m_renderGraph->resources[resID].imageView;
+    return m_renderGraph->resources[m_renderGraph->resourceIndices[resID]].imageView;
 }
 
 void render_graph::recreate_framebuffers(render_device& device)
 {
     // Destroy Vulkan framebuffers.
-    for (auto vkFramebuffer : m_renderGraph->vkFramebuffers)
-    {
-        vkDestroyFramebuffer(device.handle(), vkFramebuffer, nullptr);
-    }
+    m_renderGraph->destroy_framebuffers();
 
-    m_renderGraph->vkFramebuffers.clear();
-    m_renderGraph->vkFramebuffersPerImagePass.clear();
+    // Re-create render resources if the swap chain size has changed.
+    m_renderGraph->resize_resources(device.swap_chain());
 
     // Re-create Vulkan framebuffers.
     m_renderGraph->create_framebuffers(device.swap_chain());
@@ -477,23 +536,114 @@ static constexpr VkImageUsageFlags in_get_image_usage(
     return vkImageUsage;
 }
 
-render_graph render_graph_builder::build(render_device& device)
+struct in_render_resource_lifetime
+{
+    std::size_t firstPassIndex = SIZE_MAX;
+    std::size_t lastPassIndex = 0;
+    internal::in_attachment_type lastType = internal::in_attachment_type::none;
+};
+
+static std::size_t in_vulkan_alias_transient_resources(
+    const std::vector<render_pass_builder>& passes,
+    const std::vector<internal::in_render_resource_info>& resInfos,
+    hl::fixed_array<in_render_resource_state>& resState,
+    std::vector<std::size_t>& resIndices)
 {
     using namespace internal;
 
-    // Allocate render graph and graph creation resources.
-    std::unique_ptr<in_render_graph> graph(new in_render_graph(
-        device, m_resources.size()));
+    // Compute the range of passes each resource is used within.
+    std::vector<in_render_resource_lifetime> lifetimes(resInfos.size());
+    for (std::size_t passIndex = 0; passIndex < passes.size(); ++passIndex)
+    {
+        for (auto& subpass : passes[passIndex].subpasses())
+        {
+            for (auto attachInfo : subpass.attachments())
+            {
+                if (attachInfo.first == render_graph_builder::screen_output_id)
+                    continue;
 
-    std::vector<VkAttachmentDescription> vkAttachmentDescriptions;
-    std::vector<VkAttachmentReference> vkAttachmentReferences;
-    std::vector<uint32_t> vkPreserveAttachments;
-    std::vector<VkSubpassDescription> vkSubpassDescriptions;
-    std::vector<VkSubpassDependency> vkSubpassDependencies;
+                auto& lifetime = lifetimes[attachInfo.first];
+                if (lifetime.firstPassIndex == SIZE_MAX)
+                {
+                    lifetime.firstPassIndex = passIndex;
+                }
 
-    graph->passes.reserve(m_passes.size());
-    graph->vkFramebuffersPerImagePass.reserve(m_passes.size() *
-        device.m_swapChain.vkSwapChainImageCount);
+                lifetime.lastPassIndex = passIndex;
+                lifetime.lastType = attachInfo.second.type;
+            }
+        }
+    }
+
+    // Sort resources by the first pass they're used within.
+    std::vector<render_resource_id> sortedResIDs(resInfos.size());
+    for (std::size_t i = 0; i < sortedResIDs.size(); ++i)
+    {
+        sortedResIDs[i] = i;
+    }
+
+    std::stable_sort(sortedResIDs.begin(), sortedResIDs.end(),
+        [&lifetimes](render_resource_id a, render_resource_id b)
+        {
+            return (lifetimes[a].firstPassIndex < lifetimes[b].firstPassIndex);
+        });
+
+    // Assign a render resource to each resource, letting transient resources
+    // share the render resource of an earlier transient resource with the same
+    // usage and format whose lifetime ended in an earlier pass.
+    std::vector<render_resource_id> renderResOwners;
+    resIndices.resize(resInfos.size());
+
+    for (auto resID : sortedResIDs)
+    {
+        const auto& lifetime = lifetimes[resID];
+        auto& res = resState[resID + 1];
+        std::size_t renderResIndex = SIZE_MAX;
+
+        if (lifetime.firstPassIndex != SIZE_MAX &&
+            in_render_resource::in_get_memory_type(res.vkImageUsageFlags) ==
+            memory_type::transient)
+        {
+            for (std::size_t i = 0; i < renderResOwners.size(); ++i)
+            {
+                const auto ownerResID = renderResOwners[i];
+                const auto& owner = resState[ownerResID + 1];
+
+                if (owner.vkImageUsageFlags == res.vkImageUsageFlags &&
+                    resInfos[ownerResID].isDepthStencil == resInfos[resID].isDepthStencil &&
+                    lifetimes[ownerResID].lastPassIndex < lifetime.firstPassIndex)
+                {
+                    renderResIndex = i;
+                    break;
+                }
+            }
+        }
+
+        if (renderResIndex != SIZE_MAX)
+        {
+            // Make the first use of this resource wait on the last use
+            // of the resource that previously owned its render resource.
+            const auto prevLastType = lifetimes[renderResOwners[renderResIndex]].lastType;
+            res.needsDependency = true;
+            res.mostRecentStage = in_vulkan_get_stage_mask(prevLastType);
+            res.mostRecentAccess = in_vulkan_get_access_mask(prevLastType);
+
+            renderResOwners[renderResIndex] = resID;
+        }
+        else
+        {
+            renderResIndex = renderResOwners.size();
+            renderResOwners.push_back(resID);
+        }
+
+        resIndices[resID] = renderResIndex;
+    }
+
+    return renderResOwners.size();
+}
+
+render_graph render_graph_builder::build(render_device& device)
+{
+    using namespace internal;
 
     // Allocate temporary resource state array.
 
@@ -524,6 +674,27 @@ render_graph render_graph_builder::build(render_device& device)
         }
     }
 
+    // Assign render resources to resources, aliasing transient ones where possible.
+    std::vector<std::size_t> resIndices;
+    const std::size_t renderResCount = in_vulkan_alias_transient_resources(
+        m_passes, m_resources, resState, resIndices);
+
+    // Allocate render graph and graph creation resources.
+    std::unique_ptr<in_render_graph> graph(new in_render_graph(
+        device, renderResCount, std::move(resIndices)));
+
+    std::vector<VkAttachmentDescription> vkAttachmentDescriptions;
+    std::vector<VkAttachmentReference> vkAttachmentReferences;
+    std::vector<uint32_t> vkPreserveAttachments;
+    std::vector<VkSubpassDescription> vkSubpassDescriptions;
+    std::vector<VkSubpassDependency> vkSubpassDependencies;
+
+    graph->passes.reserve(m_passes.size());
+    graph->vkFramebuffersPerImagePass.reserve(m_passes.size() *
+        device.m_swapChain.vkSwapChainImageCount);
+
+    graph->vkResourceExtent = device.m_swapChain.vkSurfaceExtent;
+
     // Generate render passes.
     for (auto pass = m_passes.begin(); pass != m_passes.end(); ++pass)
     {
@@ -575,15 +746,22 @@ render_graph render_graph_builder::build(render_device& device)
                     if (attachInfo.first != screen_output_id)
                     {
                         // Create new render resource if necessary.
-                        auto& renderRes = graph->resources[attachInfo.first];
+                        const std::size_t renderResIndex =
+                            graph->resourceIndices[attachInfo.first];
+
+                        auto& renderRes = graph->resources[renderResIndex];
                         if (!renderRes.isValid)
                         {
                             renderRes = in_render_resource(device,
                                 res.vkImageUsageFlags, vkFormat,
-                                device.m_swapChain.vkSurfaceExtent.width,
-                                device.m_swapChain.vkSurfaceExtent.height,
-                                (resInfo.debugName.empty()) ? nullptr : resInfo.debugName.c_str());
+                                graph->vkResourceExtent.width,
+                                graph->vkResourceExtent.height,
+                                resInfo.debugName);
+                        }
 
+                        // Transition resource on its first use if necessary.
+                        if (res.mostRecentPass == nullptr)
+                        {
                             // TODO: Do we also need to do this with non-sampled input attachments?
                             if (in_is_input_attachment_sampled(attachInfo.second.type))
                             {
@@ -597,11 +775,13 @@ render_graph render_graph_builder::build(render_device& device)
 
                         // Generate Vulkan attachment.
                         graph->vkAttachments.push_back(renderRes.imageView.handle());
+                        graph->attachmentResIndices.push_back(renderResIndex);
                     }
                     else
                     {
                         // NOTE: This value will be filled in later by the call to create_framebuffers().
                         graph->vkAttachments.push_back(VK_NULL_HANDLE);
+                        graph->attachmentResIndices.push_back(SIZE_MAX);
                     }
 
                     // Set Vulkan attachment index for this resource/pass.
@@ -840,7 +1020,8 @@ render_graph render_graph_builder::build(render_device& device)
         auto& graphPass = graph->passes.back();
         pass->release_data();
 
-        // Create Vulkan render pass.
+        // Get Vulkan render pass from the device's render pass cache, creating it
+        // only if no identical render pass has been created on this device before.
         const VkRenderPassCreateInfo vkRenderPassCreateInfo =
         {
             VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,                  // sType
@@ -854,11 +1035,8 @@ render_graph render_graph_builder::build(render_device& device)
             vkSubpassDependencies.data()                                // pDependencies
         };
 
-        if (vkCreateRenderPass(device.m_vkDevice, &vkRenderPassCreateInfo,
-            nullptr, &graphPass.vkRenderPass) != VK_SUCCESS)
-        {
-            throw std::runtime_error("Could not create Vulkan render pass");
-        }
+        graphPass.vkRenderPass = device.m_renderPassCache.get(
+            device.m_vkDevice, vkRenderPassCreateInfo);
 
         // Clear vectors for next loop iteration.
         vkAttachmentDescriptions.clear();
@@ -2,13 +2,136 @@
 #include "hedgerender/gfx/hr_renderer.h"
 #include "hedgerender/gfx/hr_render_device.h"
 #include "hedgerender/gfx/hr_render_graph.h"
+#include <hedgerender/base/hr_job_system.h>
 
 namespace hr
 {
 namespace gfx
 {
+static void in_vulkan_set_dynamic_state(const render_device& device,
+    const internal::in_render_pass& pass, VkCommandBuffer vkCmdBuf)
+{
+    // Set Vulkan dynamic viewport state if requested.
+    auto& vkSurfaceExtent = device.swap_chain().vkSurfaceExtent;
+    if (pass.doUpdateViewport)
+    {
+        const VkViewport vkViewports[] =
+        {
+            0.0f,                                                       // x
+            0.0f,                                                       // y
+            static_cast<float>(vkSurfaceExtent.width),                  // width
+            static_cast<float>(vkSurfaceExtent.height),                 // height
+            0.0f,                                                       // minDepth
+            1.0f                                                        // maxDepth
+        };
+
+        vkCmdSetViewport(vkCmdBuf, 0, 1, vkViewports);
+    }
+    
+    // Set Vulkan dynamic scissor state if requested.
+    if (pass.doUpdateScissor)
+    {
+        const VkRect2D vkScissors[] =
+        {
+            {
+                {                                                       // offset
+                    0,                                                  //  x
+                    0                                                   //  y
+                },
+
+                vkSurfaceExtent                                         // extent
+            }
+        };
+
+        vkCmdSetScissor(vkCmdBuf, 0, 1, vkScissors);
+    }
+}
+
+static void in_vulkan_record_subpasses(render_device& device,
+    internal::in_render_graph& graph, job_system& jobs,
+    const VkFramebuffer* vkFramebuffers, VkCommandBuffer* vkSecondaryCmdBufs)
+{
+    using namespace internal;
+
+    // Reset Vulkan graphics command pools for every other job thread.
+    // NOTE: The calling thread's command pool has already been reset.
+    const unsigned int curFrameIndex = device.cur_frame_index();
+    for (unsigned int i = 1; i < jobs.thread_count(); ++i)
+    {
+        device.per_frame_thread_data(curFrameIndex, i)
+            .reset_graphics_cmd_lists(device);
+    }
+
+    // Get the index of the pass each subpass belongs to.
+    hl::stack_or_heap_memory<std::size_t, 32> subpassPassIndices(
+        hl::no_value_init, graph.subpasses.size());
+
+    for (std::size_t passIndex = 0; passIndex < graph.passes.size(); ++passIndex)
+    {
+        const auto& pass = graph.passes[passIndex];
+        for (std::size_t i = 0; i < pass.subpassCount; ++i)
+        {
+            subpassPassIndices[pass.firstSubpassIndex + i] = passIndex;
+        }
+    }
+
+    // Record every subpass into its own secondary command list, in parallel.
+    jobs.run(static_cast<unsigned int>(graph.subpasses.size()),
+        [&](unsigned int subpassIndex, unsigned int threadIndex)
+        {
+            const auto passIndex = subpassPassIndices[subpassIndex];
+            const auto& pass = graph.passes[passIndex];
+            auto& cmdList = device.per_frame_thread_data(curFrameIndex,
+                threadIndex).get_secondary_cmd_list(device);
+
+            // Begin recording Vulkan secondary command buffer.
+            const VkCommandBufferInheritanceInfo vkCmdBufInheritanceInfo =
+            {
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,      // sType
+                nullptr,                                                // pNext
+                pass.vkRenderPass,                                      // renderPass
+                static_cast<uint32_t>(subpassIndex -                    // subpass
+                    pass.firstSubpassIndex),
+                vkFramebuffers[passIndex],                              // framebuffer
+                VK_FALSE,                                               // occlusionQueryEnable
+                0,                                                      // queryFlags
+                0                                                       // pipelineStatistics
+            };
+
+            const VkCommandBufferBeginInfo vkCmdBufBeginInfo =
+            {
+                VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,            // sType
+                nullptr,                                                // pNext
+                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |           // flags
+                    VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+                &vkCmdBufInheritanceInfo                                // pInheritanceInfo
+            };
+
+            if (vkBeginCommandBuffer(cmdList.handle(),
+                &vkCmdBufBeginInfo) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Could not begin recording Vulkan secondary command buffer");
+            }
+
+            // Set dynamic state, since secondary command buffers don't inherit it.
+            in_vulkan_set_dynamic_state(device, pass, cmdList.handle());
+
+            // Execute subpass.
+            graph.subpasses[subpassIndex].subpassData->execute(cmdList);
+
+            // Finish recording Vulkan secondary command buffer.
+            if (vkEndCommandBuffer(cmdList.handle()) != VK_SUCCESS)
+            {
+                throw std::runtime_error("Could not finish recording Vulkan secondary command buffer");
+            }
+
+            vkSecondaryCmdBufs[subpassIndex] = cmdList.handle();
+        });
+}
+
 static void in_vulkan_tmp_render_test(render_device& device,
-    internal::in_render_graph& graph, unsigned int threadIndex)
+    internal::in_render_graph& graph, job_system* jobs,
+    unsigned int threadIndex)
 {
     using namespace internal;
 
@@ -17,10 +140,26 @@ static void in_vulkan_tmp_render_test(render_device& device,
     auto& curFrameData = device.per_frame_data(curFrameIndex);
     auto& curFrameThreadData = device.per_frame_thread_data(curFrameIndex, threadIndex);
 
-    if (vkResetCommandPool(device.handle(),
-        curFrameThreadData.vkGraphicsCmdPool, 0) != VK_SUCCESS)
+    curFrameThreadData.reset_graphics_cmd_lists(device);
+
+    const uint32_t curImageIndex = device.swap_chain().curImageIndex;
+    const VkFramebuffer* curVkFramebuffer =
+        (graph.vkFramebuffersPerImagePass.data() +
+        (graph.passes.size() * curImageIndex));
+
+    // Record subpasses in parallel if we were given a job system with multiple threads.
+    const bool useSecondaryCmdBufs = (jobs && jobs->thread_count() > 1);
+    const VkSubpassContents vkSubpassContents = (useSecondaryCmdBufs) ?
+        VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS :
+        VK_SUBPASS_CONTENTS_INLINE;
+
+    hl::stack_or_heap_memory<VkCommandBuffer, 32> vkSecondaryCmdBufs(
+        hl::no_value_init, (useSecondaryCmdBufs) ? graph.subpasses.size() : 0);
+
+    if (useSecondaryCmdBufs)
     {
-        throw std::runtime_error("Could not reset Vulkan graphics command pool");
+        in_vulkan_record_subpasses(device, graph, *jobs,
+            curVkFramebuffer, vkSecondaryCmdBufs.data());
     }
 
     // Begin recording Vulkan command buffer.
@@ -38,11 +177,6 @@ static void in_vulkan_tmp_render_test(render_device& device,
         throw std::runtime_error("Could not begin recording Vulkan command buffer");
     }
 
-    const uint32_t curImageIndex = device.swap_chain().curImageIndex;
-    const VkFramebuffer* curVkFramebuffer =
-        (graph.vkFramebuffersPerImagePass.data() +
-        (graph.passes.size() * curImageIndex));
-
     for (auto& pass : graph.passes)
     {
         // Run before_pass function.
@@ -73,41 +207,14 @@ static void in_vulkan_tmp_render_test(render_device& device,
         };
 
         vkCmdBeginRenderPass(curFrameThreadData.graphicsCmdList.handle(),
-            &vkPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            &vkPassBeginInfo, vkSubpassContents);
 
-        // Set Vulkan dynamic viewport state if requested.
-        auto& vkSurfaceExtent = device.swap_chain().vkSurfaceExtent;
-        if (pass.doUpdateViewport)
+        // Set Vulkan dynamic state if requested.
+        // NOTE: Secondary command buffers set this themselves.
+        if (!useSecondaryCmdBufs)
         {
-            const VkViewport vkViewports[] =
-            {
-                0.0f,                                                   // x
-                0.0f,                                                   // y
-                static_cast<float>(vkSurfaceExtent.width),              // width
-                static_cast<float>(vkSurfaceExtent.height),             // height
-                0.0f,                                                   // minDepth
-                1.0f                                                    // maxDepth
-            };
-
-            vkCmdSetViewport(curFrameThreadData.graphicsCmdList.handle(), 0, 1, vkViewports);
-        }
-        
-        // Set Vulkan dynamic scissor state if requested.
-        if (pass.doUpdateScissor)
-        {
-            const VkRect2D vkScissors[] =
-            {
-                {
-                    {                                                   // offset
-                        0,                                              //  x
-                        0                                               //  y
-                    },
-
-                    vkSurfaceExtent                                     // extent
-                }
-            };
-
-            vkCmdSetScissor(curFrameThreadData.graphicsCmdList.handle(), 0, 1, vkScissors);
+            in_vulkan_set_dynamic_state(device, pass,
+                curFrameThreadData.graphicsCmdList.handle());
         }
 
         // TODO: Handle 0 subpasses, or prevent that from even being possible in the render graph building?
@@ -117,9 +224,17 @@ static void in_vulkan_tmp_render_test(render_device& device,
         std::size_t subpassIndex = 0;
         while (true)
         {
-            // Execute subpass.
-            auto& subpass = subpasses[subpassIndex];
-            subpass.subpassData->execute(curFrameThreadData.graphicsCmdList);
+            // Execute subpass, or the secondary command buffer it was recorded into.
+            if (useSecondaryCmdBufs)
+            {
+                vkCmdExecuteCommands(curFrameThreadData.graphicsCmdList.handle(), 1,
+                    &vkSecondaryCmdBufs[pass.firstSubpassIndex + subpassIndex]);
+            }
+            else
+            {
+                auto& subpass = subpasses[subpassIndex];
+                subpass.subpassData->execute(curFrameThreadData.graphicsCmdList);
+            }
 
             // Go to next subpass, if necessary.
             if (++subpassIndex >= pass.subpassCount)
@@ -128,7 +243,7 @@ static void in_vulkan_tmp_render_test(render_device& device,
             }
 
             vkCmdNextSubpass(curFrameThreadData.graphicsCmdList.handle(),
-                VK_SUBPASS_CONTENTS_INLINE);
+                vkSubpassContents);
         }
 
         // Finish Vulkan render pass.
@@ -208,7 +323,7 @@ void default_renderer::render(render_graph& graph)
     }
 
     // Render everything.
-    in_vulkan_tmp_render_test(*m_device, *graph.handle(), 0);
+    in_vulkan_tmp_render_test(*m_device, *graph.handle(), m_jobs, 0);
 
     // Schedule present of current frame and move to next frame.
     m_device->end_frame();
@@ -217,9 +332,16 @@ void default_renderer::render(render_graph& graph)
     m_device->begin_frame();
 }
 
-default_renderer::default_renderer(render_device& device) :
-    m_device(&device)
+default_renderer::default_renderer(render_device& device, job_system* jobs) :
+    m_device(&device),
+    m_jobs(jobs)
 {
+    // Ensure the given job system's thread indices are valid for the given device.
+    if (jobs && jobs->thread_count() > device.thread_count())
+    {
+        throw std::runtime_error("The given job system uses more threads than the given render device supports");
+    }
+
     // Prepare first frame.
     device.begin_frame();
 }
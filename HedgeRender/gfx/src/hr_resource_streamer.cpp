@@ -0,0 +1,327 @@
+#include "hedgerender/gfx/hr_resource_streamer.h"
+#include "hedgerender/gfx/hr_render_device.h"
+#include <hedgelib/archives/hl_hh_archive.h>
+#include <hedgelib/archives/hl_pacx.h>
+#include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_trace.h>
+
+namespace hr
+{
+namespace gfx
+{
+const stream_load_func* resource_streamer::in_get_loader(
+    const hl::nchar* fileName) const noexcept
+{
+    const hl::nchar* ext = hl::path::get_ext(fileName);
+    for (auto& loader : m_loaders)
+    {
+        if (hl::text::iequal(loader.first.c_str(), ext))
+        {
+            return &loader.second;
+        }
+    }
+
+    return nullptr;
+}
+
+void resource_streamer::in_set_status(stream_request_id id,
+    stream_state state, std::uint64_t lastBatchID)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& status = m_statuses[static_cast<std::size_t>(id - 1)];
+        status.state = state;
+        status.lastBatchID = lastBatchID;
+    }
+
+    m_doneCondition.notify_all();
+}
+
+void resource_streamer::in_stream_entries(hl::archive_entry* entries,
+    std::size_t entryCount, unsigned int threadIndex, upload_batch& batch,
+    std::size_t& batchSize, stream_request_id id)
+{
+    for (std::size_t i = 0; i < entryCount; ++i)
+    {
+        auto& entry = entries[i];
+
+        // Recurse through directories.
+        if (entry.is_dir())
+        {
+            auto& dirEntries = entry.dir_entries();
+            in_stream_entries(dirEntries.data(), dirEntries.size(),
+                threadIndex, batch, batchSize, id);
+
+            continue;
+        }
+
+        // Skip entries which we don't have a loader for.
+        const auto loader = in_get_loader(entry.name());
+        if (!loader || !entry.file_data()) continue;
+
+        // Load entry.
+        (*loader)(entry, batch);
+        batchSize += entry.size();
+
+        // Submit the current upload batch and start a new one if it's gotten too big.
+        if (batchSize >= m_maxBatchSize)
+        {
+            batch.submit();
+
+            in_set_status(id, stream_state::loading, batch.id());
+            batch = m_device->start_upload_batch(threadIndex);
+            batchSize = 0;
+        }
+    }
+}
+
+void resource_streamer::in_stream(const in_request& request, unsigned int threadIndex)
+{
+    HL_TRACE_ZONE("resource_streamer::stream");
+
+    // Load archive.
+    in_set_status(request.id, stream_state::loading);
+
+    hl::archive arc;
+    const hl::nchar* exts = hl::path::get_exts(request.filePath.c_str());
+
+    if (hl::text::iequal(exts, hl::pacx::ext, hl::text::len(hl::pacx::ext)))
+    {
+        hl::pacx::load(request.filePath, &arc);
+    }
+    else
+    {
+        hl::hh::ar::load(request.filePath, &arc);
+    }
+
+    // Load all entries which we have loaders for.
+    auto batch = m_device->start_upload_batch(threadIndex);
+    std::size_t batchSize = 0;
+
+    try
+    {
+        in_stream_entries(arc.data(), arc.size(),
+            threadIndex, batch, batchSize, request.id);
+    }
+    catch (...)
+    {
+        // Submit whatever was already recorded, since upload
+        // batches must be submitted exactly once.
+        if (!batch.is_submitted()) batch.submit();
+        throw;
+    }
+
+    // Submit final upload batch.
+    batch.submit();
+
+    in_set_status(request.id, stream_state::uploading, batch.id());
+}
+
+static void in_log_stream_error(const hl::nstring& filePath, const char* what) noexcept
+{
+    // NOTE: We build the message ourselves rather than passing these as format
+    // arguments, since file paths are native strings and what() is UTF-8, and
+    // there's no single portable format specifier for native strings.
+    try
+    {
+        hl::nstring msg = HL_NTEXT("Could not stream archive \"");
+        msg += filePath;
+        msg += HL_NTEXT("\": ");
+        msg += hl::text::conv<hl::text::utf8_to_native>(what);
+
+        // Escape any percent signs, since log messages are format strings.
+        for (std::size_t i = 0; i < msg.size(); ++i)
+        {
+            if (msg[i] == HL_NTEXT('%'))
+            {
+                msg.insert(i++, 1, HL_NTEXT('%'));
+            }
+        }
+
+        HR_NLOG_ERROR(msg.c_str());
+    }
+    catch (...) {}
+}
+
+void resource_streamer::in_worker_main(unsigned int threadIndex) noexcept
+{
+    while (true)
+    {
+        // Wait for a request (or for the streamer to be stopped).
+        in_request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workCondition.wait(lock, [&]()
+            {
+                return (m_isStopping || !m_queue.empty());
+            });
+
+            if (m_isStopping) return;
+
+            request = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        // Stream the requested archive.
+        try
+        {
+            in_stream(request, threadIndex);
+        }
+        catch (const std::exception& ex)
+        {
+            in_log_stream_error(request.filePath, ex.what());
+            in_set_status(request.id, stream_state::failed);
+        }
+        catch (...)
+        {
+            in_log_stream_error(request.filePath, "Unknown error");
+            in_set_status(request.id, stream_state::failed);
+        }
+    }
+}
+
+void resource_streamer::in_stop() noexcept
+{
+    // Stop streaming threads, and wait for them to finish their current requests.
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+
+    m_workCondition.notify_all();
+    m_doneCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+
+    m_workers.clear();
+}
+
+void resource_streamer::set_loader(const hl::nchar* ext, stream_load_func func)
+{
+    // Replace the existing loader for this extension, if any.
+    for (auto& loader : m_loaders)
+    {
+        if (hl::text::iequal(loader.first.c_str(), ext))
+        {
+            loader.second = std::move(func);
+            return;
+        }
+    }
+
+    // Otherwise, add a new loader.
+    m_loaders.emplace_back(ext, std::move(func));
+}
+
+stream_request_id resource_streamer::stream(const hl::nchar* filePath)
+{
+    stream_request_id id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_statuses.emplace_back();
+        id = static_cast<stream_request_id>(m_statuses.size());
+
+        m_queue.push_back({ filePath, id });
+    }
+
+    m_workCondition.notify_one();
+    return id;
+}
+
+stream_state resource_streamer::state(stream_request_id id) const
+{
+    // Get the request's status.
+    in_request_status status;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (id == 0 || id > m_statuses.size())
+        {
+            return stream_state::failed;
+        }
+
+        status = m_statuses[static_cast<std::size_t>(id - 1)];
+    }
+
+    // Requests are ready once their last upload batch has finished.
+    if (status.state == stream_state::uploading &&
+        m_device->is_upload_batch_done(status.lastBatchID))
+    {
+        return stream_state::ready;
+    }
+
+    return status.state;
+}
+
+bool resource_streamer::wait(stream_request_id id) const
+{
+    // Wait for the request to finish loading.
+    std::uint64_t lastBatchID;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (id == 0 || id > m_statuses.size())
+        {
+            return false;
+        }
+
+        // NOTE: We index into m_statuses every time since it
+        // can be reallocated by stream() while we're waiting.
+        const auto index = static_cast<std::size_t>(id - 1);
+        m_doneCondition.wait(lock, [&]()
+        {
+            const auto state = m_statuses[index].state;
+            return (state == stream_state::uploading ||
+                state == stream_state::failed || m_isStopping);
+        });
+
+        if (m_statuses[index].state != stream_state::uploading)
+        {
+            return false;
+        }
+
+        lastBatchID = m_statuses[index].lastBatchID;
+    }
+
+    // Wait for the request to finish uploading.
+    m_device->wait_for_upload_batch(lastBatchID);
+    return true;
+}
+
+resource_streamer::resource_streamer(render_device& device,
+    unsigned int firstThreadIndex, unsigned int threadCount,
+    std::size_t maxBatchSize) :
+    m_device(&device),
+    m_maxBatchSize(maxBatchSize)
+{
+    // Ensure the given thread indices are valid for the given device.
+    if (threadCount == 0 || firstThreadIndex >= device.thread_count() ||
+        threadCount > (device.thread_count() - firstThreadIndex))
+    {
+        throw std::runtime_error("The given streaming thread indices are not valid for the given render device");
+    }
+
+    // Start streaming threads.
+    m_workers.reserve(threadCount);
+
+    try
+    {
+        for (unsigned int i = 0; i < threadCount; ++i)
+        {
+            m_workers.emplace_back(&resource_streamer::in_worker_main,
+                this, firstThreadIndex + i);
+        }
+    }
+    catch (...)
+    {
+        in_stop();
+        throw;
+    }
+}
+
+resource_streamer::~resource_streamer()
+{
+    in_stop();
+}
+} // gfx
+} // hr
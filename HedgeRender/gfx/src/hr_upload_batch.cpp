@@ -1,85 +1,280 @@
 #include "hedgerender/gfx/hr_render_device.h"
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace hr
 {
 namespace gfx
 {
 upload_batch::upload_batch(render_device& device,
+    internal::in_per_thread_data& threadData,
     internal::in_per_upload_batch_data& batchData,
     VkCommandBuffer vkCmdBuf) noexcept :
     m_device(&device),
+    m_threadData(&threadData),
     m_batchData(&batchData),
     m_cmdList(vkCmdBuf),
-    m_batchID(batchData.curBatchID) {}
+    m_needsSubmit(true) {}
 
 void upload_batch::in_ensure_batch_was_submitted() const
 {
-    assert(m_batchID == 0 &&
+    assert(!m_needsSubmit &&
         "upload_batch::submit() must be called exactly once "
         "for every upload_batch object!");
 }
 
-void upload_batch::add(const void* src, buffer& dst)
+static std::size_t in_align_staging_offset(std::size_t offset) noexcept
 {
-    assert(m_batchID != 0 &&
-        "upload_batch::add() cannot be called on an "
-        "upload batch that has already been submitted!");
+    return ((offset + (internal::in_staging_alignment - 1)) &
+        ~(internal::in_staging_alignment - 1));
+}
+
+const buffer& upload_batch::in_copy_to_staging(const void* src,
+    std::size_t size, std::size_t& stagingOffset)
+{
+    using namespace internal;
+
+    in_staging_page* page;
+    if (size > in_staging_page_size)
+    {
+        // Create a dedicated staging page for uploads too large to fit within a recyclable one.
+        std::unique_ptr<in_staging_page> dedicatedPage(
+            new in_staging_page(*m_device, size));
+
+        m_batchData->dedicatedStagingPages.push_back(std::move(dedicatedPage));
+        page = m_batchData->dedicatedStagingPages.back().get();
+        stagingOffset = 0;
+    }
+    else
+    {
+        // Get the next free spot within the current staging page.
+        stagingOffset = in_align_staging_offset(m_batchData->curStagingPageOffset);
+
+        // Get a new staging page if the current one doesn't have enough room.
+        if (stagingOffset > in_staging_page_size ||
+            size > (in_staging_page_size - stagingOffset))
+        {
+            // Recycle a free staging page whose last upload batch has finished, if any.
+            auto& freePages = m_threadData->freeStagingPages;
+            std::unique_ptr<in_staging_page> newPage;
 
-    // Create upload buffer.
-    void* uploadBufMappedData;
-    m_batchData->uploadBuffers.emplace_back(*m_device,
-        memory_type::upload, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        dst.size(), &uploadBufMappedData);
+            if (!freePages.empty())
+            {
+                const auto completedBatchID = m_device->completed_upload_batch_id();
+                for (auto& freePage : freePages)
+                {
+                    if (freePage->lastBatchID > completedBatchID) continue;
 
-    auto& uploadBuf = m_batchData->uploadBuffers.back();
+                    std::swap(freePage, freePages.back());
+                    newPage = std::move(freePages.back());
+                    freePages.pop_back();
+                    break;
+                }
+            }
 
-    // Copy data into upload buffer.
-    std::memcpy(uploadBufMappedData, src, dst.size());
+            // Otherwise, create a new staging page.
+            if (!newPage)
+            {
+                newPage.reset(new in_staging_page(*m_device, in_staging_page_size));
+            }
 
-    // TODO: Unmap data?
+            m_batchData->stagingPages.push_back(std::move(newPage));
+            stagingOffset = 0;
+        }
+
+        page = m_batchData->stagingPages.back().get();
+        m_batchData->curStagingPageOffset = (stagingOffset + size);
+    }
 
-    // Copy upload buffer data into buffer.
-    m_cmdList.copy_buffer(uploadBuf, dst);
+    // Copy data into staging page.
+    std::memcpy(page->data + stagingOffset, src, size);
+    return page->buf;
 }
 
-void upload_batch::add(const void* src, image& dst)
+static void in_vulkan_record_transfer_write_barrier(VkCommandBuffer vkCmdBuf) noexcept
 {
-    assert(m_batchID != 0 &&
-        "upload_batch::add() cannot be called on an "
-        "upload batch that has already been submitted!");
+    const VkMemoryBarrier vkMemBarrier =
+    {
+        VK_STRUCTURE_TYPE_MEMORY_BARRIER,                               // sType
+        nullptr,                                                        // pNext
+        VK_ACCESS_TRANSFER_WRITE_BIT,                                   // srcAccessMask
+        VK_ACCESS_TRANSFER_WRITE_BIT                                    // dstAccessMask
+    };
+
+    vkCmdPipelineBarrier(vkCmdBuf, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &vkMemBarrier,
+        0, nullptr, 0, nullptr);
+}
+
+static bool in_ranges_overlap(const VkBufferCopy& a, const VkBufferCopy& b) noexcept
+{
+    return (a.dstOffset < (b.dstOffset + b.size) &&
+        b.dstOffset < (a.dstOffset + a.size));
+}
+
+void upload_batch::in_record_copies()
+{
+    using namespace internal;
+
+    // Record buffer copies in the order they were added, merging adjacent copies
+    // between the same buffers into a single copy command where possible.
+    const auto& bufferCopies = m_batchData->bufferCopies;
+    std::vector<VkBufferCopy> vkRegions;
+    std::unordered_map<const buffer*, std::vector<VkBufferCopy>> writtenRegions;
+    const in_staging_buffer_copy* curCopy = nullptr;
 
-    // Create upload buffer.
-    void* uploadBufMappedData;
-    m_batchData->uploadBuffers.emplace_back(*m_device,
-        memory_type::upload, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        dst.size(), &uploadBufMappedData);
+    const auto flushRegions = [&]()
+    {
+        if (vkRegions.empty()) return;
+
+        m_cmdList.copy_buffer(*curCopy->src, *curCopy->dst,
+            static_cast<unsigned int>(vkRegions.size()), vkRegions.data());
+
+        vkRegions.clear();
+    };
+
+    for (const auto& copy : bufferCopies)
+    {
+        // If this copy writes to part of a buffer already written to by an earlier
+        // copy, wait for that copy to finish first, so that the last copy added wins.
+        // NOTE: This also keeps us from ever giving a single copy command overlapping
+        // destination regions, which Vulkan doesn't allow.
+        auto& dstWrittenRegions = writtenRegions[copy.dst];
+        for (const auto& vkWrittenRegion : dstWrittenRegions)
+        {
+            if (in_ranges_overlap(copy.vkRegion, vkWrittenRegion))
+            {
+                flushRegions();
+                in_vulkan_record_transfer_write_barrier(m_cmdList.handle());
+
+                for (auto& it : writtenRegions)
+                {
+                    it.second.clear();
+                }
+
+                break;
+            }
+        }
 
-    auto& uploadBuf = m_batchData->uploadBuffers.back();
+        // Record the current copy command if this copy is between different buffers.
+        if (curCopy && (copy.src != curCopy->src || copy.dst != curCopy->dst))
+        {
+            flushRegions();
+        }
+
+        curCopy = &copy;
+        vkRegions.push_back(copy.vkRegion);
+        dstWrittenRegions.push_back(copy.vkRegion);
+    }
 
-    // Copy data into upload buffer.
-    std::memcpy(uploadBufMappedData, src, dst.size());
+    flushRegions();
 
-    // TODO: Unmap data?
+    // Return early if there are no image copies to record.
+    const auto& imageCopies = m_batchData->imageCopies;
+    if (imageCopies.empty()) return;
 
-    // Transition image into TRANSFER_DST image layout.
-    m_cmdList.transition_image_layout(dst,
+    // Get every unique image we're copying into.
+    hl::stack_or_heap_memory<image*, 16> images(
+        hl::no_value_init, imageCopies.size());
+
+    for (std::size_t i = 0; i < imageCopies.size(); ++i)
+    {
+        images[i] = imageCopies[i].dst;
+    }
+
+    image** const imagesEnd = (images.data() + imageCopies.size());
+    std::sort(images.data(), imagesEnd, std::less<image*>());
+
+    const auto uniqueImageCount = static_cast<unsigned int>(
+        std::unique(images.data(), imagesEnd) - images.data());
+
+    // Transition all images into TRANSFER_DST image layout with a single barrier.
+    m_cmdList.transition_image_layouts(uniqueImageCount, images.data(),
         VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
         0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
         VK_PIPELINE_STAGE_TRANSFER_BIT);
 
-    // Copy upload buffer data into image.
-    m_cmdList.copy_buffer_to_image(uploadBuf, dst,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    // Copy staging data into images.
+    std::unordered_set<const image*> writtenImages;
+    for (const auto& copy : imageCopies)
+    {
+        // Wait for earlier copies into the same image to finish first.
+        if (!writtenImages.insert(copy.dst).second)
+        {
+            in_vulkan_record_transfer_write_barrier(m_cmdList.handle());
+            writtenImages.clear();
+            writtenImages.insert(copy.dst);
+        }
+
+        m_cmdList.copy_buffer_to_image(*copy.src, copy.srcOffset,
+            *copy.dst, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    }
+}
+
+void upload_batch::add(const void* src, buffer& dst)
+{
+    add(src, dst.size(), dst, 0);
+}
+
+void upload_batch::add(const void* src, std::size_t size,
+    buffer& dst, std::size_t dstOffset)
+{
+    assert(m_needsSubmit &&
+        "upload_batch::add() cannot be called on an "
+        "upload batch that has already been submitted!");
+
+    assert(dstOffset <= dst.size() && size <= (dst.size() - dstOffset) &&
+        "Destination buffer is too small to hold the given data!");
+
+    // Copy data into staging memory.
+    std::size_t stagingOffset;
+    const auto& stagingBuf = in_copy_to_staging(src, size, stagingOffset);
+
+    // Queue a copy from staging memory into the buffer.
+    m_batchData->bufferCopies.push_back(
+    {
+        &stagingBuf,                                                    // src
+        &dst,                                                           // dst
+        {                                                               // vkRegion
+            stagingOffset,                                              //  srcOffset
+            dstOffset,                                                  //  dstOffset
+            size                                                        //  size
+        }
+    });
+}
+
+void upload_batch::add(const void* src, image& dst)
+{
+    assert(m_needsSubmit &&
+        "upload_batch::add() cannot be called on an "
+        "upload batch that has already been submitted!");
+
+    // Copy data into staging memory.
+    std::size_t stagingOffset;
+    const auto& stagingBuf = in_copy_to_staging(src, dst.size(), stagingOffset);
+
+    // Queue a copy from staging memory into the image.
+    m_batchData->imageCopies.push_back(
+    {
+        &stagingBuf,                                                    // src
+        stagingOffset,                                                  // srcOffset
+        &dst                                                            // dst
+    });
 }
 
 void upload_batch::submit()
 {
     using namespace internal;
 
-    assert(m_batchID != 0 &&
+    assert(m_needsSubmit &&
         "upload_batch::submit() must be called exactly once "
         "for every upload_batch object!");
 
+    // Record all queued copies.
+    in_record_copies();
+
     // Finish recording Vulkan command buffer.
     const auto vkTransferCmdBuf = m_cmdList.handle();
     if (vkEndCommandBuffer(vkTransferCmdBuf) != VK_SUCCESS)
@@ -87,6 +282,15 @@ void upload_batch::submit()
         throw std::runtime_error("Could not finish recording Vulkan command buffer");
     }
 
+    // Lock transfer queue, since upload batches can be submitted from any thread.
+    std::lock_guard<std::mutex> transferQueueLock(m_device->m_transferQueueMutex);
+
+    // Get the ID for this batch.
+    // NOTE: We only assign IDs while the transfer queue is locked so that the
+    // timeline semaphore is always signaled with increasing values.
+    const std::uint64_t batchID = (m_device->m_curUploadBatchID.load(
+        std::memory_order_relaxed) + 1);
+
     // Generate Vulkan submit info.
     const VkTimelineSemaphoreSubmitInfo vkTimelineSemaphoreSubmitInfo =
     {
@@ -95,7 +299,7 @@ void upload_batch::submit()
         0,                                                              // waitSemaphoreValueCount
         nullptr,                                                        // pWaitSemaphoreValues
         1,                                                              // signalSemaphoreValueCount
-        &m_batchID                                                      // pSignalSemaphoreValues
+        &batchID                                                        // pSignalSemaphoreValues
     };
 
     const VkSubmitInfo vkSubmitInfo =
@@ -125,8 +329,24 @@ void upload_batch::submit()
         throw std::runtime_error("Could not submit command buffers to Vulkan transfer queue");
     }
 
-    // Set batch ID to 0 to mark this upload batch as having been submitted.
-    m_batchID = 0;
+    // Store batch ID.
+    m_device->m_curUploadBatchID.store(batchID, std::memory_order_relaxed);
+    m_batchData->curBatchID = batchID;
+    m_batchID = batchID;
+
+    // Return this batch's staging pages to the free list, so
+    // they can be recycled once this batch has finished uploading.
+    for (auto& page : m_batchData->stagingPages)
+    {
+        page->lastBatchID = m_batchID;
+        m_threadData->freeStagingPages.push_back(std::move(page));
+    }
+
+    m_batchData->stagingPages.clear();
+    m_batchData->curStagingPageOffset = in_staging_page_size;
+
+    // Mark this upload batch as having been submitted.
+    m_needsSubmit = false;
 }
 
 upload_batch& upload_batch::operator=(upload_batch&& other) noexcept
@@ -136,11 +356,13 @@ upload_batch& upload_batch::operator=(upload_batch&& other) noexcept
         in_ensure_batch_was_submitted();
 
         m_device = other.m_device;
+        m_threadData = other.m_threadData;
         m_batchData = other.m_batchData;
         m_cmdList = std::move(other.m_cmdList);
         m_batchID = other.m_batchID;
+        m_needsSubmit = other.m_needsSubmit;
         
-        other.m_batchID = 0;
+        other.m_needsSubmit = false;
     }
 
     return *this;
@@ -148,11 +370,13 @@ upload_batch& upload_batch::operator=(upload_batch&& other) noexcept
 
 upload_batch::upload_batch(upload_batch&& other) noexcept :
     m_device(other.m_device),
+    m_threadData(other.m_threadData),
     m_batchData(other.m_batchData),
     m_cmdList(std::move(other.m_cmdList)),
-    m_batchID(other.m_batchID)
+    m_batchID(other.m_batchID),
+    m_needsSubmit(other.m_needsSubmit)
 {
-    other.m_batchID = 0;
+    other.m_needsSubmit = false;
 }
 } // gfx
 } // hr
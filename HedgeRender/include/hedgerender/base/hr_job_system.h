@@ -0,0 +1,89 @@
+#ifndef HR_JOB_SYSTEM_H_INCLUDED
+#define HR_JOB_SYSTEM_H_INCLUDED
+#include "hr_base_internal.h"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hr
+{
+/**
+    @brief A job function; called with the index of the job being run, and the
+    index of the thread it's being run on (which is always less than the job
+    system's thread_count, and is never used by two jobs at the same time).
+*/
+using job_func = std::function<void(unsigned int jobIndex, unsigned int threadIndex)>;
+
+/**
+    @brief An interface used to run independent jobs (such as recording
+    render passes) across several threads. Implement this to have
+    HedgeRender run its jobs on your engine's own job system.
+*/
+class job_system
+{
+public:
+    /**
+        @brief Returns how many threads jobs can be run on,
+        including the thread which calls run().
+    */
+    virtual unsigned int thread_count() const noexcept = 0;
+
+    /**
+        @brief Calls func(jobIndex, threadIndex) for every jobIndex within
+        [0, jobCount), and returns once all of them have finished.
+
+        If any job throws an exception, jobs which haven't started yet are
+        skipped, and the exception is re-thrown once every job has finished.
+    */
+    virtual void run(unsigned int jobCount, const job_func& func) = 0;
+
+    virtual ~job_system() = default;
+};
+
+/**
+    @brief A job_system which runs jobs on a persistent pool of worker
+    threads, as well as on the thread which calls run().
+*/
+class thread_pool : public job_system
+{
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_workCondition;
+    std::condition_variable m_doneCondition;
+    const job_func* m_func = nullptr;
+    unsigned int m_jobCount = 0;
+    std::atomic_uint m_nextJobIndex = { 0 };
+    unsigned int m_busyWorkerCount = 0;
+    std::uint64_t m_generation = 0;
+    std::exception_ptr m_exception;
+    bool m_isStopping = false;
+
+    HR_BASE_API void in_run_jobs(unsigned int threadIndex) noexcept;
+
+    HR_BASE_API void in_worker_main(unsigned int threadIndex) noexcept;
+
+public:
+    inline unsigned int thread_count() const noexcept override
+    {
+        return static_cast<unsigned int>(m_workers.size() + 1);
+    }
+
+    HR_BASE_API void run(unsigned int jobCount, const job_func& func) override;
+
+    thread_pool(const thread_pool& other) = delete;
+    thread_pool& operator=(const thread_pool& other) = delete;
+
+    /**
+        @param threadCount How many threads to run jobs on, including
+        the thread which calls run(). Pass 0 to use one thread per core.
+    */
+    HR_BASE_API explicit thread_pool(unsigned int threadCount = 0);
+
+    HR_BASE_API ~thread_pool() override;
+};
+} // hr
+#endif
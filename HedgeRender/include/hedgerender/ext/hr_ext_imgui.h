@@ -434,11 +434,11 @@ void imgui_create_resources()
 
     // Create upload batch for fonts image data.
     auto uploadBatch = backData.device->start_upload_batch(0);
-    backData.fontsImageUploadBatchID = uploadBatch.id();
     uploadBatch.add(pixels, backData.fontsImage);
 
     // Start uploading fonts image data to GPU.
     uploadBatch.submit();
+    backData.fontsImageUploadBatchID = uploadBatch.id();
 
     // Create fonts image view.
     backData.fontsImageView = gfx::image_view(*backData.device, backData.fontsImage);
@@ -23,14 +23,28 @@ public:
 
     HR_GFX_API void copy_buffer(const buffer& src, buffer& dst);
 
+    HR_GFX_API void copy_buffer(const buffer& src, buffer& dst,
+        unsigned int regionCount, const VkBufferCopy* regions);
+
     HR_GFX_API void copy_buffer_to_image(const buffer& src,
         image& dst, VkImageLayout layout);
 
+    HR_GFX_API void copy_buffer_to_image(const buffer& src,
+        VkDeviceSize srcOffset, image& dst, VkImageLayout layout);
+
     HR_GFX_API void transition_image_layout(image& img,
         VkImageLayout oldLayout, VkImageLayout newLayout,
         VkAccessFlags oldAccess, VkAccessFlags newAccess,
         VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages);
 
+    /**
+        @brief Transitions all of the given images with a single pipeline barrier.
+    */
+    HR_GFX_API void transition_image_layouts(unsigned int imageCount,
+        image* const* images, VkImageLayout oldLayout, VkImageLayout newLayout,
+        VkAccessFlags oldAccess, VkAccessFlags newAccess,
+        VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages);
+
     HR_GFX_API void push_constants(const pipeline_layout& layout,
         VkShaderStageFlags vkShaderStages, unsigned int offset,
         unsigned int count, const void* values);
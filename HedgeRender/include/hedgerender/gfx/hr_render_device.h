@@ -3,10 +3,13 @@
 #include "hr_adapter.h"
 #include "hr_resource.h"
 #include "hr_upload_batch.h"
+#include <hedgelib/hl_text.h>
 #include <vector>
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <string>
+#include <unordered_map>
 
 struct VmaAllocator_T;
 
@@ -83,6 +86,57 @@ struct in_desc_pools
     HR_GFX_API void destroy(render_device& device) noexcept;
 };
 
+/**
+    @brief Vulkan render passes, keyed by the full contents of the create info
+    used to create them, so render graphs built from identical descriptions
+    (e.g. when a graph is rebuilt) reuse the same render pass objects.
+*/
+struct in_render_pass_cache
+{
+    std::unordered_map<std::string, VkRenderPass> vkRenderPasses;
+    std::mutex mutex;
+
+    /**
+        @brief Returns the cached Vulkan render pass matching the given
+        create info, creating and caching a new one if there isn't one yet.
+        The returned render pass is owned by this cache; do not destroy it.
+    */
+    HR_GFX_API VkRenderPass get(VkDevice vkDevice,
+        const VkRenderPassCreateInfo& vkRenderPassCreateInfo);
+
+    HR_GFX_API void destroy(VkDevice vkDevice) noexcept;
+};
+
+struct in_desc_set_cache_entry
+{
+    VkDescriptorSet vkDescSet;
+    VkDescriptorPool vkDescPool;
+    std::uint64_t lastUsedFrameIndex;
+};
+
+/**
+    @brief Vulkan descriptor sets, keyed by their layout and the full contents
+    of the writes made to them, so identical shader data can be reused across
+    frames rather than being re-allocated and re-written every frame.
+*/
+struct in_desc_set_cache
+{
+    std::unordered_map<std::string, in_desc_set_cache_entry> entries;
+    /** @brief Created with VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT. */
+    std::vector<VkDescriptorPool> vkDescPools;
+    std::mutex mutex;
+
+    /**
+        @brief Frees every cached Vulkan descriptor set which hasn't been
+        used since before the given frame index.
+    */
+    HR_GFX_API void evict(VkDevice vkDevice, std::uint64_t minFrameIndex) noexcept;
+
+    HR_GFX_API void clear(VkDevice vkDevice) noexcept;
+
+    HR_GFX_API void destroy(VkDevice vkDevice) noexcept;
+};
+
 struct in_swap_chain
 {
     VkSwapchainKHR vkSwapChain = VK_NULL_HANDLE;
@@ -124,10 +178,59 @@ struct in_per_frame_data
     HR_GFX_API in_per_frame_data(render_device& device);
 };
 
+/**
+    @brief A large, persistently-mapped upload buffer which
+    upload batches suballocate their staging memory from.
+*/
+struct in_staging_page
+{
+    buffer buf;
+    std::uint8_t* data = nullptr;
+    /** @brief The ID of the last upload batch which used this page. */
+    std::uint64_t lastBatchID = 0;
+
+    HR_GFX_API in_staging_page(render_device& device, std::size_t size);
+};
+
+/** @brief The size of every recyclable staging page, in bytes. */
+constexpr std::size_t in_staging_page_size = (16 * 1024 * 1024);
+
+/** @brief The alignment of every staging allocation, in bytes. */
+constexpr std::size_t in_staging_alignment = 16;
+
+struct in_staging_buffer_copy
+{
+    const buffer* src;
+    buffer* dst;
+    VkBufferCopy vkRegion;
+};
+
+struct in_staging_image_copy
+{
+    const buffer* src;
+    VkDeviceSize srcOffset;
+    image* dst;
+};
+
 struct in_per_upload_batch_data
 {
+    /** @brief The ID of the last upload batch submitted using this data. */
     std::uint64_t curBatchID = 0;
-    std::vector<buffer> uploadBuffers;
+    /**
+        @brief The staging pages this upload batch is using.
+        The last page is the one currently being filled.
+    */
+    std::vector<std::unique_ptr<in_staging_page>> stagingPages;
+    /** @brief How much of the current staging page has been used, in bytes. */
+    std::size_t curStagingPageOffset = in_staging_page_size;
+    /**
+        @brief Staging pages for uploads too large to fit within a recyclable
+        page; destroyed once this upload batch's data is reused.
+    */
+    std::vector<std::unique_ptr<in_staging_page>> dedicatedStagingPages;
+    /** @brief Copies which will be recorded when this upload batch is submitted. */
+    std::vector<in_staging_buffer_copy> bufferCopies;
+    std::vector<in_staging_image_copy> imageCopies;
 };
 
 constexpr unsigned int in_max_upload_batches_per_thread = 4;
@@ -140,6 +243,12 @@ struct in_per_thread_data
     /** @brief Data for every upload batch we might possibly use. */
     std::array<in_per_upload_batch_data, in_max_upload_batches_per_thread> batchData;
 
+    /**
+        @brief Staging pages which aren't being filled by any upload batch.
+        Each page can be reused once its lastBatchID has finished uploading.
+    */
+    std::vector<std::unique_ptr<in_staging_page>> freeStagingPages;
+
     inline std::size_t get_next_upload_batch_index() noexcept
     {
         return ((curTotalBatchIndex++) % in_max_upload_batches_per_thread);
@@ -154,8 +263,24 @@ struct in_per_frame_thread_data
 {
     VkCommandPool vkGraphicsCmdPool;
     VkCommandPool vkTransferCmdPool;
-    cmd_list graphicsCmdList; // TODO: Will we need several of these?
+    cmd_list graphicsCmdList;
     std::array<cmd_list, in_max_upload_batches_per_thread> transferCmdLists;
+    /**
+        @brief Secondary graphics command lists used to record subpasses on this
+        thread. Allocated as needed, and reused every time this frame comes around.
+    */
+    std::vector<cmd_list> secondaryCmdLists;
+    /** @brief How many secondary command lists have been used so far this frame. */
+    std::size_t usedSecondaryCmdListCount = 0;
+
+    /**
+        @brief Resets this thread's graphics command pool (and with it, all of
+        the graphics command lists allocated from it) for a new frame.
+    */
+    HR_GFX_API void reset_graphics_cmd_lists(render_device& device);
+
+    /** @brief Returns an unused secondary command list, allocating one if necessary. */
+    HR_GFX_API cmd_list& get_secondary_cmd_list(render_device& device);
 
     HR_GFX_API void destroy(render_device& device) noexcept;
 
@@ -164,6 +289,21 @@ struct in_per_frame_thread_data
 };
 } // internal
 
+struct pipeline_cache_stats
+{
+    /**
+        @brief Whether the pipeline cache was loaded from disk (a "warm" cache),
+        rather than being created empty (a "cold" cache).
+    */
+    bool isWarm;
+    /** @brief The size of the pipeline cache data loaded from disk, in bytes. */
+    std::size_t loadedSize;
+    /** @brief How many pipelines have been created using this device. */
+    std::uint64_t pipelineCount;
+    /** @brief The total time spent creating those pipelines, in nanoseconds. */
+    std::uint64_t totalCreateTime;
+};
+
 class res_allocator : public non_copyable
 {
     VmaAllocator_T* m_vmaAllocator;
@@ -205,9 +345,15 @@ class render_device : public non_copyable, public non_moveable
     vk::Device m_vkDevice;
     std::array<VkQueue, internal::in_queue_type::count> m_vkQueues;
     res_allocator m_allocator;
+    hl::nstring m_pipelineCachePath;
+    std::size_t m_pipelineCacheLoadedSize = 0;
     VkPipelineCache m_vkPipelineCache;
+    mutable std::atomic_uint64_t m_pipelineCount = { 0 };
+    mutable std::atomic_uint64_t m_pipelineCreateTime = { 0 };
     internal::in_desc_pool_allocator m_globalDescPoolAllocator;
     internal::in_desc_pools m_globalDescPools;
+    internal::in_render_pass_cache m_renderPassCache;
+    internal::in_desc_set_cache m_descSetCache;
     internal::in_swap_chain m_swapChain;
     internal::in_desc_pool_allocator m_perFrameDescPoolAllocator;
     internal::in_per_frame_data* m_frameData;
@@ -220,10 +366,15 @@ class render_device : public non_copyable, public non_moveable
         the latest upload batch that has finished uploading.
     */
     VkSemaphore m_vkUploadCompleteSemaphore;
-    /** @brief The value the current upload batch is going to signal when complete. */
+    /**
+        @brief The ID of the most recently submitted upload batch. Only
+        changed while m_transferQueueMutex is locked, so upload batch IDs
+        are always signaled in increasing order.
+    */
     std::atomic_uint64_t m_curUploadBatchID = { 0 };
     std::atomic_uint64_t m_curTotalFrameIndex = {0};
     std::mutex m_gfxQueueMutex;
+    std::mutex m_transferQueueMutex;
 
 public:
     inline const gfx::adapter& adapter() const noexcept
@@ -261,6 +412,22 @@ public:
         return m_vkPipelineCache;
     }
 
+    inline const hl::nstring& pipeline_cache_path() const noexcept
+    {
+        return m_pipelineCachePath;
+    }
+
+    HR_GFX_API gfx::pipeline_cache_stats pipeline_cache_stats() const noexcept;
+
+    /**
+        @brief Saves the pipeline cache to the path given when this device was
+        created (if any), so the next device created with that path starts with
+        a "warm" cache. This is done automatically by destroy().
+    */
+    HR_GFX_API void save_pipeline_cache() const;
+
+    HR_GFX_API void in_add_pipeline_create_time(std::uint64_t createTime) const noexcept;
+
     inline const internal::in_swap_chain& swap_chain() const noexcept
     {
         return m_swapChain;
@@ -366,6 +533,11 @@ public:
     HR_GFX_API void wait_for_frame_render(unsigned int frameIndex,
         std::uint64_t timeout = UINT64_MAX) const;
 
+    /**
+        @brief Returns the ID of the latest upload batch which has finished uploading.
+    */
+    HR_GFX_API std::uint64_t completed_upload_batch_id() const;
+
     HR_GFX_API bool is_upload_batch_done(std::uint64_t batchID) const;
     
     HR_GFX_API void wait_for_upload_batch(std::uint64_t batchID,
@@ -383,6 +555,40 @@ public:
     HR_GFX_API void update_shader_data(const shader_data_write_desc* shaderDataWrites,
         std::size_t shaderDataWriteCount);
 
+    /**
+        @brief Gets shader data with the given contents from this device's shader
+        data cache, only allocating and writing new shader data for descriptions
+        which don't match any cached shader data. All new shader data is written
+        at once with a single call to vkUpdateDescriptorSets.
+
+        Cached shader data is freed once it hasn't been requested for frame_count()
+        frames, so request it again every frame it's used in, rather than holding
+        onto it. If any resources it refers to are destroyed before then, call
+        clear_shader_data_cache(), as new resources could reuse the same handles.
+
+        @param descs The parameter groups and writes to get shader data for.
+        The shaderData member of each write is ignored.
+        @param descCount The number of descriptions in descs.
+        @param shaderDataHandles Where to write the resulting shader data handles.
+    */
+    HR_GFX_API void get_cached_shader_data(const cached_shader_data_desc* descs,
+        std::size_t descCount, shader_data* shaderDataHandles);
+
+    inline shader_data get_cached_shader_data(const shader_parameter_group& paramGroup,
+        const shader_data_write_desc* shaderDataWrites, std::size_t shaderDataWriteCount)
+    {
+        const cached_shader_data_desc desc =
+        {
+            &paramGroup, shaderDataWrites, shaderDataWriteCount
+        };
+
+        shader_data shaderDataHandle;
+        get_cached_shader_data(&desc, 1, &shaderDataHandle);
+        return shaderDataHandle;
+    }
+
+    HR_GFX_API void clear_shader_data_cache();
+
     HR_GFX_API void begin_frame();
     HR_GFX_API void end_frame();
 
@@ -397,17 +603,40 @@ public:
         set_debug_name(vkObjectType, vkObjectHandle, name.c_str());
     }
 
+    /**
+        @param threadCount How many threads will be recording commands or starting
+        upload batches with this device. Every thread index passed to this device
+        (e.g. via start_upload_batch, or by a job_system) must be less than this,
+        and each thread index must only be used by one thread at a time. Upload
+        batches started with different thread indices can be filled and submitted
+        from different threads at the same time.
+        @param pipelineCachePath The path to load the pipeline cache from (if it
+        exists and is compatible with the given adapter), and to save it back to
+        when this device is destroyed. Pass null to not load or save the cache.
+    */
     HR_GFX_API render_device(const gfx::adapter& adapter,
         surface& surface, unsigned int width, unsigned int height,
         unsigned int prefFrameBufCount = 3, bool vsync = true,
-        const char* debugName = nullptr);
+        unsigned int threadCount = 1, const char* debugName = nullptr,
+        const hl::nchar* pipelineCachePath = nullptr);
+
+    render_device(const gfx::adapter& adapter,
+        surface& surface, unsigned int width, unsigned int height,
+        unsigned int prefFrameBufCount, bool vsync, unsigned int threadCount,
+        const std::string& debugName,
+        const hl::nchar* pipelineCachePath = nullptr) :
+        render_device(adapter, surface, width, height,
+            prefFrameBufCount, vsync, threadCount, debugName.c_str(),
+            pipelineCachePath) {}
 
     render_device(const gfx::adapter& adapter,
         surface& surface, unsigned int width, unsigned int height,
-        unsigned int prefFrameBufCount, bool vsync,
-        const std::string& debugName) :
+        unsigned int prefFrameBufCount, bool vsync, unsigned int threadCount,
+        const std::string& debugName,
+        const hl::nstring& pipelineCachePath) :
         render_device(adapter, surface, width, height,
-            prefFrameBufCount, vsync, debugName.c_str()) {}
+            prefFrameBufCount, vsync, threadCount, debugName.c_str(),
+            pipelineCachePath.c_str()) {}
     
     inline ~render_device()
     {
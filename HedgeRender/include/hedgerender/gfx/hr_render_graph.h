@@ -89,6 +89,14 @@ class render_subpass
 {
 public:
     virtual ~render_subpass() {}
+
+    /**
+        @brief Records this subpass's commands into the given command list.
+
+        NOTE: If the renderer was given a job_system, this is recorded into a
+        secondary command list on one of the job system's threads, possibly at
+        the same time as other subpasses are being recorded on other threads.
+    */
     virtual void execute(cmd_list& cmdList) {}
 
     render_subpass& operator=(const render_subpass& other) = default;
@@ -103,7 +111,24 @@ class render_pass
 {
 public:
     virtual ~render_pass() {}
+
+    /**
+        @brief Records commands into the given (primary) command list
+        before this pass begins.
+
+        NOTE: If the renderer was given a job_system with more than one thread,
+        every subpass in the graph has already been recorded (i.e. every
+        render_subpass::execute call has returned) by the time this is called,
+        so this runs after the execute calls of this pass and all later passes,
+        rather than before them. Don't rely on this to set up CPU-side state
+        that those execute calls read.
+    */
     virtual void before_pass(cmd_list& cmdList) {}
+
+    /**
+        @brief Records commands into the given (primary) command list
+        after this pass ends. The same NOTE as before_pass applies.
+    */
     virtual void after_pass(cmd_list& cmdList) {}
 
     render_pass& operator=(const render_pass& other) = default;
@@ -156,6 +181,11 @@ public:
             this)->get_image_view(resID));
     }
 
+    /**
+        @brief Re-creates this graph's framebuffers for the device's current
+        swap chain, along with its render resources if the swap chain's size
+        has changed. Nothing else in the graph is rebuilt.
+    */
     HR_GFX_API void recreate_framebuffers(render_device& device);
 
     HR_GFX_API void destroy() noexcept;
@@ -358,6 +388,14 @@ public:
         return m_passes.back();
     }
 
+    /**
+        @brief Compiles the passes added to this builder into a render graph.
+
+        Only the resulting Vulkan render passes are cached (on the given device).
+        Pass ordering, attachment usage, and resource lifetime/aliasing analysis
+        all run in full on every call, so keep the returned graph around and call
+        render_graph::recreate_framebuffers on resize rather than rebuilding it.
+    */
     HR_GFX_API render_graph build(render_device& device);
 
     render_graph_builder(const color& screenClearColor = hr::gfx::colors::black) noexcept :
@@ -4,6 +4,8 @@
 
 namespace hr
 {
+class job_system;
+
 namespace gfx
 {
 class render_device;
@@ -12,11 +14,17 @@ class render_graph;
 class default_renderer
 {
     render_device* m_device;
+    job_system* m_jobs;
 
 public:
     HR_GFX_API void render(render_graph& graph);
 
-    HR_GFX_API default_renderer(render_device& device);
+    /**
+        @param jobs The job system to record subpasses in parallel with, or null
+        to record everything on the calling thread. Its thread count must not
+        exceed the given device's thread count.
+    */
+    HR_GFX_API default_renderer(render_device& device, job_system* jobs = nullptr);
 };
 } // gfx
 } // hr
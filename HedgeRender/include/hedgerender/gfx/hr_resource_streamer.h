@@ -0,0 +1,156 @@
+#ifndef HR_RESOURCE_STREAMER_H_INCLUDED
+#define HR_RESOURCE_STREAMER_H_INCLUDED
+#include "hr_upload_batch.h"
+#include <hedgelib/hl_text.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hl
+{
+class archive_entry;
+} // hl
+
+namespace hr
+{
+namespace gfx
+{
+class render_device;
+
+/**
+    @brief Called on a streaming thread for every archive entry with the extension
+    this function was registered for. It should parse the entry's data, create any
+    resources it needs, and upload their data with the given upload batch.
+
+    Those resources are ready to use once resource_streamer::is_ready returns
+    true for the request they were streamed by. The batch is submitted by the
+    streamer (so its ID isn't known yet), so don't call batch.submit() here.
+*/
+using stream_load_func = std::function<void(
+    hl::archive_entry& entry, upload_batch& batch)>;
+
+using stream_request_id = std::uint64_t;
+
+enum class stream_state
+{
+    /** @brief The request is waiting for a streaming thread to pick it up. */
+    queued,
+    /** @brief The archive is being loaded, and its entries are being parsed and uploaded. */
+    loading,
+    /** @brief Every entry has been parsed, but some of their data is still uploading. */
+    uploading,
+    /** @brief Every entry has been parsed and uploaded. */
+    ready,
+    /** @brief The archive could not be streamed (or the request ID is invalid). */
+    failed
+};
+
+/**
+    @brief Streams resources from HedgeLib archives on background threads, so
+    they can be rendered progressively as they become ready rather than
+    stalling the calling thread until everything is loaded.
+
+    Each streaming thread owns one of the render device's thread indices,
+    which must not be used by any other thread while the streamer exists.
+*/
+class resource_streamer : public non_copyable, public non_moveable
+{
+    struct in_request
+    {
+        hl::nstring filePath;
+        stream_request_id id;
+    };
+
+    struct in_request_status
+    {
+        stream_state state = stream_state::queued;
+        /** @brief The ID of the last upload batch this request submitted. */
+        std::uint64_t lastBatchID = 0;
+    };
+
+    render_device* m_device;
+    std::vector<std::pair<hl::nstring, stream_load_func>> m_loaders;
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workCondition;
+    mutable std::condition_variable m_doneCondition;
+    std::deque<in_request> m_queue;
+    std::vector<in_request_status> m_statuses;
+    std::size_t m_maxBatchSize;
+    bool m_isStopping = false;
+
+    const stream_load_func* in_get_loader(const hl::nchar* fileName) const noexcept;
+
+    void in_set_status(stream_request_id id,
+        stream_state state, std::uint64_t lastBatchID = 0);
+
+    void in_stream_entries(hl::archive_entry* entries, std::size_t entryCount,
+        unsigned int threadIndex, upload_batch& batch, std::size_t& batchSize,
+        stream_request_id id);
+
+    void in_stream(const in_request& request, unsigned int threadIndex);
+
+    void in_worker_main(unsigned int threadIndex) noexcept;
+
+    void in_stop() noexcept;
+
+public:
+    inline render_device& device() const noexcept
+    {
+        return *m_device;
+    }
+
+    /**
+        @brief Registers the function used to load archive entries with the given
+        extension (e.g. ".model"). Must be done before streaming any archives.
+    */
+    HR_GFX_API void set_loader(const hl::nchar* ext, stream_load_func func);
+
+    inline void set_loader(const hl::nstring& ext, stream_load_func func)
+    {
+        set_loader(ext.c_str(), std::move(func));
+    }
+
+    /**
+        @brief Queues the given archive (e.g. a .pac or .ar) to be streamed in on
+        a background thread, and returns an ID which can be used to query its state.
+    */
+    HR_GFX_API stream_request_id stream(const hl::nchar* filePath);
+
+    inline stream_request_id stream(const hl::nstring& filePath)
+    {
+        return stream(filePath.c_str());
+    }
+
+    HR_GFX_API stream_state state(stream_request_id id) const;
+
+    inline bool is_ready(stream_request_id id) const
+    {
+        return (state(id) == stream_state::ready);
+    }
+
+    /**
+        @brief Blocks until the given request is either ready or has failed.
+        @return Whether the request is ready (as opposed to having failed).
+    */
+    HR_GFX_API bool wait(stream_request_id id) const;
+
+    /**
+        @param device The render device to upload resources with.
+        @param firstThreadIndex The first render device thread index to use;
+        each streaming thread uses the next one.
+        @param threadCount How many streaming threads to use.
+        @param maxBatchSize How many bytes of archive entries to parse before submitting
+        an upload batch, so resources become ready gradually rather than all at once.
+    */
+    HR_GFX_API resource_streamer(render_device& device, unsigned int firstThreadIndex,
+        unsigned int threadCount = 1, std::size_t maxBatchSize = (32 * 1024 * 1024));
+
+    HR_GFX_API ~resource_streamer();
+};
+} // gfx
+} // hr
+#endif
@@ -212,6 +212,14 @@ public:
     const image_write_desc* imageWrites = nullptr;
     const buffer_write_desc* bufferWrites = nullptr;
 };
+
+class cached_shader_data_desc
+{
+public:
+    const shader_parameter_group* paramGroup;
+    const shader_data_write_desc* shaderDataWrites;
+    std::size_t shaderDataWriteCount;
+};
 } // gfx
 } // hr
 #endif
@@ -8,39 +8,84 @@ namespace gfx
 {
 namespace internal
 {
+struct in_per_thread_data;
 struct in_per_upload_batch_data;
 } // internal
 
+/**
+    @brief Uploads data into buffers and images via staging memory suballocated
+    from large, persistent, per-thread staging pages. Copies are queued up and
+    recorded all at once on submit(), so every resource given to add() must
+    remain valid (and must not be moved) until then.
+*/
 class upload_batch : public non_copyable
 {
     friend render_device;
 
     render_device* m_device = nullptr;
+    internal::in_per_thread_data* m_threadData = nullptr;
     internal::in_per_upload_batch_data* m_batchData = nullptr;
     cmd_list m_cmdList;
-    std::uint64_t m_batchID;
+    std::uint64_t m_batchID = 0;
+    bool m_needsSubmit = false;
 
     HR_GFX_API upload_batch(render_device& device,
+        internal::in_per_thread_data& threadData,
         internal::in_per_upload_batch_data& batchData,
         VkCommandBuffer vkCmdBuf) noexcept;
 
     HR_GFX_API void in_ensure_batch_was_submitted() const;
 
+    HR_GFX_API const buffer& in_copy_to_staging(const void* src,
+        std::size_t size, std::size_t& stagingOffset);
+
+    HR_GFX_API void in_record_copies();
+
 public:
     inline render_device& device() const noexcept
     {
         return *m_device;
     }
 
+    /**
+        @brief Returns the ID to give render_device::is_upload_batch_done and
+        render_device::wait_for_upload_batch to check whether this batch has
+        finished uploading. IDs are assigned when batches are submitted, in
+        the order they're submitted in, so this returns 0 until submit().
+    */
     inline std::uint64_t id() const noexcept
     {
         return m_batchID;
     }
 
+    inline bool is_submitted() const noexcept
+    {
+        return !m_needsSubmit;
+    }
+
     HR_GFX_API void add(const void* src, buffer& dst);
 
+    /**
+        @brief Uploads the given data into part of the given buffer.
+
+        NOTE: Copies are recorded in the order they were added, so if the same
+        part of the same buffer is uploaded to more than once within a single
+        upload batch, the data from the last call wins.
+
+        @param src The data to upload.
+        @param size The size of the data to upload, in bytes.
+        @param dst The buffer to upload the data into.
+        @param dstOffset The offset within the buffer to upload the data to.
+    */
+    HR_GFX_API void add(const void* src, std::size_t size,
+        buffer& dst, std::size_t dstOffset);
+
     HR_GFX_API void add(const void* src, image& dst);
 
+    /**
+        @brief Records all queued copies and submits them to the transfer queue.
+        Safe to call from multiple threads at once (for different batches).
+    */
     HR_GFX_API void submit();
 
     HR_GFX_API upload_batch& operator=(upload_batch&& other) noexcept;
@@ -2,6 +2,7 @@
 #include <hedgelib/archives/hl_hh_archive.h>
 #include <hedgelib/archives/hl_pacx.h>
 #include <hedgelib/io/hl_path.h>
+#include <hedgelib/hl_trace.h>
 #include <exception>
 #include <optional>
 
@@ -19,6 +20,8 @@ enum class text_id
     warning,
     warning_pfi_disabled_type,
     warning_pfi_disabled_splits,
+    warning_dup_disabled_type,
+    warning_trace_unsupported,
 
     error,
     error_internal,
@@ -48,6 +51,9 @@ enum class text_id
 
     extracting,
     packing,
+    dup_shared,
+    dup_not_shared,
+    dup_summary,
     done1,
     done2
 };
@@ -596,7 +602,9 @@ public:
     arc_type type = arc_type::unknown;
     hl::compress_type compressType = hl::compress_type::none;
     endian_flag endianness = endian_flag::little;
+    hl::nchar* traceOutput = nullptr;
     bool generatePFI = false;
+    bool findDuplicates = false;
 
     static bool is_flag(const hl::nchar* arg)
     {
@@ -699,6 +707,18 @@ public:
                     hasGeneratePFI = true;
                 }
 
+                // Find duplicates flag.
+                else if (hl::text::equal(arg, HL_NTEXT("D="), 2))
+                {
+                    findDuplicates = get_yes_no(&arg[2]);
+                }
+
+                // Trace flag.
+                else if (hl::text::equal(arg, HL_NTEXT("-trace="), 7))
+                {
+                    traceOutput = &arg[7];
+                }
+
                 // Invalid flag.
                 else
                 {
@@ -779,6 +799,8 @@ public:
 
 static void pack(const arguments& args)
 {
+    HL_TRACE_ZONE("HedgeArcPack::pack");
+
     // Print message letting user know we're packing the archive(s).
     hl::console::write_line(get_text(text_id::packing));
 
@@ -787,6 +809,9 @@ static void pack(const arguments& args)
 
     // Save archive(s) in the format specified by type.
     hl::packed_file_info pfi;
+    hl::duplicate_file_info dupInfo;
+    bool canFindDuplicates = true;
+
     switch (args.type)
     {
     case arc_type::hh_ar:
@@ -797,7 +822,8 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             args.compressType,                              // compressType
             (args.splitLimit != 0),                         // generateARL
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            (args.findDuplicates) ? &dupInfo : nullptr);    // dupInfo
 
         break;
     }
@@ -806,7 +832,8 @@ static void pack(const arguments& args)
         hl::hh::pfd::save(arc,                              // arc
             args.output,                                    // filePath
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            (args.findDuplicates) ? &dupInfo : nullptr);    // dupInfo
 
         break;
 
@@ -821,7 +848,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            (args.findDuplicates) ? &dupInfo : nullptr);    // dupInfo
 
         break;
 
@@ -833,7 +861,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            (args.findDuplicates) ? &dupInfo : nullptr);    // dupInfo
 
         break;
 
@@ -848,7 +877,8 @@ static void pack(const arguments& args)
             args.output,                                    // filePath
             args.splitLimit,                                // splitLimit
             args.alignment,                                 // dataAlignment
-            (args.generatePFI) ? &pfi : nullptr);           // pfi
+            (args.generatePFI) ? &pfi : nullptr,            // pfi
+            (args.findDuplicates) ? &dupInfo : nullptr);    // dupInfo
 
         break;
 
@@ -867,6 +897,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     case arc_type::tokyo2:
@@ -884,6 +915,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     case arc_type::sakura:
@@ -901,6 +933,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     case arc_type::ppt2:
@@ -918,6 +951,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     case arc_type::origins:
@@ -935,6 +969,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     case arc_type::frontiers:
@@ -952,6 +987,7 @@ static void pack(const arguments& args)
             args.alignment,                                 // dataAlignment
             false);                                         // noCompress
 
+        canFindDuplicates = false;
         break;
 
     default:
@@ -984,6 +1020,36 @@ static void pack(const arguments& args)
             hl::hh::pfi::save(pfi, 0, pfiPath);
         }
     }
+
+    // Print duplicate files if requested and possible for the given type.
+    if (args.findDuplicates)
+    {
+        if (!canFindDuplicates)
+        {
+            print_warning(get_text(text_id::warning_dup_disabled_type));
+        }
+        else
+        {
+            std::size_t sharedSize = 0;
+            for (const auto& dup : dupInfo)
+            {
+                const hl::nstring name = hl::text::conv<
+                    hl::text::utf8_to_native>(dup.name);
+
+                const hl::nstring originalName = hl::text::conv<
+                    hl::text::utf8_to_native>(dup.originalName);
+
+                hl::nfprintf(stdout, get_text((dup.isShared) ?
+                    text_id::dup_shared : text_id::dup_not_shared),
+                    name.c_str(), originalName.c_str(), dup.dataSize);
+
+                if (dup.isShared) sharedSize += dup.dataSize;
+            }
+
+            hl::nfprintf(stdout, get_text(text_id::dup_summary),
+                dupInfo.size(), sharedSize);
+        }
+    }
 }
 
 static hl::archive load_arc(const arguments& args)
@@ -1020,6 +1086,8 @@ static hl::archive load_arc(const arguments& args)
 
 static void extract(const arguments& args)
 {
+    HL_TRACE_ZONE("HedgeArcPack::extract");
+
     // Print message letting user know we're extracting the archive.
     hl::console::write_line(get_text(text_id::extracting));
 
@@ -1047,6 +1115,17 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
         // Otherwise, extract or pack as instructed.
         else if (args.input)
         {
+            // Start tracing if requested.
+            if (args.traceOutput)
+            {
+                if (!hl::trace::is_supported)
+                {
+                    print_warning(get_text(text_id::warning_trace_unsupported));
+                }
+
+                hl::trace::start();
+            }
+
             // Extract or pack based on mode.
             if (args.mode == prog_mode::pack)
             {
@@ -1056,6 +1135,13 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
             {
                 extract(args);
             }
+
+            // Save trace if requested.
+            if (args.traceOutput)
+            {
+                hl::trace::stop();
+                hl::trace::save(args.traceOutput);
+            }
         }
 
         // Print usage information if no valid paths were given.
@@ -42,7 +42,16 @@
     HL_NTEXT(" -I=yes/no\tSpecifies whether a .pfi should be generated alongside the archive(s) if\n")
     HL_NTEXT("\t\tpossible for the given type. Ignored when extracting or when not possible\n")
     HL_NTEXT("\t\tfor the given type. If not specified, a default will be used based on\n")
-    HL_NTEXT("\t\tthe archive type (e.g. pfd defaults to yes, and ar defaults to no).\n\n"),
+    HL_NTEXT("\t\tthe archive type (e.g. pfd defaults to yes, and ar defaults to no).\n\n")
+
+    HL_NTEXT(" -D=yes/no\tSpecifies whether files with identical data should be found and listed\n")
+    HL_NTEXT("\t\twhen packing. Where the given type allows it, such files will also share a\n")
+    HL_NTEXT("\t\tsingle copy of their data within the archive. Ignored when extracting.\n")
+    HL_NTEXT("\t\tDefaults to no.\n\n")
+
+    HL_NTEXT(" --trace=file\tWrites a Chrome trace (JSON) of where time was spent while packing or\n")
+    HL_NTEXT("\t\textracting to the given file, which can be viewed in chrome://tracing or\n")
+    HL_NTEXT("\t\tPerfetto. Requires HedgeLib to be built with HEDGELIB_ENABLE_TRACING.\n\n"),
 
     /* win32_drag_drop_tip */
     HL_NTEXT("\n(Or just drag and drop a file or folder onto HedgeArcPack.exe)"),
@@ -57,6 +66,12 @@
     HL_NTEXT("A .pfi will not be generated as it is not possible for archives with splits. ")
     HL_NTEXT("You can generate the .pfi by disabling split generation with -S=0."),
 
+    /* warning_dup_disabled_type */
+    HL_NTEXT("Files with identical data cannot be found for the given archive type."),
+
+    /* warning_trace_unsupported */
+    HL_NTEXT("HedgeLib was built without tracing support (HEDGELIB_ENABLE_TRACING), so the trace will be empty."),
+
     /* error */
     HL_NTEXT("ERROR: %s\n"),
 
@@ -133,6 +148,15 @@
     /* packing */
     HL_NTEXT("Packing..."),
 
+    /* dup_shared */
+    HL_NTEXT("\"%s\" is identical to \"%s\" (%zu bytes shared).\n"),
+
+    /* dup_not_shared */
+    HL_NTEXT("\"%s\" is identical to \"%s\" (%zu bytes, stored again as the type requires it).\n"),
+
+    /* dup_summary */
+    HL_NTEXT("Found %zu file(s) with duplicate data; %zu bytes were saved.\n"),
+
     /* done1 */
     HL_NTEXT("Done! Completed in "),
 
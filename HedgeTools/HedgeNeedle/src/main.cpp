@@ -3,10 +3,13 @@
 #include <hedgelib/io/hl_path.h>
 #include <hedgelib/io/hl_file.h>
 #include <hedgelib/hl_tool_helpers.h>
+#include <hedgelib/hl_trace.h>
 #include <cstring>
 
 static void extract(const hl::nchar* input, const hl::nchar* output, bool isTerrain)
 {
+    HL_TRACE_ZONE("HedgeNeedle::extract");
+
     // Auto-determine output from input if necessary.
     hl::nstring outputBuf;
     if (!output)
@@ -30,18 +33,16 @@ static void extract(const hl::nchar* input, const hl::nchar* output, bool isTerr
     resOutputPath += hl::path::remove_exts(hl::path::get_name(input));
     resOutputPath += HL_NTEXT('.');
 
-    // Endian-swap archive header.
+    // Unpack archive.
     const auto resOutputExtStartPos = resOutputPath.size();
     const auto rawArc = rawData.data<hl::hh::needle::raw_archive>();
     std::size_t mdlCount = 0;
 
-    rawArc->endian_swap();
+    hl::hh::needle::unpack(*rawArc);
     
     // Extract each file within the Needle archive.
     for (auto& rawArcEntry : *rawArc)
     {
-        hl::endian_swap(rawArcEntry.size());
-
         // NEDMDLV5 files.
         if (std::memcmp(rawArcEntry.signature, &hl::hh::needle::signature_model_v5, 8) == 0)
         {
@@ -53,50 +54,6 @@ static void extract(const hl::nchar* input, const hl::nchar* output, bool isTerr
             resOutputPath += (isTerrain) ?
                 hl::hh::mirage::terrain_model::extension :
                 hl::hh::mirage::skeletal_model::extension;
-
-            // "Unfix" relative offsets.
-            // TODO: Make a function for this within HedgeLib instead of this mess.
-            void* base;
-            hl::u32 offTableOff, offTableCount;
-
-            if (hl::hh::mirage::has_sample_chunk_header_unfixed(rawArcEntry.data()))
-            {
-                const auto rawHeader = rawArcEntry.data<hl::hh::mirage::sample_chunk::raw_header>();
-                base = (rawHeader + 1);
-                offTableOff = rawHeader->offTable.get_raw();
-                hl::endian_swap(offTableOff);
-                offTableCount = rawHeader->offCount;
-                hl::endian_swap(offTableCount);
-            }
-            else
-            {
-                const auto rawHeader = rawArcEntry.data<hl::hh::mirage::standard::raw_header>();
-                auto baseOff = rawHeader->data.get_raw();
-
-                hl::endian_swap(baseOff);
-                base = hl::ptradd(rawHeader, baseOff);
-                offTableOff = rawHeader->offTable.get_raw();
-                hl::endian_swap(offTableOff);
-                offTableCount = *hl::ptradd<hl::u32>(rawHeader, offTableOff);
-                offTableOff += 4;
-                hl::endian_swap(offTableCount);
-            }
-
-            hl::hh::mirage::off_table_handle offTable(
-                (hl::u32*)(rawArcEntry.data<hl::u8>() + offTableOff),
-                offTableCount);
-
-            for (auto off : offTable)
-            {
-                hl::endian_swap(off);
-                auto offPtr = hl::ptradd<hl::off32<void>>(base, off);
-                
-                *offPtr = hl::off32<void>((hl::u32)(
-                    ((std::uintptr_t)offPtr->get()) - ((std::uintptr_t)base)
-                ));
-
-                offPtr->endian_swap<true>();
-            }
         }
         
         // Other file types.
@@ -155,6 +112,8 @@ struct needle_arc_entry
 
 static void pack(const hl::nchar* input, const hl::nchar* output)
 {
+    HL_TRACE_ZONE("HedgeNeedle::pack");
+
     // Get files in input directory.
     hl::nstring filePath(input);
     if (hl::path::combine_needs_sep1(input))
@@ -207,113 +166,77 @@ static void pack(const hl::nchar* input, const hl::nchar* output)
         output = outputBuf.c_str();
     }
 
-    // Create Needle Archive file.
-    hl::file_stream arc(output, hl::file::mode::write);
-    const auto fileStartPos = arc.tell();
+    // Setup Needle Archive entries.
+    std::vector<hl::hh::needle::archive_entry> arcEntries;
+    arcEntries.reserve(files.size());
 
-    // Write Needle Archive header.
-    arc.write_all(8, &hl::hh::needle::signature_archive_v1);
-    arc.write_nulls(4);
-    arc.write_str("arc");
-    arc.pad(4);
-
-    // Write Needle Archive entries.
     for (auto& file : files)
     {
         switch (file.dataType)
         {
         case needle_arc_data_type::lodinfo:
-            arc.write_all(8, &hl::hh::needle::signature_lodinfo_v1);
-            arc.write_str("lodinfo");
-            arc.pad(4);
+            arcEntries.emplace_back(hl::hh::needle::archive_entry_type::lodinfo,
+                file.data.data(), file.data.size());
             break;
 
         case needle_arc_data_type::model:
         case needle_arc_data_type::terrain_model:
-        {
-            arc.write_all(8, &hl::hh::needle::signature_model_v5);
-
-            // "Fix" offsets.
-            // TODO: Modify the fix function within HedgeLib to
-            // not swap the offsets in-place and use that instead
-            // of this mess.
-            void* base;
-            hl::u32 offTableOff, offTableCount;
-
-            if (hl::hh::mirage::has_sample_chunk_header_unfixed(file.data))
-            {
-                const auto rawHeader = file.data.data<hl::hh::mirage::sample_chunk::raw_header>();
-                base = (rawHeader + 1);
-                offTableOff = rawHeader->offTable.get_raw();
-                hl::endian_swap(offTableOff);
-                offTableCount = rawHeader->offCount;
-                hl::endian_swap(offTableCount);
-            }
-            else
-            {
-                const auto rawHeader = file.data.data<hl::hh::mirage::standard::raw_header>();
-                auto baseOff = rawHeader->data.get_raw();
-
-                hl::endian_swap(baseOff);
-                base = hl::ptradd(rawHeader, baseOff);
-                offTableOff = rawHeader->offTable.get_raw();
-                hl::endian_swap(offTableOff);
-                offTableCount = *hl::ptradd<hl::u32>(rawHeader, offTableOff);
-                offTableOff += 4;
-                hl::endian_swap(offTableCount);
-            }
-
-            hl::hh::mirage::off_table_handle offTable(
-                (hl::u32*)(file.data.data<hl::u8>() + offTableOff),
-                offTableCount);
-
-            for (auto off : offTable)
-            {
-                hl::endian_swap(off);
-                auto offPtr = hl::ptradd<hl::off32<void>>(base, off);
-                
-#ifndef HL_IS_BIG_ENDIAN
-                hl::endian_swap(*offPtr);
-#endif
-
-                offPtr->fix(base);
-            }
-
-            // Write "extension".
-            arc.write_str("model");
-            arc.pad(4);
+            arcEntries.emplace_back(hl::hh::needle::archive_entry_type::model,
+                file.data.data(), file.data.size());
             break;
-        }
 
         default:
             hl::nfputs(HL_NTEXT("WARNING: Skipped file with "
                 "unknown or unsupported extension"), stderr);
             continue;
         }
-
-        // Write file size and data.
-        auto fileSize = static_cast<hl::u32>(file.data.size());
-        hl::endian_swap(fileSize);
-        arc.write_obj(fileSize);
-
-        arc.write_all(file.data.size(), file.data.data());
     }
 
-    // Fill-in archive file size.
-    const auto arcEndPos = arc.tell();
-    auto arcSize = static_cast<hl::u32>(arcEndPos - (fileStartPos + 8));
-    hl::endian_swap(arcSize);
-    arc.jump_to(fileStartPos + 8);
-    arc.write_obj(arcSize);
-    arc.jump_to(arcEndPos);
+    // Pack and save Needle Archive.
+    hl::file::save(hl::hh::needle::pack(arcEntries), output);
 }
 
 int HL_NMAIN(int argc, hl::nchar* argv[])
 {
-    if (argc == 3 || argc == 2)
+    // Parse arguments.
+    const hl::nchar* input = nullptr;
+    const hl::nchar* output = nullptr;
+    const hl::nchar* traceOutput = nullptr;
+    bool tooManyPaths = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (hl::text::equal(argv[i], HL_NTEXT("--trace="), 8))
+        {
+            traceOutput = (argv[i] + 8);
+        }
+        else if (!input)
+        {
+            input = argv[i];
+        }
+        else if (!output)
+        {
+            output = argv[i];
+        }
+        else
+        {
+            tooManyPaths = true;
+        }
+    }
+
+    if (input && !tooManyPaths)
     {
-        const hl::nchar* input = argv[1];
-        const hl::nchar* output = (argc == 3) ? argv[2] : nullptr;
+        // Start tracing if requested.
+        if (traceOutput)
+        {
+            if (!hl::trace::is_supported)
+            {
+                hl::nfputs(HL_NTEXT("WARNING: Tracing is not supported "
+                    "by this build of HedgeLib\n"), stderr);
+            }
+
+            hl::trace::start();
+        }
 
 #ifdef NDEBUG
         try
@@ -332,6 +255,13 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
             hl::nputs(HL_NTEXT("Extracting..."));
             extract(input, output, isTerrain);
         }
+
+        // Save trace if requested.
+        if (traceOutput)
+        {
+            hl::trace::stop();
+            hl::trace::save(traceOutput);
+        }
 #ifdef NDEBUG
         }
         catch (const std::exception& ex)
@@ -350,7 +280,7 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
     }
     else
     {
-        hl::nputs(HL_NTEXT("HedgeNeedle input [output]"));
+        hl::nputs(HL_NTEXT("HedgeNeedle input [output] [--trace=file]"));
     }
 
     return EXIT_SUCCESS;
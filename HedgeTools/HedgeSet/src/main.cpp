@@ -3,6 +3,7 @@
 #include <hedgelib/io/hl_path.h>
 #include <hedgelib/io/hl_file.h>
 #include <hedgelib/hl_tool_helpers.h>
+#include <hedgelib/hl_trace.h>
 
 static hl::language current_language = hl::get_default_language();
 
@@ -110,6 +111,12 @@ static void print_usage(const hl::nchar* templateDir, std::FILE* s)
     hl::nfputs(HL_NTEXT(" -platform=VALUE Specifies which platform to use for conversion.\n"), s);
     hl::nfputs(HL_NTEXT("                 Valid options are:\n\n"), s);
     print_valid_platform_types(HL_NTEXT("                 %s"), s);
+    hl::nfputs(HL_NTEXT("\n"), s);
+
+    hl::nfputs(HL_NTEXT(" --trace=FILE    Writes a Chrome trace (JSON) of where time was spent\n"), s);
+    hl::nfputs(HL_NTEXT("                 during conversion to the given file, which can be viewed\n"), s);
+    hl::nfputs(HL_NTEXT("                 in chrome://tracing or Perfetto. Requires HedgeLib to be\n"), s);
+    hl::nfputs(HL_NTEXT("                 built with HEDGELIB_ENABLE_TRACING.\n"), s);
 }
 
 static hl::nstring prompt_for_game_type(const hl::nchar* templateDir)
@@ -144,6 +151,8 @@ static platform_type prompt_for_platform_type()
 static void convert_gedit_v3_to_hson(const hl::set_object_type_database& objTypeDB,
     const hl::nchar* input, const hl::nchar* output, platform_type platform)
 {
+    HL_TRACE_ZONE("HedgeSet::convert_gedit_v3_to_hson");
+
     // Load .gedit file.
     hl::nprintf(HL_NTEXT("Loading set data from \"%s\"...\n"), input);
     hl::blob blob(input);
@@ -181,6 +190,8 @@ static void convert_game_to_hson(const hl::set_object_type_database& objTypeDB,
 static void convert_hson_to_gedit_v3(const hl::set_object_type_database& objTypeDB,
     const hl::nchar* input, const hl::nchar* output, platform_type platform)
 {
+    HL_TRACE_ZONE("HedgeSet::convert_hson_to_gedit_v3");
+
     // Load HSON data.
     hl::nprintf(HL_NTEXT("Loading HSON data from \"%s\"...\n"), input);
     hl::hson::project hsonProject(input);
@@ -254,6 +265,7 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
         const auto input = argv[1];
         const hl::nchar* output = nullptr;
         const hl::nchar* game = nullptr;
+        const hl::nchar* traceOutput = nullptr;
         platform_type platform = platform_type::unknown;
         hl::nstring outputBuf, gameBuf;
         bool hasSpecifiedPlatform = false;
@@ -274,6 +286,11 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
                     hasSpecifiedPlatform = true;
                     continue;
                 }
+                else if (hl::text::equal(argv[i], HL_NTEXT("--trace="), 8))
+                {
+                    traceOutput = (argv[i] + 8);
+                    continue;
+                }
             }
 
             // Parse output.
@@ -313,6 +330,18 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
             return EXIT_FAILURE;
         }
 
+        // Start tracing if requested.
+        if (traceOutput)
+        {
+            if (!hl::trace::is_supported)
+            {
+                hl::nfputs(HL_NTEXT("WARNING: --trace requires HedgeLib to be built "
+                    "with HEDGELIB_ENABLE_TRACING.\n"), stderr);
+            }
+
+            hl::trace::start();
+        }
+
         // Load templates for the given game.
         hl::nprintf(HL_NTEXT("Loading templates for %s...\n"), game);
         const hl::set_object_type_database objTypeDB(
@@ -354,6 +383,13 @@ int HL_NMAIN(int argc, hl::nchar* argv[])
             convert_game_to_hson(objTypeDB, input, output, platform);
         }
 
+        // Save trace if requested.
+        if (traceOutput)
+        {
+            hl::trace::stop();
+            hl::trace::save(traceOutput);
+        }
+
         hl::nputs(HL_NTEXT("Done"));
         return EXIT_SUCCESS;
     }